@@ -30,6 +30,7 @@
 // parallel
 #include <parallel/parallel.h>
 #include <parallel/thread.h>
+#include <parallel/thread_pool.h>
 
 // Forward declarations
 struct schedule_s;
@@ -71,7 +72,7 @@ int schedule_load_as_json_value ( schedule **const pp_schedule, const json_value
 
 // Start
 /** !
- * Start running a schedule
+ * Start running a schedule. Fails if the schedule is already running
  *
  * @param p_schedule  the schedule
  * @param p_parameter this parameter is passed to each task
@@ -81,6 +82,37 @@ int schedule_load_as_json_value ( schedule **const pp_schedule, const json_value
  */
 DLLEXPORT int schedule_start ( schedule *const p_schedule, void *const p_parameter );
 
+/** !
+ * Start running a schedule on a thread pool, instead of a thread per named 
+ * thread. Each task waits on the task before it in its thread, and on its 
+ * wait task. A task is submitted to the pool as soon as the tasks it waits on 
+ * are done, so many named threads can share a few cores. The main thread 
+ * property is ignored. Returns without blocking; use schedule_wait_idle.
+ * Fails if the schedule is already running
+ *
+ * @param p_schedule    the schedule
+ * @param p_thread_pool the thread pool
+ * @param p_parameter   this parameter is passed to each task
+ * @sa schedule_start
+ *
+ * @return 1 on success, 0 on error
+ */
+DLLEXPORT int schedule_start_on_thread_pool ( schedule *const p_schedule, thread_pool *const p_thread_pool, void *const p_parameter );
+
+// Accessors
+/** !
+ * Report where a thread of a running schedule is placed. The main thread runs 
+ * on the caller's thread, and is never placed
+ * 
+ * @param p_schedule  the schedule
+ * @param thread_name the name of the thread
+ * @param p_cpu       return, the CPU the thread is pinned to, or -1. May be null
+ * @param p_node      return, the NUMA node of the CPU, or -1. May be null
+ * 
+ * @return 1 on success, 0 on error
+ */
+DLLEXPORT int schedule_get_placement ( schedule *const p_schedule, const char *const thread_name, int *const p_cpu, int *const p_node );
+
 // Wait idle
 /** !
  * Block until a schedule is done
@@ -92,7 +124,7 @@ DLLEXPORT int schedule_start ( schedule *const p_schedule, void *const p_paramet
 DLLEXPORT int schedule_wait_idle ( schedule *const p_schedule );
 
 /** !
- * Clear a schedule's repeat flag
+ * Clear a schedule's repeat flag. Iterations already in flight run to completion
  * 
  * @param p_schedule the schedule
  * 
@@ -114,7 +146,7 @@ DLLEXPORT int schedule_stop ( schedule *const p_schedule );
 
 // Destructors
 /** !
- * Destroy a schedule
+ * Destroy a schedule. The schedule must be stopped, or idle, before it is destroyed
  * 
  * @param pp_schedule the schedule
  * 
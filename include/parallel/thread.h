@@ -21,10 +21,23 @@
 // parallel
 #include <parallel/parallel.h>
 
+// Enumeration definitions
+enum parallel_thread_placement_e
+{
+    PARALLEL_THREAD_PLACEMENT_NONE     = 0, // The kernel places threads
+    PARALLEL_THREAD_PLACEMENT_PIN      = 1, // Pin thread i to the i'th CPU, in the order the kernel numbers them
+    PARALLEL_THREAD_PLACEMENT_SPREAD   = 2, // One thread per core, alternating NUMA nodes, before any core gets a second thread
+    PARALLEL_THREAD_PLACEMENT_PACK     = 3, // Fill every core of a NUMA node before moving to the next node
+    PARALLEL_THREAD_PLACEMENT_QUANTITY = 4
+};
+
 // structure definitions
 struct parallel_thread_s
 {
 
+    // The CPU the thread is pinned to, or -1
+    int cpu;
+
     // Platform dependent struct members
     #ifdef _WIN64
         // TODO
@@ -60,6 +73,62 @@ DLLEXPORT int parallel_thread_create ( parallel_thread **pp_parallel_thread );
  */
 DLLEXPORT int parallel_thread_start ( parallel_thread **pp_parallel_thread, fn_parallel_task *pfn_task, void *p_parameter );
 
+/** !
+ * Start a new parallel thread that is pinned to a CPU from its first instruction
+ * 
+ * @param pp_parallel_thread return
+ * @param pfn_task           pointer to start function
+ * @param p_parameter        parameter for start function
+ * @param cpu                the CPU, or -1 to let the kernel place the thread
+ * 
+ * @sa parallel_thread_placement_cpu
+ * 
+ * @return 1 on success, 0 on error
+ */
+DLLEXPORT int parallel_thread_start_with_affinity ( parallel_thread **pp_parallel_thread, fn_parallel_task *pfn_task, void *p_parameter, int cpu );
+
+// Affinity
+/** !
+ * Pin a running thread to a CPU
+ * 
+ * @param p_parallel_thread the thread
+ * @param cpu               the CPU, or -1 to allow every CPU
+ * 
+ * @return 1 on success, 0 on error
+ */
+DLLEXPORT int parallel_thread_set_affinity ( parallel_thread *p_parallel_thread, int cpu );
+
+/** !
+ * Report where a thread is placed
+ * 
+ * @param p_parallel_thread the thread
+ * @param p_cpu             return, the CPU the thread is pinned to, or -1. May be null
+ * @param p_node            return, the NUMA node of the CPU, or -1. May be null
+ * 
+ * @return 1 on success, 0 on error
+ */
+DLLEXPORT int parallel_thread_get_affinity ( parallel_thread *p_parallel_thread, int *p_cpu, int *p_node );
+
+/** !
+ * Choose a CPU for the i'th thread of a group. The topology is read from sysfs
+ * once, and only CPUs this process may run on are chosen. 
+ * 
+ * @param placement the placement policy
+ * @param index     the index of the thread in its group
+ * 
+ * @return the CPU, or -1 if the policy is PARALLEL_THREAD_PLACEMENT_NONE or the topology is unknown
+ */
+DLLEXPORT int parallel_thread_placement_cpu ( enum parallel_thread_placement_e placement, size_t index );
+
+/** !
+ * Get the NUMA node of a CPU
+ * 
+ * @param cpu the CPU
+ * 
+ * @return the NUMA node, or -1 if the CPU is unknown
+ */
+DLLEXPORT int parallel_thread_cpu_node ( int cpu );
+
 // Cancel
 /** !
  * Stop a thread
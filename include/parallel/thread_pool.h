@@ -14,6 +14,7 @@
 #include <string.h>
 #include <stdlib.h>
 #include <stdbool.h>
+#include <stdint.h>
 
 // sync submodule
 #include <sync/sync.h>
@@ -22,11 +23,98 @@
 #include <parallel/parallel.h>
 #include <parallel/thread.h>
 
+// Preprocessor definitions
+#define THREAD_POOL_SPIN_NONE         ((size_t) -1)
+#define THREAD_POOL_INLINE_PARAMETER_SIZE 64
+#define THREAD_POOL_LATENCY_BUCKETS       24
+
+// Enumeration definitions
+enum thread_pool_mode_e
+{
+    THREAD_POOL_MODE_SHARED_QUEUE  = 0,
+    THREAD_POOL_MODE_WORK_STEALING = 1,
+    THREAD_POOL_MODE_QUANTITY      = 2
+};
+
+enum thread_pool_wait_e
+{
+    THREAD_POOL_WAIT_PARK      = 0,
+    THREAD_POOL_WAIT_BUSY_POLL = 1,
+    THREAD_POOL_WAIT_QUANTITY  = 2
+};
+
+enum thread_pool_priority_e
+{
+    THREAD_POOL_PRIORITY_CRITICAL   = 0,
+    THREAD_POOL_PRIORITY_NORMAL     = 1,
+    THREAD_POOL_PRIORITY_BACKGROUND = 2,
+    THREAD_POOL_PRIORITY_QUANTITY   = 3
+};
+
+enum thread_pool_overflow_e
+{
+    THREAD_POOL_OVERFLOW_BLOCK       = 0,
+    THREAD_POOL_OVERFLOW_REJECT      = 1,
+    THREAD_POOL_OVERFLOW_CALLER_RUNS = 2,
+    THREAD_POOL_OVERFLOW_QUANTITY    = 3
+};
+
 // Forward declarations
 struct thread_pool_s;
+struct thread_pool_attributes_s;
+struct thread_pool_future_s;
+struct thread_pool_group_s;
+struct thread_pool_timer_s;
+struct thread_pool_statistics_s;
 
 // Type definitions
-typedef struct thread_pool_s thread_pool;
+typedef struct thread_pool_s            thread_pool;
+typedef struct thread_pool_attributes_s thread_pool_attributes;
+typedef struct thread_pool_future_s     thread_pool_future;
+typedef struct thread_pool_group_s      thread_pool_group;
+typedef struct thread_pool_timer_s      thread_pool_timer;
+typedef struct thread_pool_statistics_s thread_pool_statistics;
+typedef void (fn_parallel_for)( size_t begin, size_t end, void *p_context );
+typedef void (fn_parallel_reduce)( size_t begin, size_t end, void *p_partial, void *p_context );
+typedef void (fn_parallel_combine)( void *p_partial, const void *p_other, void *p_context );
+typedef void (fn_parallel_destructor)( void *p_parameter );
+
+// Structure definitions
+struct thread_pool_attributes_s
+{
+    int                     thread_quantity;     // the minimum quantity of threads
+    int                     max_thread_quantity; // 0 for a fixed size pool
+    size_t                  idle_milliseconds;   // 0 for the default
+    enum thread_pool_mode_e mode;
+    size_t                  future_quantity;     // 0 for the default
+    size_t                  spin_iterations;     // 0 for the default, THREAD_POOL_SPIN_NONE to park right away
+    enum thread_pool_wait_e wait;                // how idle workers wait for jobs
+    size_t                  descriptor_quantity; // 0 for the default
+
+    enum parallel_thread_placement_e placement;  // where each thread runs
+    const int              *p_cpus;              // optional, thread i runs on p_cpus[i % cpu_quantity]
+    size_t                  cpu_quantity;        // the length of p_cpus
+
+    size_t                      queue_length;          // 0 for the default, else a power of two
+    enum thread_pool_overflow_e overflow;              // what a submit does when the queue is full
+    size_t                      overflow_milliseconds; // 0 to block without a timeout
+};
+
+struct thread_pool_statistics_s
+{
+    size_t   thread_quantity;  // the quantity of running threads
+    uint64_t jobs;             // jobs run by workers
+    uint64_t busy_nanoseconds; // time workers spent running jobs
+    uint64_t idle_nanoseconds; // time workers spent between jobs
+    uint64_t steals;           // jobs taken from another worker's deque
+    size_t   queue_depth;      // jobs waiting now
+    size_t   max_queue_depth;  // the most jobs seen waiting
+
+    // Time from submit to start. Bucket 0 counts jobs that started within a 
+    // microsecond. Bucket i counts jobs that started within [ 2^(i-1), 2^i ) 
+    // microseconds. The last bucket counts every job that waited longer
+    uint64_t latency[THREAD_POOL_LATENCY_BUCKETS];
+};
 
 // Function declarations
 
@@ -42,27 +130,431 @@ typedef struct thread_pool_s thread_pool;
 DLLEXPORT int thread_pool_construct ( thread_pool **pp_thread_pool, int thread_quantity );
 
 /** !
- * Execute a job on a thread pool
+ * Construct a thread pool from a set of attributes. 
+ * 
+ * In THREAD_POOL_MODE_SHARED_QUEUE, every job goes through one queue. In 
+ * THREAD_POOL_MODE_WORK_STEALING, each worker also owns a double ended queue.
+ * Jobs submitted from a worker are pushed onto, and popped from, the bottom of 
+ * that worker's queue. Idle workers steal from the top of a random victim's queue.
+ * 
+ * A thread pool starts thread_quantity threads. If max_thread_quantity is more 
+ * than thread_quantity, the thread pool is elastic. It adds a thread when every
+ * thread is busy and jobs are waiting, up to max_thread_quantity threads. A
+ * thread that sleeps for idle_milliseconds retires, down to thread_quantity 
+ * threads. 
+ * 
+ * A worker with nothing to run spins for spin_iterations checks, then parks. 
+ * Submitting a job wakes one parked worker, unless enough workers are still 
+ * spinning to take it. Latency sensitive pools spin longer, and batch pools 
+ * park right away.
+ * 
+ * In THREAD_POOL_WAIT_BUSY_POLL, workers never park. They poll the queues with
+ * pause instructions and exponential backoff, and submitting a job never makes
+ * a system call, even when the queue is full. Each worker burns a core, so 
+ * busy polling pools are meant for isolated cores. Their workers are always 
+ * pinned; PARALLEL_THREAD_PLACEMENT_NONE pins them in CPU order. A busy polling
+ * pool can't be elastic.
+ * 
+ * Each thread runs on the CPU the placement policy chooses for its index. If 
+ * p_cpus is not null, thread i runs on p_cpus[i % cpu_quantity] instead.
+ * 
+ * Each priority's queue holds queue_length jobs. The overflow policy decides 
+ * what a submit does when the queue is full. THREAD_POOL_OVERFLOW_BLOCK waits 
+ * for a free slot, for at most overflow_milliseconds if that is not 0. 
+ * THREAD_POOL_OVERFLOW_REJECT returns right away. THREAD_POOL_OVERFLOW_CALLER_RUNS
+ * runs the job on the submitting thread, which slows the producer down to the
+ * pace of the workers. A job that is rejected or times out is not run, the 
+ * submit returns 0, and errno is EAGAIN or ETIMEDOUT. 
+ * 
+ * The policy applies to jobs submitted with thread_pool_execute and friends. 
+ * Task groups, parallel loops, continuations and timers always block, since 
+ * they have already promised to run their jobs.
+ * 
+ * @param pp_thread_pool result
+ * @param p_attributes   the attributes
+ * 
+ * @return 1 on success, 0 on error
+ */
+DLLEXPORT int thread_pool_construct_with_attributes ( thread_pool **pp_thread_pool, const thread_pool_attributes *p_attributes );
+
+/** !
+ * Execute a job on a thread pool. The job is added to the thread pool's queue,
+ * and the call returns without waiting for a worker. If the queue is full, the
+ * thread pool's overflow policy applies. By default, the caller sleeps until a
+ * worker frees a slot. A job that executes a job on its own thread pool runs 
+ * queued jobs instead, since every worker may be doing the same.
  * 
  * @param p_thread_pool     the thread pool
  * @param pfn_parallel_task pointer to job function
  * @param p_parameter       the parameter of the parallel task
  * 
- * @return 1 on success, 0 on error
+ * @return 1 on success, 0 on error, or if the job was rejected or timed out
  */
 DLLEXPORT int thread_pool_execute ( thread_pool *p_thread_pool, fn_parallel_task *pfn_parallel_task, void *p_parameter );
 
 /** !
- * Test if the thread pool is idle
+ * Execute a job on a thread pool at a priority. Each priority has its own 
+ * queue, and workers drain higher priorities first. thread_pool_execute uses
+ * THREAD_POOL_PRIORITY_NORMAL. 
+ * 
+ * A flood of lower priority jobs never delays a higher priority job by more 
+ * than one job per worker. To keep lower priorities moving, a worker that has 
+ * run a long streak of higher priority jobs takes its next job from the lowest 
+ * priority queue that has one.
+ * 
+ * @param p_thread_pool     the thread pool
+ * @param pfn_parallel_task pointer to job function
+ * @param p_parameter       the parameter of the parallel task
+ * @param priority          the priority of the job
+ * 
+ * @return 1 on success, 0 on error, or if the job was rejected or timed out
+ */
+DLLEXPORT int thread_pool_execute_with_priority ( thread_pool *p_thread_pool, fn_parallel_task *pfn_parallel_task, void *p_parameter, enum thread_pool_priority_e priority );
+
+/** !
+ * Execute one job per parameter on a thread pool. This is cheaper than calling 
+ * thread_pool_execute in a loop, because sleeping workers are woken once for
+ * the whole batch, and no more workers are woken than there are jobs.
+ * 
+ * If a job is rejected or times out, the rest of the batch is not submitted. 
+ * The jobs before it still run.
+ * 
+ * @param p_thread_pool     the thread pool
+ * @param pfn_parallel_task pointer to job function
+ * @param pp_parameters     array of parameters, one per job
+ * @param quantity          the quantity of jobs
+ * 
+ * @return 1 on success, 0 on error, or if a job was rejected or timed out
+ */
+DLLEXPORT int thread_pool_execute_batch ( thread_pool *p_thread_pool, fn_parallel_task *pfn_parallel_task, void *const *pp_parameters, size_t quantity );
+
+/** !
+ * Execute a job on a thread pool with a copy of its parameter. Up to 
+ * THREAD_POOL_INLINE_PARAMETER_SIZE bytes are copied into a job descriptor, and
+ * the task gets a pointer to the copy, so the caller doesn't have to allocate
+ * a parameter for each job. If size is 0, the task gets p_parameter itself.
+ * 
+ * After the task returns, the destructor, if there is one, gets the same 
+ * pointer as the task. Use it to release whatever the parameter owns. 
+ * 
+ * Descriptors come from a fixed set that is allocated with the thread pool, so 
+ * this call does not allocate memory. If every descriptor is in use, the caller
+ * runs queued jobs, and sleeps when there are none, until one is free.
+ * 
+ * @param p_thread_pool     the thread pool
+ * @param pfn_parallel_task pointer to job function
+ * @param p_parameter       the parameter to copy
+ * @param size              the size of the parameter, in bytes
+ * @param pfn_destructor    called with the parameter after the task, or null pointer
+ * 
+ * @return 1 on success, 0 on error
+ */
+DLLEXPORT int thread_pool_execute_inline ( thread_pool *p_thread_pool, fn_parallel_task *pfn_parallel_task, const void *p_parameter, size_t size, fn_parallel_destructor *pfn_destructor );
+
+/** !
+ * Execute a job on a thread pool, and get a future for the job's return value. 
+ * Futures come from a fixed set that is allocated with the thread pool, so this 
+ * call does not allocate memory.
+ * 
+ * @param p_thread_pool     the thread pool
+ * @param pfn_parallel_task pointer to job function
+ * @param p_parameter       the parameter of the parallel task
+ * @param pp_future         return
+ * 
+ * @sa thread_pool_future_destroy
+ * 
+ * @return 1 on success, 0 on error or if every future is in use
+ */
+DLLEXPORT int thread_pool_execute_future ( thread_pool *p_thread_pool, fn_parallel_task *pfn_parallel_task, void *p_parameter, thread_pool_future **pp_future );
+
+/** !
+ * Block until a future's job returns. If the caller is a worker of the future's
+ * thread pool, it runs queued jobs while it waits, so jobs can wait on jobs
+ * they executed, to any depth, without running out of workers.
+ * 
+ * @param p_future  the future
+ * @param pp_result return, may be null
+ * 
+ * @return 1 on success, 0 on error
+ */
+DLLEXPORT int thread_pool_future_wait ( thread_pool_future *p_future, void **pp_result );
+
+/** !
+ * Get a future's result without blocking
+ * 
+ * @param p_future  the future
+ * @param pp_result return, may be null
+ * 
+ * @return 1 if the job has returned, else 0
+ */
+DLLEXPORT int thread_pool_future_try_get ( thread_pool_future *p_future, void **pp_result );
+
+/** !
+ * Block until a future's job returns, or until a timeout elapses
+ * 
+ * @param p_future     the future
+ * @param milliseconds the longest time to wait
+ * @param pp_result    return, may be null
+ * 
+ * @return 1 if the job has returned, 0 on timeout or error
+ */
+DLLEXPORT int thread_pool_future_get_timeout ( thread_pool_future *p_future, size_t milliseconds, void **pp_result );
+
+/** !
+ * Run a continuation when a future's job returns, without blocking a thread 
+ * in between. The continuation is queued as soon as the job returns, and gets
+ * the job's result as its parameter. In THREAD_POOL_MODE_WORK_STEALING, it is 
+ * pushed onto the deque of the worker that ran the job, so that worker runs it
+ * next, while the job's data is still in its cache. If the job has already 
+ * returned, the continuation is queued right away.
+ * 
+ * A future has at most one continuation. Chain continuations to build a 
+ * pipeline; each stage starts when the one before it returns, instead of when
+ * the whole thread pool drains.
+ * 
+ * @param p_future          the future
+ * @param pfn_parallel_task the continuation
+ * @param pp_future         return, a future for the continuation's result. May
+ *                          be null, if nobody wants the result
+ * 
+ * @sa thread_pool_future_destroy
+ * 
+ * @return 1 on success, 0 on error, if every future is in use, or if the 
+ *         future already has a continuation
+ */
+DLLEXPORT int thread_pool_future_then ( thread_pool_future *p_future, fn_parallel_task *pfn_parallel_task, thread_pool_future **pp_future );
+
+/** !
+ * Get a future that is done when every one of a set of futures is done. Its 
+ * result is pp_futures, so a continuation can read each result with
+ * thread_pool_future_try_get. The array is stored, not copied, so it must 
+ * outlive the returned future. No thread blocks while the futures run. This 
+ * uses the continuation of each future, so each future may appear only once.
+ * On error, the futures chained so far keep their continuation.
+ * 
+ * @param p_thread_pool the thread pool to take the future from
+ * @param pp_futures    the futures
+ * @param quantity      the quantity of futures
+ * @param pp_future     return
+ * 
+ * @sa thread_pool_future_destroy
+ * 
+ * @return 1 on success, 0 on error, if every future is in use, or if a future
+ *         already has a continuation
+ */
+DLLEXPORT int thread_pool_when_all ( thread_pool *p_thread_pool, thread_pool_future *const *pp_futures, size_t quantity, thread_pool_future **pp_future );
+
+/** !
+ * Give a future back to its thread pool. If the job is still running, the
+ * future is recycled when the job returns. 
+ * 
+ * @param pp_future pointer to future pointer
+ * 
+ * @return 1 on success, 0 on error
+ */
+DLLEXPORT int thread_pool_future_destroy ( thread_pool_future **pp_future );
+
+/** !
+ * Execute a job on a thread pool after a delay. The delay is rounded up to a 
+ * whole millisecond, so the job never runs early.
+ * 
+ * Timers live in a hierarchical timer wheel, which one timer thread per thread
+ * pool serves. The timer thread starts with the first timer. It only queues 
+ * jobs; workers run them. 
+ * 
+ * @param p_thread_pool     the thread pool
+ * @param milliseconds      the delay
+ * @param pfn_parallel_task pointer to job function
+ * @param p_parameter       the parameter of the parallel task
+ * @param pp_timer          return, a handle to cancel the timer with. May be null
+ * 
+ * @sa thread_pool_timer_cancel
+ * 
+ * @return 1 on success, 0 on error
+ */
+DLLEXPORT int thread_pool_execute_after ( thread_pool *p_thread_pool, size_t milliseconds, fn_parallel_task *pfn_parallel_task, void *p_parameter, thread_pool_timer **pp_timer );
+
+/** !
+ * Execute a job on a thread pool once every period, starting one period from 
+ * now. Each run is due a whole number of periods after the first, so a slow 
+ * timer thread or a slow job doesn't make the schedule drift. A run that is 
+ * due while the timer thread is behind by more than a period is skipped.
+ * 
+ * @param p_thread_pool     the thread pool
+ * @param milliseconds      the period
+ * @param pfn_parallel_task pointer to job function
+ * @param p_parameter       the parameter of the parallel task
+ * @param pp_timer          return, a handle to cancel the timer with. May be null,
+ *                          in which case the job runs until the thread pool is
+ *                          destroyed
+ * 
+ * @sa thread_pool_timer_cancel
+ * 
+ * @return 1 on success, 0 on error
+ */
+DLLEXPORT int thread_pool_execute_every ( thread_pool *p_thread_pool, size_t milliseconds, fn_parallel_task *pfn_parallel_task, void *p_parameter, thread_pool_timer **pp_timer );
+
+/** !
+ * Cancel a timer, and release the handle. This takes constant time, however 
+ * many timers there are. A job that the timer has already queued still runs. 
+ * Cancelling a one shot timer that has already fired just releases the handle.
+ * A handle may outlive its thread pool; cancelling it then just releases it.
+ * Every handle must be released, or its timer leaks.
+ * 
+ * @param pp_timer pointer to timer pointer
+ * 
+ * @return 1 on success, 0 on error
+ */
+DLLEXPORT int thread_pool_timer_cancel ( thread_pool_timer **pp_timer );
+
+/** !
+ * Construct a task group on a thread pool. Jobs executed through a group run 
+ * on the thread pool like any other job, and thread_pool_group_wait waits for 
+ * the group's jobs only, so handlers that share one thread pool don't wait on 
+ * each other's work.
  * 
+ * @param pp_group      result
  * @param p_thread_pool the thread pool
  * 
+ * @sa thread_pool_group_destroy
+ * 
+ * @return 1 on success, 0 on error
+ */
+DLLEXPORT int thread_pool_group_construct ( thread_pool_group **pp_group, thread_pool *p_thread_pool );
+
+/** !
+ * Execute a job on a task group's thread pool, as part of the group. Jobs may 
+ * execute more jobs in their own group. If the group has more queued jobs than
+ * its queue holds, the caller runs the group's jobs, and sleeps when there are 
+ * none, until a slot is free.
+ * 
+ * @param p_group           the task group
+ * @param pfn_parallel_task pointer to job function
+ * @param p_parameter       the parameter of the parallel task
+ * 
+ * @return 1 on success, 0 on error
+ */
+DLLEXPORT int thread_pool_group_execute ( thread_pool_group *p_group, fn_parallel_task *pfn_parallel_task, void *p_parameter );
+
+/** !
+ * Block until every job of a task group finishes. While the group has queued
+ * jobs, the caller runs them, instead of waiting for a worker to get to them.
+ * Then it sleeps until the jobs that are running on workers finish. Jobs in 
+ * other groups, and jobs outside of any group, are not waited for. If the 
+ * caller is a worker of the thread pool, it runs any queued job instead of 
+ * sleeping.
+ * 
+ * @param p_group the task group
+ * 
  * @return 1 on success, 0 on error
  */
+DLLEXPORT int thread_pool_group_wait ( thread_pool_group *p_group );
+
+/** !
+ * Destroy a task group. Jobs of the group that are still queued run as usual, 
+ * and the group's memory is released after the last one.
+ * 
+ * @param pp_group pointer to task group pointer
+ * 
+ * @return 1 on success, 0 on error
+ */
+DLLEXPORT int thread_pool_group_destroy ( thread_pool_group **pp_group );
+
+/** !
+ * Run a loop body over the range [begin, end) on a thread pool. The range is 
+ * split in half recursively, and each half is handed to the thread pool, until
+ * the pieces are as small as the grain allows. The calling thread runs pieces
+ * too, and returns when every piece is done. Unlike thread_pool_wait_idle, 
+ * this does not wait for unrelated jobs. 
+ * 
+ * @param p_thread_pool    the thread pool
+ * @param begin            the first index
+ * @param end              one past the last index
+ * @param grain            the smallest quantity of indices in a piece
+ * @param pfn_parallel_for the loop body, called once per piece
+ * @param p_context        the context of the loop body
+ * 
+ * @return 1 on success, 0 on error
+ */
+DLLEXPORT int parallel_for ( thread_pool *p_thread_pool, size_t begin, size_t end, size_t grain, fn_parallel_for *pfn_parallel_for, void *p_context );
+
+/** !
+ * Reduce the range [begin, end) to one value on a thread pool. Each worker, and
+ * the caller, folds its pieces of the range into its own partial. Partials 
+ * start as a copy of the identity, and sit on separate cache lines. When the 
+ * range is done, the caller combines the partials one after another, and 
+ * copies the result to p_result. There is a partial per worker, plus two, so 
+ * the combine calls pfn_parallel_combine at most thread_quantity + 1 times.
+ * 
+ * @param p_thread_pool        the thread pool
+ * @param begin                the first index
+ * @param end                  one past the last index
+ * @param grain                the smallest quantity of indices in a piece
+ * @param size                 the size of a value, in bytes
+ * @param p_identity           the identity value of the combine function
+ * @param pfn_parallel_reduce  folds a piece of the range into a partial
+ * @param pfn_parallel_combine combines another partial into a partial
+ * @param p_context            the context of both functions
+ * @param p_result             return
+ * 
+ * @return 1 on success, 0 on error
+ */
+DLLEXPORT int parallel_reduce ( thread_pool *p_thread_pool, size_t begin, size_t end, size_t grain, size_t size, const void *p_identity, fn_parallel_reduce *pfn_parallel_reduce, fn_parallel_combine *pfn_parallel_combine, void *p_context, void *p_result );
+
+/** !
+ * Get the quantity of running threads in a thread pool
+ * 
+ * @param p_thread_pool the thread pool
+ * 
+ * @return the quantity of threads
+ */
+DLLEXPORT size_t thread_pool_get_thread_quantity ( thread_pool *p_thread_pool );
+
+/** !
+ * Report where a thread of a thread pool runs
+ * 
+ * @param p_thread_pool the thread pool
+ * @param index         the index of the thread
+ * @param p_cpu         return, the CPU the thread is pinned to, or -1. May be null
+ * @param p_node        return, the NUMA node of the CPU, or -1. May be null
+ * 
+ * @return 1 on success, 0 on error
+ */
+DLLEXPORT int thread_pool_get_placement ( thread_pool *p_thread_pool, size_t index, int *p_cpu, int *p_node );
+
+/** !
+ * Test if the thread pool is idle
+ * 
+ * @param p_thread_pool the thread pool
+ * 
+ * @return true if no job is queued or running, else false
+ */
 DLLEXPORT bool thread_pool_is_idle ( thread_pool *p_thread_pool );
 
 /** !
- * Block until a thread pool finishes it's active jobs
+ * Get a thread pool's statistics. Each worker counts its own jobs in its own
+ * cache line, without atomic read modify writes, so the counters are always on.
+ * This call sums them, so the result is a snapshot, not an atomic one. 
+ * 
+ * Workers count their time when a job starts and ends, so a worker that has 
+ * been idle since its last job doesn't count that time yet. Workers sample the
+ * depth of the queues every few jobs, so the maximum depth is the most jobs 
+ * that were seen waiting, not an exact bound. Jobs that run on a thread that 
+ * isn't a worker, like the submitter under THREAD_POOL_OVERFLOW_CALLER_RUNS, 
+ * are not counted.
+ * 
+ * @param p_thread_pool the thread pool
+ * @param p_statistics  return
+ * 
+ * @return 1 on success, 0 on error
+ */
+DLLEXPORT int thread_pool_stats ( thread_pool *p_thread_pool, thread_pool_statistics *p_statistics );
+
+/** !
+ * Block until a thread pool finishes it's active jobs. The caller sleeps until
+ * the last outstanding job finishes. A job can't wait for its own thread pool,
+ * because it is one of the outstanding jobs; wait on a future or a task group
+ * instead.
  * 
  * @param p_thread_pool the thread pool
  * 
@@ -70,6 +562,16 @@ DLLEXPORT bool thread_pool_is_idle ( thread_pool *p_thread_pool );
  */
 DLLEXPORT int thread_pool_wait_idle ( thread_pool *p_thread_pool );
 
+/** !
+ * Block until a thread pool finishes it's active jobs, or until a timeout elapses
+ * 
+ * @param p_thread_pool the thread pool
+ * @param milliseconds  the longest time to wait
+ * 
+ * @return 1 if the thread pool is idle, 0 on timeout or error
+ */
+DLLEXPORT int thread_pool_wait_idle_timeout ( thread_pool *p_thread_pool, size_t milliseconds );
+
 /** !
  * Destroy a thread pool
  * 
@@ -0,0 +1,105 @@
+/** !
+ * Timeline traces of thread pool jobs and schedule tasks
+ *
+ * @file parallel/trace.h
+ *
+ * @author Jacob Smith
+ */
+
+// Include guard
+#pragma once
+
+// Standard library
+#include <stdio.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+
+// parallel
+#include <parallel/parallel.h>
+
+// Preprocessor definitions
+#define PARALLEL_TRACE_EVENTS 65536 // per thread
+
+// Record an event, if tracing is compiled in and started. When tracing is
+// stopped, this costs one relaxed load and a branch
+#ifdef BUILD_PARALLEL_WITH_TRACE
+    #define PARALLEL_TRACE_BEGIN(name, detail, address) do { if ( atomic_load_explicit(&parallel_trace_enabled, memory_order_relaxed) ) parallel_trace_event('B', (name), (detail), (address)); } while (0)
+    #define PARALLEL_TRACE_END(name, detail, address)   do { if ( atomic_load_explicit(&parallel_trace_enabled, memory_order_relaxed) ) parallel_trace_event('E', (name), (detail), (address)); } while (0)
+#else
+    #define PARALLEL_TRACE_BEGIN(name, detail, address) ((void) 0)
+    #define PARALLEL_TRACE_END(name, detail, address)   ((void) 0)
+#endif
+
+// Data
+extern atomic_bool parallel_trace_enabled;
+
+// Function declarations
+
+// Start
+/** !
+ * Start recording a trace. Each thread records its events into its own
+ * buffer, without locks. A thread's buffer holds event_quantity events; once
+ * it is full, the thread drops its newest events. Starting a trace discards
+ * the events of the last one.
+ *
+ * A trace may start while parallel_trace_write runs. A thread empties, or 
+ * grows, its buffer under the same lock that parallel_trace_write holds, so 
+ * its first event of the new trace waits for the write to finish. 
+ *
+ * If the library is built without BUILD_PARALLEL_WITH_TRACE, nothing is ever
+ * recorded.
+ *
+ * @param event_quantity the quantity of events per thread, 0 for the default
+ *
+ * @return 1 on success, 0 on error
+ */
+DLLEXPORT int parallel_trace_start ( size_t event_quantity );
+
+/** !
+ * Stop recording a trace. The events stay in their buffers until the next
+ * call to parallel_trace_start
+ *
+ * @param void
+ *
+ * @return 1 on success, 0 on error
+ */
+DLLEXPORT int parallel_trace_stop ( void );
+
+// Record
+/** !
+ * Name the calling thread in the trace. The name is copied
+ *
+ * @param name the name of the thread
+ *
+ * @return 1 on success, 0 on error
+ */
+DLLEXPORT int parallel_trace_name_thread ( const char *const name );
+
+/** !
+ * Record an event on the calling thread. Use PARALLEL_TRACE_BEGIN and
+ * PARALLEL_TRACE_END instead, so the call is skipped when tracing is stopped.
+ *
+ * The strings are not copied, so they must outlive the call to
+ * parallel_trace_write.
+ *
+ * @param phase     'B' to begin a span, 'E' to end it
+ * @param name      the name of the span
+ * @param detail    a string shown with the span, or null pointer
+ * @param p_address an address shown with the span, like a job's function, or null pointer
+ *
+ * @return void
+ */
+DLLEXPORT void parallel_trace_event ( char phase, const char *name, const char *detail, const void *p_address );
+
+// Output
+/** !
+ * Write the recorded events as Chrome trace event JSON, which loads in
+ * chrome://tracing and in Perfetto. Each thread is a track. Stop the trace
+ * first, or events recorded during the call may be missing. If a trace starts
+ * during the call, the threads that have joined it are left out.
+ *
+ * @param path the path of the file
+ *
+ * @return 1 on success, 0 on error
+ */
+DLLEXPORT int parallel_trace_write ( const char *const path );
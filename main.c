@@ -362,15 +362,16 @@ int parallel_thread_pool_example ( int argc, const char *argv[] )
 
     // Initialized data
     thread_pool *p_thread_pool = (void *) 0;
+    void        *_parameters[PARALLEL_THREAD_POOL_TASKS] = { 0 };
 
     // Construct a thread pool
     if ( thread_pool_construct(&p_thread_pool, PARALLEL_THREADS_QUANTITY) == 0 ) goto failed_to_construct_thread_pool;
 
-    // Add 15 tasks ...
-    for (size_t i = 1; i <= 16; i++)
+    // Number each task
+    for (size_t i = 0; i < PARALLEL_THREAD_POOL_TASKS; i++) _parameters[i] = (void *) ( i + 1 );
 
-        // ... to the thread pool
-        thread_pool_execute(p_thread_pool, print_something_to_standard_out, (void *)i);
+    // Add the tasks to the thread pool
+    if ( thread_pool_execute_batch(p_thread_pool, print_something_to_standard_out, _parameters, PARALLEL_THREAD_POOL_TASKS) == 0 ) goto failed_to_start_thread_pool;
 
     // Log the idle start
     log_info("Started thread pool wait\n");
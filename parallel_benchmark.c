@@ -0,0 +1,1820 @@
+/** !
+ * Benchmarks for the parallel library
+ *
+ * @file parallel_benchmark.c
+ *
+ * @author Jacob Smith
+ */
+
+// Standard library
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdatomic.h>
+#include <time.h>
+
+// log
+#include <log/log.h>
+
+// parallel
+#include <parallel/parallel.h>
+#include <parallel/thread.h>
+#include <parallel/thread_pool.h>
+#include <parallel/schedule.h>
+
+// Preprocessor definitions
+#define PARALLEL_BENCHMARK_THREADS     4
+#define PARALLEL_BENCHMARK_SUBMIT_JOBS 20000
+#define PARALLEL_BENCHMARK_BATCH_SIZE  64
+#define PARALLEL_BENCHMARK_JOB_SPIN    64
+#define PARALLEL_BENCHMARK_TREE_DEPTH  11
+#define PARALLEL_BENCHMARK_TREE_ROUNDS 20
+#define PARALLEL_BENCHMARK_REDUCE_SIZE 2000000
+#define PARALLEL_BENCHMARK_REDUCE_GRAIN 4096
+#define PARALLEL_BENCHMARK_LAYOUT_WRITES 20000000
+#define PARALLEL_BENCHMARK_CACHE_LINE_SIZE 64
+#define PARALLEL_BENCHMARK_LATENCY_JOBS    10000
+#define PARALLEL_BENCHMARK_LATENCY_THREADS 2
+#define PARALLEL_BENCHMARK_TIMER_JOBS      1000
+#define PARALLEL_BENCHMARK_TIMER_SPREAD    500
+#define PARALLEL_BENCHMARK_TIMER_PERIOD    10
+#define PARALLEL_BENCHMARK_TIMER_PERIODS   100
+#define PARALLEL_BENCHMARK_SCHEDULE_THREADS 4
+#define PARALLEL_BENCHMARK_SCHEDULE_TASKS   250 // per thread
+#define PARALLEL_BENCHMARK_SCHEDULE_MILLISECONDS 1000
+#define PARALLEL_BENCHMARK_SCHEDULE_PIPELINE 4
+
+// Enumeration definitions
+enum parallel_benchmarks_e
+{
+    PARALLEL_SUBMIT_BENCHMARK    = 0,
+    PARALLEL_FORK_JOIN_BENCHMARK = 1,
+    PARALLEL_REDUCE_BENCHMARK    = 2,
+    PARALLEL_LAYOUT_BENCHMARK    = 3,
+    PARALLEL_LATENCY_BENCHMARK   = 4,
+    PARALLEL_TIMER_BENCHMARK     = 5,
+    PARALLEL_SCHEDULE_BENCHMARK  = 6,
+    PARALLEL_BENCHMARKS_QUANTITY = 7
+};
+
+// Forward declarations
+struct scan_pool_s;
+struct scan_pool_thread_s;
+struct parallel_benchmark_result_s;
+struct layout_slot_s;
+
+// Type definitions
+typedef struct scan_pool_s                scan_pool;
+typedef struct scan_pool_thread_s         scan_pool_thread;
+typedef struct parallel_benchmark_result_s parallel_benchmark_result;
+typedef struct layout_slot_s               layout_slot;
+
+// Structure definitions
+struct scan_pool_thread_s
+{
+    scan_pool         *p_scan_pool;
+    atomic_bool        running;
+    bool               pending;
+    fn_parallel_task  *pfn_parallel_task;
+    void              *p_parameter;
+    pthread_mutex_t    _lock;
+    pthread_cond_t     _signal;
+    parallel_thread   *p_parallel_thread;
+};
+
+struct scan_pool_s
+{
+    mutex            _lock;
+    size_t           thread_quantity;
+    scan_pool_thread _threads[PARALLEL_BENCHMARK_THREADS];
+};
+
+struct layout_slot_s
+{
+    _Alignas(PARALLEL_BENCHMARK_CACHE_LINE_SIZE) atomic_size_t value;
+};
+
+struct parallel_benchmark_result_s
+{
+    double submit_mean_ns,
+           submit_p50_ns,
+           submit_p99_ns,
+           submit_max_ns,
+           jobs_per_second;
+};
+
+// Data
+static atomic_size_t  jobs_completed = 0;
+static thread_pool   *p_tree_pool    = (void *) 0;
+static pthread_mutex_t shared_sum_lock = PTHREAD_MUTEX_INITIALIZER;
+static double          shared_sum      = 0;
+static timestamp       periodic_samples[PARALLEL_BENCHMARK_TIMER_PERIODS] = { 0 };
+static atomic_size_t   periodic_runs   = 0;
+static atomic_size_t   schedule_iterations = 0;
+static char            schedule_task_names[PARALLEL_BENCHMARK_SCHEDULE_TASKS][16] = { 0 };
+
+// Forward declarations
+/** !
+ * Print a usage message to standard out
+ *
+ * @param argv0 the name of the program
+ *
+ * @return void
+ */
+void print_usage ( const char *argv0 );
+
+/** !
+ * Parse command line arguments
+ *
+ * @param argc              the argc parameter of the entry point
+ * @param argv              the argv parameter of the entry point
+ * @param benchmarks_to_run return
+ *
+ * @return void on success, program abort on failure
+ */
+void parse_command_line_arguments ( int argc, const char *argv[], bool *benchmarks_to_run );
+
+/** !
+ * Submit benchmark. Compares the queue backed thread pool to the scan and
+ * retry design it replaced
+ *
+ * @param argc the argc parameter of the entry point
+ * @param argv the argv parameter of the entry point
+ *
+ * @return 1 on success, 0 on error
+ */
+int parallel_submit_benchmark ( int argc, const char *argv[] );
+
+/** !
+ * Fork join benchmark. Compares the shared queue mode to the work stealing mode
+ * on a workload where jobs spawn more jobs
+ *
+ * @param argc the argc parameter of the entry point
+ * @param argv the argv parameter of the entry point
+ *
+ * @return 1 on success, 0 on error
+ */
+int parallel_fork_join_benchmark ( int argc, const char *argv[] );
+
+/** !
+ * Reduce benchmark. Compares a mutex protected shared accumulator to 
+ * parallel_reduce's per worker partials
+ *
+ * @param argc the argc parameter of the entry point
+ * @param argv the argv parameter of the entry point
+ *
+ * @return 1 on success, 0 on error
+ */
+int parallel_reduce_benchmark ( int argc, const char *argv[] );
+
+/** !
+ * Layout benchmark. Each thread writes its own counter. Compares counters that
+ * share cache lines, like the worker state of the original thread pool, to 
+ * counters that each own a cache line, like the worker state of this one
+ *
+ * @param argc the argc parameter of the entry point
+ * @param argv the argv parameter of the entry point
+ *
+ * @return 1 on success, 0 on error
+ */
+int parallel_layout_benchmark ( int argc, const char *argv[] );
+
+/** !
+ * Write a counter PARALLEL_BENCHMARK_LAYOUT_WRITES times
+ *
+ * @param p_parameter pointer to an atomic_size_t
+ *
+ * @return null pointer
+ */
+void *layout_job ( void *p_parameter );
+
+/** !
+ * Latency benchmark. Submits one job at a time to an idle pool, and measures
+ * the time from submit until the job starts, with parked and busy polling workers
+ *
+ * @param argc the argc parameter of the entry point
+ * @param argv the argv parameter of the entry point
+ *
+ * @return 1 on success, 0 on error
+ */
+int parallel_latency_benchmark ( int argc, const char *argv[] );
+
+/** !
+ * Replace a submit time with the time from submit until now
+ *
+ * @param p_parameter pointer to the timestamp of the submit
+ *
+ * @return null pointer
+ */
+void *latency_job ( void *p_parameter );
+
+/** !
+ * Timer benchmark. Schedules delayed jobs across a spread of delays, and 
+ * measures how late each one starts. Then runs a periodic job, and measures 
+ * how far its runs drift from the period
+ *
+ * @param argc the argc parameter of the entry point
+ * @param argv the argv parameter of the entry point
+ *
+ * @return 1 on success, 0 on error
+ */
+int parallel_timer_benchmark ( int argc, const char *argv[] );
+
+/** !
+ * Replace a due time with the time from the due time until now
+ *
+ * @param p_parameter pointer to the due time
+ *
+ * @return null pointer
+ */
+void *timer_job ( void *p_parameter );
+
+/** !
+ * Store the time of each run of a periodic job, up to PARALLEL_BENCHMARK_TIMER_PERIODS runs
+ *
+ * @param p_parameter unused
+ *
+ * @return null pointer
+ */
+void *periodic_job ( void *p_parameter );
+
+/** !
+ * Schedule benchmark. Runs a repeating schedule of 1,000 tasks on 4 threads, 
+ * where each task waits on a task of the thread before it, and measures the 
+ * time of one iteration. Runs the schedule on dedicated threads, then on a 
+ * thread pool, one iteration at a time, then pipelined
+ *
+ * @param argc the argc parameter of the entry point
+ * @param argv the argv parameter of the entry point
+ *
+ * @return 1 on success, 0 on error
+ */
+int parallel_schedule_benchmark ( int argc, const char *argv[] );
+
+/** !
+ * An empty schedule task
+ *
+ * @param p_parameter unused
+ *
+ * @return null pointer
+ */
+void *schedule_step ( void *p_parameter );
+
+/** !
+ * The last task of the schedule. Count an iteration
+ *
+ * @param p_parameter unused
+ *
+ * @return null pointer
+ */
+void *schedule_tick ( void *p_parameter );
+
+/** !
+ * Compare two timestamps, for qsort
+ *
+ * @param p_a pointer to a timestamp
+ * @param p_b pointer to a timestamp
+ *
+ * @return a negative, zero, or positive value
+ */
+static int timestamp_compare ( const void *p_a, const void *p_b );
+
+/** !
+ * Add each term of a piece to the shared accumulator, under its lock
+ *
+ * @param begin     the first index
+ * @param end       one past the last index
+ * @param p_context unused
+ *
+ * @return void
+ */
+void shared_sum_body ( size_t begin, size_t end, void *p_context );
+
+/** !
+ * Add each term of a piece to a partial
+ *
+ * @param begin     the first index
+ * @param end       one past the last index
+ * @param p_partial the partial
+ * @param p_context unused
+ *
+ * @return void
+ */
+void reduce_sum_body ( size_t begin, size_t end, void *p_partial, void *p_context );
+
+/** !
+ * Add one partial to another
+ *
+ * @param p_partial the partial
+ * @param p_other   the other partial
+ * @param p_context unused
+ *
+ * @return void
+ */
+void reduce_sum_combine ( void *p_partial, const void *p_other, void *p_context );
+
+/** !
+ * A node of a binary tree of jobs. Run a short job, then spawn two children
+ *
+ * @param p_parameter the depth of the node's subtree
+ *
+ * @return 0
+ */
+void *tree_job ( void *p_parameter );
+
+/** !
+ * A short job. Spin for a few iterations, then count the job
+ *
+ * @param p_parameter unused
+ *
+ * @return 0
+ */
+void *tiny_job ( void *p_parameter );
+
+/** !
+ * Summarize submit latencies and throughput
+ *
+ * @param p_samples submit latency of each job, in ticks. Sorted in place
+ * @param quantity  the quantity of samples
+ * @param elapsed   ticks from the first submit until the pool is idle
+ * @param p_result  return
+ *
+ * @return void
+ */
+void parallel_benchmark_summarize ( timestamp *p_samples, size_t quantity, timestamp elapsed, parallel_benchmark_result *p_result );
+
+/** !
+ * Print a benchmark result to standard out
+ *
+ * @param name     the name of the configuration
+ * @param p_result the result
+ *
+ * @return void
+ */
+void parallel_benchmark_print ( const char *name, const parallel_benchmark_result *p_result );
+
+/** !
+ * Construct a scan and retry pool. This mirrors the original thread pool, where
+ * a producer locks the pool, scans every worker's running flag, and starts over
+ * if they are all busy. The per worker hand off waits on a predicate, so the
+ * replica does not lose wakeups under load
+ *
+ * @param p_scan_pool     the pool
+ * @param thread_quantity the quantity of threads
+ *
+ * @return 1 on success, 0 on error
+ */
+int scan_pool_construct ( scan_pool *p_scan_pool, size_t thread_quantity );
+
+/** !
+ * Execute a job on a scan and retry pool
+ *
+ * @param p_scan_pool       the pool
+ * @param pfn_parallel_task pointer to job function
+ * @param p_parameter       the parameter of the parallel task
+ *
+ * @return 1 on success, 0 on error
+ */
+int scan_pool_execute ( scan_pool *p_scan_pool, fn_parallel_task *pfn_parallel_task, void *p_parameter );
+
+/** !
+ * Spin until a scan and retry pool is idle
+ *
+ * @param p_scan_pool the pool
+ *
+ * @return 1 on success, 0 on error
+ */
+int scan_pool_wait_idle ( scan_pool *p_scan_pool );
+
+/** !
+ * Scan and retry worker loop
+ *
+ * @param p_scan_pool_thread who am I?
+ *
+ * @return never
+ */
+void *scan_pool_work ( scan_pool_thread *p_scan_pool_thread );
+
+// Entry point
+int main ( int argc, const char *argv[] )
+{
+
+    // Initialized data
+    bool benchmarks_to_run[PARALLEL_BENCHMARKS_QUANTITY] = { 0 };
+
+    // Parse command line arguments
+    parse_command_line_arguments(argc, argv, benchmarks_to_run);
+
+    // Formatting
+    log_info("╭────────────────────╮\n");
+    log_info("│ parallel benchmark │\n");
+    log_info("╰────────────────────╯\n\n");
+
+    // Run the submit benchmark
+    if ( benchmarks_to_run[PARALLEL_SUBMIT_BENCHMARK] )
+
+        // Error check
+        if ( parallel_submit_benchmark(argc, argv) == 0 ) goto failed_to_run_submit_benchmark;
+
+    // Run the fork join benchmark
+    if ( benchmarks_to_run[PARALLEL_FORK_JOIN_BENCHMARK] )
+
+        // Error check
+        if ( parallel_fork_join_benchmark(argc, argv) == 0 ) goto failed_to_run_fork_join_benchmark;
+
+    // Run the reduce benchmark
+    if ( benchmarks_to_run[PARALLEL_REDUCE_BENCHMARK] )
+
+        // Error check
+        if ( parallel_reduce_benchmark(argc, argv) == 0 ) goto failed_to_run_reduce_benchmark;
+
+    // Run the layout benchmark
+    if ( benchmarks_to_run[PARALLEL_LAYOUT_BENCHMARK] )
+
+        // Error check
+        if ( parallel_layout_benchmark(argc, argv) == 0 ) goto failed_to_run_layout_benchmark;
+
+    // Run the latency benchmark
+    if ( benchmarks_to_run[PARALLEL_LATENCY_BENCHMARK] )
+
+        // Error check
+        if ( parallel_latency_benchmark(argc, argv) == 0 ) goto failed_to_run_latency_benchmark;
+
+    // Run the timer benchmark
+    if ( benchmarks_to_run[PARALLEL_TIMER_BENCHMARK] )
+
+        // Error check
+        if ( parallel_timer_benchmark(argc, argv) == 0 ) goto failed_to_run_timer_benchmark;
+
+    // Run the schedule benchmark
+    if ( benchmarks_to_run[PARALLEL_SCHEDULE_BENCHMARK] )
+
+        // Error check
+        if ( parallel_schedule_benchmark(argc, argv) == 0 ) goto failed_to_run_schedule_benchmark;
+
+    // Success
+    return EXIT_SUCCESS;
+
+    // Error handling
+    {
+        failed_to_run_submit_benchmark:
+
+            // Print an error message
+            log_error("Error: Failed to run submit benchmark!\n");
+
+            // Error
+            return EXIT_FAILURE;
+
+        failed_to_run_fork_join_benchmark:
+
+            // Print an error message
+            log_error("Error: Failed to run fork join benchmark!\n");
+
+            // Error
+            return EXIT_FAILURE;
+
+        failed_to_run_reduce_benchmark:
+
+            // Print an error message
+            log_error("Error: Failed to run reduce benchmark!\n");
+
+            // Error
+            return EXIT_FAILURE;
+
+        failed_to_run_layout_benchmark:
+
+            // Print an error message
+            log_error("Error: Failed to run layout benchmark!\n");
+
+            // Error
+            return EXIT_FAILURE;
+
+        failed_to_run_latency_benchmark:
+
+            // Print an error message
+            log_error("Error: Failed to run latency benchmark!\n");
+
+            // Error
+            return EXIT_FAILURE;
+
+        failed_to_run_timer_benchmark:
+
+            // Print an error message
+            log_error("Error: Failed to run timer benchmark!\n");
+
+            // Error
+            return EXIT_FAILURE;
+
+        failed_to_run_schedule_benchmark:
+
+            // Print an error message
+            log_error("Error: Failed to run schedule benchmark!\n");
+
+            // Error
+            return EXIT_FAILURE;
+    }
+}
+
+void print_usage ( const char *argv0 )
+{
+
+    // Argument check
+    if ( argv0 == (void *) 0 ) exit(EXIT_FAILURE);
+
+    // Print a usage message to standard out
+    printf("Usage: %s [submit] [fork-join] [reduce] [layout] [latency] [timer] [schedule]\n", argv0);
+
+    // Done
+    return;
+}
+
+void parse_command_line_arguments ( int argc, const char *argv[], bool *benchmarks_to_run )
+{
+
+    // If no command line arguments are supplied, run all the benchmarks
+    if ( argc == 1 ) goto all_benchmarks;
+
+    // Error check
+    if ( argc > PARALLEL_BENCHMARKS_QUANTITY + 1 ) goto invalid_arguments;
+
+    // Iterate through each command line argument
+    for (size_t i = 1; i < (size_t) argc; i++)
+    {
+
+        // Submit benchmark?
+        if ( strcmp(argv[i], "submit") == 0 )
+
+            // Set the submit benchmark flag
+            benchmarks_to_run[PARALLEL_SUBMIT_BENCHMARK] = true;
+
+        // Fork join benchmark?
+        else if ( strcmp(argv[i], "fork-join") == 0 )
+
+            // Set the fork join benchmark flag
+            benchmarks_to_run[PARALLEL_FORK_JOIN_BENCHMARK] = true;
+
+        // Reduce benchmark?
+        else if ( strcmp(argv[i], "reduce") == 0 )
+
+            // Set the reduce benchmark flag
+            benchmarks_to_run[PARALLEL_REDUCE_BENCHMARK] = true;
+
+        // Layout benchmark?
+        else if ( strcmp(argv[i], "layout") == 0 )
+
+            // Set the layout benchmark flag
+            benchmarks_to_run[PARALLEL_LAYOUT_BENCHMARK] = true;
+
+        // Latency benchmark?
+        else if ( strcmp(argv[i], "latency") == 0 )
+
+            // Set the latency benchmark flag
+            benchmarks_to_run[PARALLEL_LATENCY_BENCHMARK] = true;
+
+        // Timer benchmark?
+        else if ( strcmp(argv[i], "timer") == 0 )
+
+            // Set the timer benchmark flag
+            benchmarks_to_run[PARALLEL_TIMER_BENCHMARK] = true;
+
+        // Schedule benchmark?
+        else if ( strcmp(argv[i], "schedule") == 0 )
+
+            // Set the schedule benchmark flag
+            benchmarks_to_run[PARALLEL_SCHEDULE_BENCHMARK] = true;
+
+        // Default
+        else goto invalid_arguments;
+    }
+
+    // Success
+    return;
+
+    // Set each benchmark flag
+    all_benchmarks:
+    {
+
+        // For each benchmark ...
+        for (size_t i = 0; i < PARALLEL_BENCHMARKS_QUANTITY; i++)
+
+            // ... set the benchmark flag
+            benchmarks_to_run[i] = true;
+
+        // Success
+        return;
+    }
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            invalid_arguments:
+
+                // Print a usage message to standard out
+                print_usage(argv[0]);
+
+                // Abort
+                exit(EXIT_FAILURE);
+        }
+    }
+}
+
+int parallel_submit_benchmark ( int argc, const char *argv[] )
+{
+
+    // Supress warnings
+    (void) argc;
+    (void) argv;
+
+    // Formatting
+    log_info("╭──────────────────╮\n");
+    log_info("│ submit benchmark │\n");
+    log_info("╰──────────────────╯\n");
+    log_info("This benchmark submits %d short jobs to a pool of %d threads, and measures\n", PARALLEL_BENCHMARK_SUBMIT_JOBS, PARALLEL_BENCHMARK_THREADS);
+    log_info("the latency of each submit, and the throughput of the pool. The batch run\n");
+    log_info("submits %d jobs per call, and reports the latency per job.\n\n", PARALLEL_BENCHMARK_BATCH_SIZE);
+
+    // Initialized data
+    timestamp                 *p_samples  = PARALLEL_REALLOC(0, PARALLEL_BENCHMARK_SUBMIT_JOBS * sizeof(timestamp));
+    thread_pool               *p_pool     = (void *) 0;
+    scan_pool                 *p_scan     = PARALLEL_REALLOC(0, sizeof(scan_pool));
+    parallel_benchmark_result  _result    = { 0 };
+    timestamp                  start      = 0;
+    void                      *_batch_parameters[PARALLEL_BENCHMARK_BATCH_SIZE] = { 0 };
+
+    // Error check
+    if ( p_samples == (void *) 0 ) goto no_mem;
+    if ( p_scan    == (void *) 0 ) goto no_mem;
+
+    // Construct a scan and retry pool
+    if ( scan_pool_construct(p_scan, PARALLEL_BENCHMARK_THREADS) == 0 ) goto failed_to_construct_thread_pool;
+
+    // Start the clock
+    start = timer_high_precision();
+
+    // Submit each job
+    for (size_t i = 0; i < PARALLEL_BENCHMARK_SUBMIT_JOBS; i++)
+    {
+
+        // Initialized data
+        timestamp t = timer_high_precision();
+
+        // Submit the job
+        scan_pool_execute(p_scan, tiny_job, (void *) 0);
+
+        // Store the latency
+        p_samples[i] = timer_high_precision() - t;
+    }
+
+    // Wait for the pool to drain
+    scan_pool_wait_idle(p_scan);
+
+    // Error check
+    if ( atomic_exchange(&jobs_completed, 0) != PARALLEL_BENCHMARK_SUBMIT_JOBS ) goto lost_jobs;
+
+    // Summarize
+    parallel_benchmark_summarize(p_samples, PARALLEL_BENCHMARK_SUBMIT_JOBS, timer_high_precision() - start, &_result);
+
+    // Print the result
+    parallel_benchmark_print("scan and retry", &_result);
+
+    // Construct a queue backed thread pool
+    if ( thread_pool_construct(&p_pool, PARALLEL_BENCHMARK_THREADS) == 0 ) goto failed_to_construct_thread_pool;
+
+    // Start the clock
+    start = timer_high_precision();
+
+    // Submit each job
+    for (size_t i = 0; i < PARALLEL_BENCHMARK_SUBMIT_JOBS; i++)
+    {
+
+        // Initialized data
+        timestamp t = timer_high_precision();
+
+        // Submit the job
+        thread_pool_execute(p_pool, tiny_job, (void *) 0);
+
+        // Store the latency
+        p_samples[i] = timer_high_precision() - t;
+    }
+
+    // Wait for the pool to drain
+    thread_pool_wait_idle(p_pool);
+
+    // Error check
+    if ( atomic_exchange(&jobs_completed, 0) != PARALLEL_BENCHMARK_SUBMIT_JOBS ) goto lost_jobs;
+
+    // Summarize
+    parallel_benchmark_summarize(p_samples, PARALLEL_BENCHMARK_SUBMIT_JOBS, timer_high_precision() - start, &_result);
+
+    // Print the result
+    parallel_benchmark_print("job queue", &_result);
+
+    // Start the clock
+    start = timer_high_precision();
+
+    // Submit each batch
+    for (size_t i = 0; i < PARALLEL_BENCHMARK_SUBMIT_JOBS; i += PARALLEL_BENCHMARK_BATCH_SIZE)
+    {
+
+        // Initialized data
+        size_t    quantity = ( PARALLEL_BENCHMARK_SUBMIT_JOBS - i < PARALLEL_BENCHMARK_BATCH_SIZE ) ? PARALLEL_BENCHMARK_SUBMIT_JOBS - i : PARALLEL_BENCHMARK_BATCH_SIZE;
+        timestamp t        = timer_high_precision();
+
+        // Submit the batch
+        thread_pool_execute_batch(p_pool, tiny_job, _batch_parameters, quantity);
+
+        // Store the latency of each job, amortized over the batch
+        t = timer_high_precision() - t;
+        for (size_t j = 0; j < quantity; j++) p_samples[i + j] = t / quantity;
+    }
+
+    // Wait for the pool to drain
+    thread_pool_wait_idle(p_pool);
+
+    // Error check
+    if ( atomic_exchange(&jobs_completed, 0) != PARALLEL_BENCHMARK_SUBMIT_JOBS ) goto lost_jobs;
+
+    // Summarize
+    parallel_benchmark_summarize(p_samples, PARALLEL_BENCHMARK_SUBMIT_JOBS, timer_high_precision() - start, &_result);
+
+    // Print the result
+    parallel_benchmark_print("job queue batch", &_result);
+
+    // Clean up. The scan and retry workers never exit, so that pool lives
+    // until the process does
+    thread_pool_destroy(&p_pool);
+    PARALLEL_FREE(p_samples);
+
+    // Formatting
+    putchar('\n');
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Parallel errors
+        {
+            failed_to_construct_thread_pool:
+
+                // Write an error message to standard out
+                log_error("Failed to construct thread pool in call to function \"%s\"\n", __FUNCTION__);
+
+                // Error
+                return 0;
+
+            lost_jobs:
+
+                // Write an error message to standard out
+                log_error("Some jobs did not run in call to function \"%s\"\n", __FUNCTION__);
+
+                // Error
+                return 0;
+        }
+
+        // Standard library errors
+        {
+            no_mem:
+
+                // Write an error message to standard out
+                log_error("[Standard Library] Failed to allocate memory in call to function \"%s\"\n", __FUNCTION__);
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+int parallel_fork_join_benchmark ( int argc, const char *argv[] )
+{
+
+    // Supress warnings
+    (void) argc;
+    (void) argv;
+
+    // Initialized data
+    const char   *_mode_names[THREAD_POOL_MODE_QUANTITY] = { "shared queue", "work stealing" };
+    const size_t  tree_size = ( (size_t) 1 << ( PARALLEL_BENCHMARK_TREE_DEPTH + 1 ) ) - 1;
+
+    // Formatting
+    log_info("╭─────────────────────╮\n");
+    log_info("│ fork join benchmark │\n");
+    log_info("╰─────────────────────╯\n");
+    log_info("This benchmark runs %d binary trees of %zu jobs on a pool of %d threads.\n", PARALLEL_BENCHMARK_TREE_ROUNDS, tree_size, PARALLEL_BENCHMARK_THREADS);
+    log_info("Each job spawns its children from inside the pool.\n\n");
+
+    // For each mode
+    for (size_t mode = 0; mode < THREAD_POOL_MODE_QUANTITY; mode++)
+    {
+
+        // Initialized data
+        thread_pool_attributes _attributes =
+        {
+            .thread_quantity = PARALLEL_BENCHMARK_THREADS,
+            .mode            = (enum thread_pool_mode_e) mode
+        };
+        timestamp start   = 0,
+                  elapsed = 0;
+
+        // Construct a thread pool
+        if ( thread_pool_construct_with_attributes(&p_tree_pool, &_attributes) == 0 ) goto failed_to_construct_thread_pool;
+
+        // Start the clock
+        start = timer_high_precision();
+
+        // Run each tree
+        for (size_t i = 0; i < PARALLEL_BENCHMARK_TREE_ROUNDS; i++)
+        {
+
+            // Plant the root
+            thread_pool_execute(p_tree_pool, tree_job, (void *) PARALLEL_BENCHMARK_TREE_DEPTH);
+
+            // Wait for the tree to finish
+            thread_pool_wait_idle(p_tree_pool);
+        }
+
+        // Stop the clock
+        elapsed = timer_high_precision() - start;
+
+        // Error check
+        if ( atomic_exchange(&jobs_completed, 0) != tree_size * PARALLEL_BENCHMARK_TREE_ROUNDS ) goto lost_jobs;
+
+        // Print the result
+        log_info("%-16s %10.3f ms, %12.0f jobs/s\n",
+            _mode_names[mode],
+            (double) elapsed * 1000.0 / (double) timer_seconds_divisor(),
+            (double) ( tree_size * PARALLEL_BENCHMARK_TREE_ROUNDS ) * (double) timer_seconds_divisor() / (double) elapsed
+        );
+
+        // Clean up
+        thread_pool_destroy(&p_tree_pool);
+    }
+
+    // Formatting
+    putchar('\n');
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Parallel errors
+        {
+            failed_to_construct_thread_pool:
+
+                // Write an error message to standard out
+                log_error("Failed to construct thread pool in call to function \"%s\"\n", __FUNCTION__);
+
+                // Error
+                return 0;
+
+            lost_jobs:
+
+                // Write an error message to standard out
+                log_error("Some jobs did not run in call to function \"%s\"\n", __FUNCTION__);
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+int parallel_reduce_benchmark ( int argc, const char *argv[] )
+{
+
+    // Supress warnings
+    (void) argc;
+    (void) argv;
+
+    // Formatting
+    log_info("╭──────────────────╮\n");
+    log_info("│ reduce benchmark │\n");
+    log_info("╰──────────────────╯\n");
+    log_info("This benchmark sums %d terms on a pool of %d threads, once into a shared\n", PARALLEL_BENCHMARK_REDUCE_SIZE, PARALLEL_BENCHMARK_THREADS);
+    log_info("accumulator behind a mutex, and once with parallel_reduce.\n\n");
+
+    // Initialized data
+    thread_pool *p_pool   = (void *) 0;
+    double       identity = 0,
+                 result   = 0,
+                 expected = 0;
+    timestamp    start    = 0;
+
+    // Compute the expected sum
+    reduce_sum_body(0, PARALLEL_BENCHMARK_REDUCE_SIZE, &expected, (void *) 0);
+
+    // Construct a thread pool
+    if ( thread_pool_construct(&p_pool, PARALLEL_BENCHMARK_THREADS) == 0 ) goto failed_to_construct_thread_pool;
+
+    // Start the clock
+    start = timer_high_precision();
+
+    // Sum into the shared accumulator
+    if ( parallel_for(p_pool, 0, PARALLEL_BENCHMARK_REDUCE_SIZE, PARALLEL_BENCHMARK_REDUCE_GRAIN, shared_sum_body, (void *) 0) == 0 ) goto failed_to_reduce;
+
+    // Print the result
+    log_info("%-16s %10.3f ms, sum %.0f\n", "shared mutex", (double) ( timer_high_precision() - start ) * 1000.0 / (double) timer_seconds_divisor(), shared_sum);
+
+    // Start the clock
+    start = timer_high_precision();
+
+    // Sum into per worker partials
+    if ( parallel_reduce(p_pool, 0, PARALLEL_BENCHMARK_REDUCE_SIZE, PARALLEL_BENCHMARK_REDUCE_GRAIN, sizeof(double), &identity, reduce_sum_body, reduce_sum_combine, (void *) 0, &result) == 0 ) goto failed_to_reduce;
+
+    // Print the result
+    log_info("%-16s %10.3f ms, sum %.0f\n", "parallel reduce", (double) ( timer_high_precision() - start ) * 1000.0 / (double) timer_seconds_divisor(), result);
+
+    // Error check
+    if ( result != expected ) goto wrong_result;
+
+    // Clean up
+    thread_pool_destroy(&p_pool);
+
+    // Formatting
+    putchar('\n');
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Parallel errors
+        {
+            failed_to_construct_thread_pool:
+
+                // Write an error message to standard out
+                log_error("Failed to construct thread pool in call to function \"%s\"\n", __FUNCTION__);
+
+                // Error
+                return 0;
+
+            failed_to_reduce:
+
+                // Write an error message to standard out
+                log_error("Failed to reduce in call to function \"%s\"\n", __FUNCTION__);
+
+                // Error
+                return 0;
+
+            wrong_result:
+
+                // Write an error message to standard out
+                log_error("Reduced to the wrong sum in call to function \"%s\"\n", __FUNCTION__);
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+int parallel_layout_benchmark ( int argc, const char *argv[] )
+{
+
+    // Supress warnings
+    (void) argc;
+    (void) argv;
+
+    // Formatting
+    log_info("╭──────────────────╮\n");
+    log_info("│ layout benchmark │\n");
+    log_info("╰──────────────────╯\n");
+    log_info("This benchmark runs %d threads that each write their own counter %d times,\n", PARALLEL_BENCHMARK_THREADS, PARALLEL_BENCHMARK_LAYOUT_WRITES);
+    log_info("once with the counters packed together, and once with a cache line each.\n\n");
+
+    // Initialized data
+    static atomic_size_t  _packed[PARALLEL_BENCHMARK_THREADS] = { 0 };
+    static layout_slot    _padded[PARALLEL_BENCHMARK_THREADS] = { 0 };
+    const char           *_layout_names[2]                    = { "packed", "padded" };
+
+    // For each layout
+    for (size_t layout = 0; layout < 2; layout++)
+    {
+
+        // Initialized data
+        parallel_thread *_p_threads[PARALLEL_BENCHMARK_THREADS] = { 0 };
+        timestamp        start   = timer_high_precision(),
+                         elapsed = 0;
+
+        // Start each thread
+        for (size_t i = 0; i < PARALLEL_BENCHMARK_THREADS; i++)
+            if ( parallel_thread_start(&_p_threads[i], layout_job, ( layout == 0 ) ? &_packed[i] : &_padded[i].value) == 0 ) goto failed_to_start_thread;
+
+        // Wait for each thread
+        for (size_t i = 0; i < PARALLEL_BENCHMARK_THREADS; i++) parallel_thread_join(&_p_threads[i]);
+
+        // Stop the clock
+        elapsed = timer_high_precision() - start;
+
+        // Print the result
+        log_info("%-16s %10.3f ms, %10.2f ns/write\n",
+            _layout_names[layout],
+            (double) elapsed * 1000.0 / (double) timer_seconds_divisor(),
+            (double) elapsed * 1000000000.0 / (double) timer_seconds_divisor() / (double) PARALLEL_BENCHMARK_LAYOUT_WRITES
+        );
+    }
+
+    // Formatting
+    putchar('\n');
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Parallel errors
+        {
+            failed_to_start_thread:
+
+                // Write an error message to standard out
+                log_error("Failed to start thread in call to function \"%s\"\n", __FUNCTION__);
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+void *layout_job ( void *p_parameter )
+{
+
+    // Initialized data
+    atomic_size_t *p_value = p_parameter;
+
+    // Write the counter
+    for (size_t i = 0; i < PARALLEL_BENCHMARK_LAYOUT_WRITES; i++) atomic_fetch_add_explicit(p_value, 1, memory_order_relaxed);
+
+    // Done
+    return (void *) 0;
+}
+
+int parallel_latency_benchmark ( int argc, const char *argv[] )
+{
+
+    // Supress warnings
+    (void) argc;
+    (void) argv;
+
+    // Formatting
+    log_info("╭───────────────────╮\n");
+    log_info("│ latency benchmark │\n");
+    log_info("╰───────────────────╯\n");
+    log_info("This benchmark submits %d jobs, one at a time, to an idle pool of %d threads,\n", PARALLEL_BENCHMARK_LATENCY_JOBS, PARALLEL_BENCHMARK_LATENCY_THREADS);
+    log_info("and measures the time from submit until the job starts. Busy polling workers\n");
+    log_info("should run on isolated cores.\n\n");
+
+    // Initialized data
+    timestamp   *p_samples                              = PARALLEL_REALLOC(0, PARALLEL_BENCHMARK_LATENCY_JOBS * sizeof(timestamp));
+    const char  *_wait_names[THREAD_POOL_WAIT_QUANTITY] = { "park", "busy poll" };
+    double       ns_per_tick                            = 1000000000.0 / (double) timer_seconds_divisor();
+
+    // Error check
+    if ( p_samples == (void *) 0 ) goto no_mem;
+
+    // For each wait strategy
+    for (size_t wait = 0; wait < THREAD_POOL_WAIT_QUANTITY; wait++)
+    {
+
+        // Initialized data
+        thread_pool            *p_pool      = (void *) 0;
+        thread_pool_attributes  _attributes =
+        {
+            .thread_quantity = PARALLEL_BENCHMARK_LATENCY_THREADS,
+            .wait            = (enum thread_pool_wait_e) wait
+        };
+
+        // Construct a thread pool
+        if ( thread_pool_construct_with_attributes(&p_pool, &_attributes) == 0 ) goto failed_to_construct_thread_pool;
+
+        // Submit each job to an idle pool
+        for (size_t i = 0; i < PARALLEL_BENCHMARK_LATENCY_JOBS; i++)
+        {
+
+            // Store the submit time
+            p_samples[i] = timer_high_precision();
+
+            // Submit the job
+            thread_pool_execute(p_pool, latency_job, &p_samples[i]);
+
+            // Wait for the job
+            thread_pool_wait_idle(p_pool);
+        }
+
+        // Clean up
+        thread_pool_destroy(&p_pool);
+
+        // Sort the samples
+        qsort(p_samples, PARALLEL_BENCHMARK_LATENCY_JOBS, sizeof(timestamp), timestamp_compare);
+
+        // Print the result
+        log_info("%-16s submit to start p50 %10.0f ns, p99 %10.0f ns, p99.9 %10.0f ns\n",
+            _wait_names[wait],
+            (double) p_samples[PARALLEL_BENCHMARK_LATENCY_JOBS / 2] * ns_per_tick,
+            (double) p_samples[PARALLEL_BENCHMARK_LATENCY_JOBS * 99 / 100] * ns_per_tick,
+            (double) p_samples[PARALLEL_BENCHMARK_LATENCY_JOBS * 999 / 1000] * ns_per_tick
+        );
+    }
+
+    // Clean up
+    PARALLEL_FREE(p_samples);
+
+    // Formatting
+    putchar('\n');
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Parallel errors
+        {
+            failed_to_construct_thread_pool:
+
+                // Write an error message to standard out
+                log_error("Failed to construct thread pool in call to function \"%s\"\n", __FUNCTION__);
+
+                // Error
+                return 0;
+        }
+
+        // Standard library errors
+        {
+            no_mem:
+
+                // Write an error message to standard out
+                log_error("[Standard Library] Failed to allocate memory in call to function \"%s\"\n", __FUNCTION__);
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+void *latency_job ( void *p_parameter )
+{
+
+    // Initialized data
+    timestamp *p_sample = p_parameter;
+
+    // Store the time from submit until now
+    *p_sample = timer_high_precision() - *p_sample;
+
+    // Done
+    return (void *) 0;
+}
+
+int parallel_timer_benchmark ( int argc, const char *argv[] )
+{
+
+    // Supress warnings
+    (void) argc;
+    (void) argv;
+
+    // Formatting
+    log_info("╭─────────────────╮\n");
+    log_info("│ timer benchmark │\n");
+    log_info("╰─────────────────╯\n");
+    log_info("This benchmark schedules %d delayed jobs over %d ms, and measures how late\n", PARALLEL_BENCHMARK_TIMER_JOBS, PARALLEL_BENCHMARK_TIMER_SPREAD);
+    log_info("each one starts. Then it runs a job every %d ms, %d times, and measures how\n", PARALLEL_BENCHMARK_TIMER_PERIOD, PARALLEL_BENCHMARK_TIMER_PERIODS);
+    log_info("far the runs drift from the period.\n\n");
+
+    // Initialized data
+    thread_pool       *p_pool      = (void *) 0;
+    thread_pool_timer *p_timer     = (void *) 0;
+    timestamp         *p_samples   = PARALLEL_REALLOC(0, PARALLEL_BENCHMARK_TIMER_JOBS * sizeof(timestamp));
+    timestamp          divisor     = timer_seconds_divisor(),
+                       worst       = 0;
+    double             ns_per_tick = 1000000000.0 / (double) divisor,
+                       drift       = 0;
+
+    // Error check
+    if ( p_samples == (void *) 0 ) goto no_mem;
+
+    // Construct a thread pool
+    if ( thread_pool_construct(&p_pool, PARALLEL_BENCHMARK_THREADS) == 0 ) goto failed_to_construct_thread_pool;
+
+    // Schedule each delayed job
+    for (size_t i = 0; i < PARALLEL_BENCHMARK_TIMER_JOBS; i++)
+    {
+
+        // Initialized data
+        size_t milliseconds = ( i * 7919 ) % PARALLEL_BENCHMARK_TIMER_SPREAD;
+
+        // Store the due time
+        p_samples[i] = timer_high_precision() + (timestamp) milliseconds * divisor / 1000;
+
+        // Schedule the job
+        if ( thread_pool_execute_after(p_pool, milliseconds, timer_job, &p_samples[i], (void *) 0) == 0 ) goto failed_to_schedule;
+    }
+
+    // Run the periodic job
+    if ( thread_pool_execute_every(p_pool, PARALLEL_BENCHMARK_TIMER_PERIOD, periodic_job, (void *) 0, &p_timer) == 0 ) goto failed_to_schedule;
+
+    // Wait for the last run
+    while ( atomic_load(&periodic_runs) < PARALLEL_BENCHMARK_TIMER_PERIODS ) nanosleep(&(struct timespec) { .tv_nsec = 1000000 }, (void *) 0);
+
+    // Stop the periodic job
+    thread_pool_timer_cancel(&p_timer);
+
+    // Wait for the delayed jobs
+    thread_pool_wait_idle(p_pool);
+
+    // Clean up
+    thread_pool_destroy(&p_pool);
+
+    // Sort the samples
+    qsort(p_samples, PARALLEL_BENCHMARK_TIMER_JOBS, sizeof(timestamp), timestamp_compare);
+
+    // Find the largest error of one period
+    for (size_t i = 1; i < PARALLEL_BENCHMARK_TIMER_PERIODS; i++)
+    {
+
+        // Initialized data
+        double error = (double) ( periodic_samples[i] - periodic_samples[i - 1] ) * ns_per_tick - PARALLEL_BENCHMARK_TIMER_PERIOD * 1000000.0;
+
+        // Keep the largest error
+        if ( error < 0 ) error = -error;
+        if ( error > (double) worst ) worst = (timestamp) error;
+    }
+
+    // Compute the drift of the last run
+    drift = (double) ( periodic_samples[PARALLEL_BENCHMARK_TIMER_PERIODS - 1] - periodic_samples[0] ) * ns_per_tick - ( PARALLEL_BENCHMARK_TIMER_PERIODS - 1 ) * PARALLEL_BENCHMARK_TIMER_PERIOD * 1000000.0;
+
+    // Print the results
+    log_info("%-16s due to start    p50 %10.0f ns, p99 %10.0f ns, max %10.0f ns\n",
+        "delayed",
+        (double) p_samples[PARALLEL_BENCHMARK_TIMER_JOBS / 2] * ns_per_tick,
+        (double) p_samples[PARALLEL_BENCHMARK_TIMER_JOBS * 99 / 100] * ns_per_tick,
+        (double) p_samples[PARALLEL_BENCHMARK_TIMER_JOBS - 1] * ns_per_tick
+    );
+    log_info("%-16s worst period error %10.0f ns, drift after %d runs %10.0f ns\n", "periodic", (double) worst, PARALLEL_BENCHMARK_TIMER_PERIODS, drift);
+
+    // Clean up
+    PARALLEL_FREE(p_samples);
+
+    // Formatting
+    putchar('\n');
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Parallel errors
+        {
+            failed_to_construct_thread_pool:
+
+                // Write an error message to standard out
+                log_error("Failed to construct thread pool in call to function \"%s\"\n", __FUNCTION__);
+
+                // Error
+                return 0;
+
+            failed_to_schedule:
+
+                // Write an error message to standard out
+                log_error("Failed to schedule job in call to function \"%s\"\n", __FUNCTION__);
+
+                // Error
+                return 0;
+        }
+
+        // Standard library errors
+        {
+            no_mem:
+
+                // Write an error message to standard out
+                log_error("[Standard Library] Failed to allocate memory in call to function \"%s\"\n", __FUNCTION__);
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+void *timer_job ( void *p_parameter )
+{
+
+    // Initialized data
+    timestamp *p_sample = p_parameter;
+    timestamp  now      = timer_high_precision();
+
+    // Store the time from the due time until now
+    *p_sample = ( now > *p_sample ) ? now - *p_sample : 0;
+
+    // Done
+    return (void *) 0;
+}
+
+void *periodic_job ( void *p_parameter )
+{
+
+    // Initialized data
+    size_t run = atomic_fetch_add(&periodic_runs, 1);
+
+    // Supress warnings
+    (void) p_parameter;
+
+    // Store the time of the run
+    if ( run < PARALLEL_BENCHMARK_TIMER_PERIODS ) periodic_samples[run] = timer_high_precision();
+
+    // Done
+    return (void *) 0;
+}
+
+int parallel_schedule_benchmark ( int argc, const char *argv[] )
+{
+
+    // Supress warnings
+    (void) argc;
+    (void) argv;
+
+    // Formatting
+    log_info("╭────────────────────╮\n");
+    log_info("│ schedule benchmark │\n");
+    log_info("╰────────────────────╯\n");
+    log_info("This benchmark repeats a schedule of %d empty tasks on %d threads. Each task\n", PARALLEL_BENCHMARK_SCHEDULE_THREADS * PARALLEL_BENCHMARK_SCHEDULE_TASKS, PARALLEL_BENCHMARK_SCHEDULE_THREADS);
+    log_info("after the first thread waits on the same task of the thread before it, so one\n");
+    log_info("iteration is almost all dependency overhead. It runs the schedule on a thread\n");
+    log_info("per named thread, then on a thread pool of as many threads, first one\n");
+    log_info("iteration at a time, then with %d iterations in flight.\n\n", PARALLEL_BENCHMARK_SCHEDULE_PIPELINE);
+
+    // Initialized data
+    size_t      size        = 128 * 1024,
+                written     = 0,
+                iterations  = 0;
+    char       *p_text      = PARALLEL_REALLOC(0, size);
+    json_value  *p_value    = (void *) 0;
+    schedule    *p_schedule = (void *) 0;
+    thread_pool *p_pool     = (void *) 0;
+    timestamp   divisor     = timer_seconds_divisor(),
+                start       = 0,
+                elapsed     = 0;
+    double      ns_per_iteration = 0;
+
+    // Error check
+    if ( p_text == (void *) 0 ) goto no_mem;
+
+    // Register a task for each position in a thread
+    for (size_t i = 0; i < PARALLEL_BENCHMARK_SCHEDULE_TASKS; i++)
+    {
+
+        // Name the task
+        snprintf(schedule_task_names[i], sizeof(schedule_task_names[i]), "step %zu", i);
+
+        // Register the task
+        parallel_register_task(schedule_task_names[i], schedule_step);
+    }
+
+    // Register the last task
+    parallel_register_task("tick", schedule_tick);
+
+    // Construct a thread pool
+    if ( thread_pool_construct(&p_pool, PARALLEL_BENCHMARK_SCHEDULE_THREADS) == 0 ) goto failed_to_construct_thread_pool;
+
+    // Run the schedule on dedicated threads, then on the thread pool, one iteration at a time, then pipelined
+    for (size_t mode = 0; mode < 4; mode++)
+    {
+
+        // Start the schedule from the beginning of the buffer
+        written = 0;
+
+        // Write the schedule
+        written += snprintf(p_text + written, size - written, "{\"name\":\"benchmark\",\"repeat\":true,\"pipeline\":%d,\"threads\":{", ( mode & 2 ) ? PARALLEL_BENCHMARK_SCHEDULE_PIPELINE : 1);
+
+        // Write each thread
+        for (size_t i = 0; i < PARALLEL_BENCHMARK_SCHEDULE_THREADS; i++)
+        {
+
+            // Write the name of the thread
+            written += snprintf(p_text + written, size - written, "%s\"thread %zu\":[", ( i ) ? "," : "", i);
+
+            // Write each task
+            for (size_t j = 0; j < PARALLEL_BENCHMARK_SCHEDULE_TASKS; j++)
+
+                // The first thread waits on nothing, and each other thread waits on the thread before it
+                if ( i == 0 ) written += snprintf(p_text + written, size - written, "%s{\"task\":\"step %zu\"}", ( j ) ? "," : "", j);
+                else          written += snprintf(p_text + written, size - written, "%s{\"task\":\"step %zu\",\"wait\":\"thread %zu:step %zu\"}", ( j ) ? "," : "", j, i - 1, j);
+
+            // The last thread counts the iteration
+            if ( i == PARALLEL_BENCHMARK_SCHEDULE_THREADS - 1 ) written += snprintf(p_text + written, size - written, ",{\"task\":\"tick\"}");
+
+            // Close the thread
+            written += snprintf(p_text + written, size - written, "]");
+        }
+
+        // Close the schedule
+        written += snprintf(p_text + written, size - written, "}}");
+
+        // Error check
+        if ( written >= size ) goto no_mem;
+
+        // Parse the schedule
+        if ( json_value_parse(p_text, 0, &p_value) == 0 ) goto failed_to_parse_schedule;
+
+        // Construct the schedule
+        if ( schedule_load_as_json_value(&p_schedule, p_value) == 0 ) goto failed_to_load_schedule;
+
+        // Store the iterations so far
+        iterations = atomic_load(&schedule_iterations);
+
+        // Start the schedule
+        if ( ( mode & 1 ) == 0 && schedule_start(p_schedule, (void *) 0) == 0 ) goto failed_to_start_schedule;
+        if ( ( mode & 1 ) == 1 && schedule_start_on_thread_pool(p_schedule, p_pool, (void *) 0) == 0 ) goto failed_to_start_schedule;
+
+        // Wait for the first iteration
+        while ( atomic_load(&schedule_iterations) == iterations ) nanosleep(&(struct timespec) { .tv_nsec = 1000000 }, (void *) 0);
+
+        // Count the iterations over the window
+        iterations = atomic_load(&schedule_iterations);
+        start      = timer_high_precision();
+        nanosleep(&(struct timespec) { .tv_sec = PARALLEL_BENCHMARK_SCHEDULE_MILLISECONDS / 1000, .tv_nsec = ( PARALLEL_BENCHMARK_SCHEDULE_MILLISECONDS % 1000 ) * 1000000 }, (void *) 0);
+        iterations = atomic_load(&schedule_iterations) - iterations;
+        elapsed    = timer_high_precision() - start;
+
+        // Finish the last iteration
+        schedule_pause(p_schedule);
+        schedule_wait_idle(p_schedule);
+
+        // Clean up
+        schedule_stop(p_schedule);
+        schedule_destroy(&p_schedule);
+
+        // Compute the time of one iteration
+        ns_per_iteration = (double) elapsed * ( 1000000000.0 / (double) divisor ) / (double) ( iterations ? iterations : 1 );
+
+        // Print the results
+        log_info("%-16s %-12s %10zu iterations, %12.0f ns per iteration, %8.1f ns per task\n", ( mode & 1 ) ? "thread pool" : "threads", ( mode & 2 ) ? "pipelined" : "in order", iterations, ns_per_iteration, ns_per_iteration / ( PARALLEL_BENCHMARK_SCHEDULE_THREADS * PARALLEL_BENCHMARK_SCHEDULE_TASKS ));
+    }
+
+    // Clean up
+    thread_pool_destroy(&p_pool);
+    PARALLEL_FREE(p_text);
+
+    // Formatting
+    putchar('\n');
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Parallel errors
+        {
+            failed_to_construct_thread_pool:
+
+                // Write an error message to standard out
+                log_error("Failed to construct thread pool in call to function \"%s\"\n", __FUNCTION__);
+
+                // Error
+                return 0;
+
+            failed_to_load_schedule:
+
+                // Write an error message to standard out
+                log_error("Failed to load schedule in call to function \"%s\"\n", __FUNCTION__);
+
+                // Error
+                return 0;
+
+            failed_to_start_schedule:
+
+                // Write an error message to standard out
+                log_error("Failed to start schedule in call to function \"%s\"\n", __FUNCTION__);
+
+                // Error
+                return 0;
+        }
+
+        // JSON errors
+        {
+            failed_to_parse_schedule:
+
+                // Write an error message to standard out
+                log_error("Failed to parse schedule in call to function \"%s\"\n", __FUNCTION__);
+
+                // Error
+                return 0;
+        }
+
+        // Standard library errors
+        {
+            no_mem:
+
+                // Write an error message to standard out
+                log_error("[Standard Library] Failed to allocate memory in call to function \"%s\"\n", __FUNCTION__);
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+void *schedule_step ( void *p_parameter )
+{
+
+    // Supress warnings
+    (void) p_parameter;
+
+    // Done
+    return (void *) 0;
+}
+
+void *schedule_tick ( void *p_parameter )
+{
+
+    // Supress warnings
+    (void) p_parameter;
+
+    // Count the iteration
+    atomic_fetch_add_explicit(&schedule_iterations, 1, memory_order_relaxed);
+
+    // Done
+    return (void *) 0;
+}
+
+void shared_sum_body ( size_t begin, size_t end, void *p_context )
+{
+
+    // Supress warnings
+    (void) p_context;
+
+    // Add each term
+    for (size_t i = begin; i < end; i++)
+    {
+
+        // Lock
+        pthread_mutex_lock(&shared_sum_lock);
+
+        // Add the term
+        shared_sum += (double) ( i & 1023 );
+
+        // Unlock
+        pthread_mutex_unlock(&shared_sum_lock);
+    }
+
+    // Done
+    return;
+}
+
+void reduce_sum_body ( size_t begin, size_t end, void *p_partial, void *p_context )
+{
+
+    // Initialized data
+    double *p_sum = p_partial;
+
+    // Supress warnings
+    (void) p_context;
+
+    // Add each term
+    for (size_t i = begin; i < end; i++) *p_sum += (double) ( i & 1023 );
+
+    // Done
+    return;
+}
+
+void reduce_sum_combine ( void *p_partial, const void *p_other, void *p_context )
+{
+
+    // Supress warnings
+    (void) p_context;
+
+    // Add the other partial
+    *(double *) p_partial += *(const double *) p_other;
+
+    // Done
+    return;
+}
+
+void *tree_job ( void *p_parameter )
+{
+
+    // Initialized data
+    size_t depth = (size_t) p_parameter;
+
+    // Do a little work
+    tiny_job((void *) 0);
+
+    // Spawn the children
+    if ( depth )
+    {
+        thread_pool_execute(p_tree_pool, tree_job, (void *) ( depth - 1 ));
+        thread_pool_execute(p_tree_pool, tree_job, (void *) ( depth - 1 ));
+    }
+
+    // Done
+    return 0;
+}
+
+void *tiny_job ( void *p_parameter )
+{
+
+    // Unused
+    (void) p_parameter;
+
+    // Initialized data
+    volatile size_t spin = 0;
+
+    // Do a little work
+    for (size_t i = 0; i < PARALLEL_BENCHMARK_JOB_SPIN; i++) spin++;
+
+    // Count the job
+    atomic_fetch_add_explicit(&jobs_completed, 1, memory_order_relaxed);
+
+    // Done
+    return 0;
+}
+
+static int timestamp_compare ( const void *p_a, const void *p_b )
+{
+
+    // Initialized data
+    timestamp a = *(const timestamp *) p_a,
+              b = *(const timestamp *) p_b;
+
+    // Done
+    return ( a > b ) - ( a < b );
+}
+
+void parallel_benchmark_summarize ( timestamp *p_samples, size_t quantity, timestamp elapsed, parallel_benchmark_result *p_result )
+{
+
+    // Initialized data
+    double    ns_per_tick = 1000000000.0 / (double) timer_seconds_divisor();
+    timestamp sum         = 0;
+
+    // Sort the samples
+    qsort(p_samples, quantity, sizeof(timestamp), timestamp_compare);
+
+    // Sum the samples
+    for (size_t i = 0; i < quantity; i++) sum += p_samples[i];
+
+    // Store the result
+    *p_result = (parallel_benchmark_result)
+    {
+        .submit_mean_ns  = (double) sum / (double) quantity * ns_per_tick,
+        .submit_p50_ns   = (double) p_samples[quantity / 2] * ns_per_tick,
+        .submit_p99_ns   = (double) p_samples[quantity * 99 / 100] * ns_per_tick,
+        .submit_max_ns   = (double) p_samples[quantity - 1] * ns_per_tick,
+        .jobs_per_second = (double) quantity / ( (double) elapsed * ns_per_tick / 1000000000.0 )
+    };
+
+    // Done
+    return;
+}
+
+void parallel_benchmark_print ( const char *name, const parallel_benchmark_result *p_result )
+{
+
+    // Print the result
+    log_info("%-16s submit mean %10.0f ns, p50 %10.0f ns, p99 %10.0f ns, max %10.0f ns, %12.0f jobs/s\n",
+        name,
+        p_result->submit_mean_ns,
+        p_result->submit_p50_ns,
+        p_result->submit_p99_ns,
+        p_result->submit_max_ns,
+        p_result->jobs_per_second
+    );
+
+    // Done
+    return;
+}
+
+int scan_pool_construct ( scan_pool *p_scan_pool, size_t thread_quantity )
+{
+
+    // Initialize the pool
+    memset(p_scan_pool, 0, sizeof(scan_pool));
+    mutex_create(&p_scan_pool->_lock);
+    p_scan_pool->thread_quantity = thread_quantity;
+
+    // Start each worker
+    for (size_t i = 0; i < thread_quantity; i++)
+    {
+
+        // Initialized data
+        scan_pool_thread *p_thread = &p_scan_pool->_threads[i];
+
+        // Initialize the worker
+        p_thread->p_scan_pool = p_scan_pool;
+        pthread_mutex_init(&p_thread->_lock, NULL);
+        pthread_cond_init(&p_thread->_signal, NULL);
+
+        // Start the worker
+        if ( parallel_thread_start(&p_thread->p_parallel_thread, (fn_parallel_task *) scan_pool_work, p_thread) == 0 ) return 0;
+    }
+
+    // Success
+    return 1;
+}
+
+int scan_pool_execute ( scan_pool *p_scan_pool, fn_parallel_task *pfn_parallel_task, void *p_parameter )
+{
+
+    // Initialized data
+    size_t i = 0;
+
+    try_again:
+
+    // Lock
+    mutex_lock(&p_scan_pool->_lock);
+
+    // Defer to other threads
+    sleep(0);
+
+    // Find an idle thread
+    for (i = 0; i < p_scan_pool->thread_quantity; i++)
+        if ( atomic_load(&p_scan_pool->_threads[i].running) == false ) goto found_thread;
+
+    // Unlock
+    mutex_unlock(&p_scan_pool->_lock);
+
+    // Defer to other threads
+    sleep(0);
+
+    // Find the idle thread
+    goto try_again;
+
+    found_thread:
+    {
+
+        // Initialized data
+        scan_pool_thread *p_thread = &p_scan_pool->_threads[i];
+
+        // Set up the task
+        atomic_store(&p_thread->running, true);
+        pthread_mutex_lock(&p_thread->_lock);
+        p_thread->pfn_parallel_task = pfn_parallel_task;
+        p_thread->p_parameter       = p_parameter;
+        p_thread->pending           = true;
+
+        // Signal the thread
+        pthread_cond_signal(&p_thread->_signal);
+        pthread_mutex_unlock(&p_thread->_lock);
+    }
+
+    // Unlock
+    mutex_unlock(&p_scan_pool->_lock);
+
+    // Success
+    return 1;
+}
+
+int scan_pool_wait_idle ( scan_pool *p_scan_pool )
+{
+
+    // Initialized data
+    bool is_running = true;
+
+    // Until the pool is idle
+    while ( is_running )
+    {
+
+        // Clear the flag
+        is_running = false;
+
+        // If any thread is running, set the flag
+        for (size_t i = 0; i < p_scan_pool->thread_quantity; i++)
+            is_running |= atomic_load(&p_scan_pool->_threads[i].running);
+
+        // Defer to other threads
+        sleep(0);
+    }
+
+    // Success
+    return 1;
+}
+
+void *scan_pool_work ( scan_pool_thread *p_thread )
+{
+
+    // Forever
+    for (;;)
+    {
+
+        // Wait for a task to be assigned
+        pthread_mutex_lock(&p_thread->_lock);
+        while ( p_thread->pending == false ) pthread_cond_wait(&p_thread->_signal, &p_thread->_lock);
+        p_thread->pending = false;
+        pthread_mutex_unlock(&p_thread->_lock);
+
+        // Run the user's task
+        p_thread->pfn_parallel_task(p_thread->p_parameter);
+
+        // Defer to other threads
+        sleep(0);
+
+        // Clear the running flag
+        atomic_store(&p_thread->running, false);
+    }
+
+    // Done
+    return (void *) 0;
+}
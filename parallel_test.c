@@ -0,0 +1,1542 @@
+/** !
+ * Tests for the parallel library
+ *
+ * @file parallel_test.c
+ *
+ * @author Jacob Smith
+ */
+
+// Standard library
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <stdatomic.h>
+#include <errno.h>
+#include <time.h>
+#include <pthread.h>
+
+// log
+#include <log/log.h>
+
+// parallel
+#include <parallel/parallel.h>
+#include <parallel/thread.h>
+#include <parallel/thread_pool.h>
+#include <parallel/schedule.h>
+
+// Preprocessor definitions
+#define PARALLEL_TEST_THREADS               4
+#define PARALLEL_TEST_TIMEOUT               10000 // milliseconds
+#define PARALLEL_TEST_STEAL_ROUNDS          20000 // per thread
+#define PARALLEL_TEST_IDLE_JOBS             1000
+#define PARALLEL_TEST_BATCH_JOBS            1000
+#define PARALLEL_TEST_FOR_INDICES           100000
+#define PARALLEL_TEST_FOR_GRAIN             64
+#define PARALLEL_TEST_REDUCE_INDICES        1000000
+#define PARALLEL_TEST_REDUCE_GRAIN          1024
+#define PARALLEL_TEST_ELASTIC_THREADS       4
+#define PARALLEL_TEST_ELASTIC_MILLISECONDS  20
+#define PARALLEL_TEST_PRIORITY_JOBS         3 // per priority
+#define PARALLEL_TEST_PARK_ROUNDS           20000
+#define PARALLEL_TEST_BUSY_POLL_ROUNDS      1000
+#define PARALLEL_TEST_INLINE_JOBS           4096
+#define PARALLEL_TEST_INLINE_DESCRIPTORS    4
+#define PARALLEL_TEST_GROUP_JOBS            64
+#define PARALLEL_TEST_NESTED_INDICES        4096
+#define PARALLEL_TEST_WHEN_ALL_FUTURES      8
+#define PARALLEL_TEST_TIMER_PERIOD          5 // milliseconds
+#define PARALLEL_TEST_QUEUE_LENGTH          2
+#define PARALLEL_TEST_OVERFLOW_MILLISECONDS 20
+#define PARALLEL_TEST_STATS_JOBS            1000
+#define PARALLEL_TEST_SCHEDULE_MILLISECONDS 200
+#define PARALLEL_TEST_SCHEDULE_PIPELINE     4
+
+// Structure definitions
+struct inline_parameter_s
+{
+    size_t index;
+    size_t check;     // the complement of the index
+    char   _text[40]; // the index, as text
+};
+
+// Type definitions
+typedef struct inline_parameter_s inline_parameter;
+
+// Data
+static size_t          total_tests  = 0,
+                       total_passes = 0;
+static thread_pool    *p_test_pool  = (void *) 0;
+static atomic_size_t   steal_runs[PARALLEL_TEST_THREADS][PARALLEL_TEST_STEAL_ROUNDS] = { 0 };
+static atomic_size_t   steal_errors = 0;
+static atomic_size_t   gate_started = 0;
+static atomic_bool     gate_open    = false;
+static atomic_size_t   idle_runs    = 0;
+static atomic_size_t   batch_runs[PARALLEL_TEST_BATCH_JOBS] = { 0 };
+static atomic_size_t   for_hits[PARALLEL_TEST_FOR_INDICES] = { 0 };
+static atomic_size_t   for_pieces = 0;
+static size_t          priority_order[THREAD_POOL_PRIORITY_QUANTITY * PARALLEL_TEST_PRIORITY_JOBS] = { 0 };
+static atomic_size_t   priority_next = 0;
+static atomic_size_t   park_runs    = 0;
+static atomic_size_t   inline_sum       = 0,
+                       inline_destroyed = 0,
+                       inline_errors    = 0;
+static atomic_size_t   group_runs   = 0;
+static atomic_size_t   nested_indices = 0;
+static atomic_size_t   timer_runs   = 0;
+static atomic_size_t   overflow_runs = 0;
+static pthread_t       overflow_caller;
+static atomic_size_t   stats_runs   = 0;
+static atomic_size_t   schedule_sequence = 0;
+static size_t          schedule_order[3] = { 0 };
+static atomic_size_t   schedule_a = 0,
+                       schedule_b = 0,
+                       schedule_c = 0,
+                       schedule_violations = 0;
+static size_t          schedule_window = 0;
+
+// Forward declarations
+/** !
+ * Print the result of a test, and count it
+ *
+ * @param name   the name of the test
+ * @param passed true if the test passed, else false
+ *
+ * @return void
+ */
+void parallel_test_report ( const char *name, bool passed );
+
+/** !
+ * Sleep for a quantity of milliseconds
+ *
+ * @param milliseconds the quantity of milliseconds
+ *
+ * @return void
+ */
+void parallel_test_sleep ( size_t milliseconds );
+
+/** !
+ * Close the gate that gate_job waits on, and forget the jobs that started
+ *
+ * @return void
+ */
+void parallel_test_gate_close ( void );
+
+/** !
+ * Wait until a quantity of gate jobs have started
+ *
+ * @param quantity the quantity of gate jobs
+ *
+ * @return true if they started, false on timeout
+ */
+bool parallel_test_gate_wait ( size_t quantity );
+
+/** !
+ * Each worker of a work stealing thread pool pushes one job at a time onto its
+ * own deque, then pops it while idle workers try to steal it. Every job must
+ * run exactly once
+ *
+ * @return true if the test passed, else false
+ */
+bool test_steal_last_job ( void );
+
+/** !
+ * Wait for a thread pool to finish a set of jobs, then time out waiting for a
+ * job that can't finish yet
+ *
+ * @return true if the test passed, else false
+ */
+bool test_wait_idle ( void );
+
+/** !
+ * Execute a batch of jobs. Each job must run exactly once, with its own
+ * parameter
+ *
+ * @return true if the test passed, else false
+ */
+bool test_execute_batch ( void );
+
+/** !
+ * Run a loop over a range while an unrelated job keeps a worker busy. Each
+ * index must be visited exactly once, and the loop must not wait for the
+ * unrelated job
+ *
+ * @return true if the test passed, else false
+ */
+bool test_parallel_for ( void );
+
+/** !
+ * Sum a range with a parallel reduction, and reduce an empty range to the
+ * identity
+ *
+ * @return true if the test passed, else false
+ */
+bool test_parallel_reduce ( void );
+
+/** !
+ * Grow an elastic thread pool to its maximum while every worker is busy, then
+ * let the idle workers retire
+ *
+ * @return true if the test passed, else false
+ */
+bool test_elastic ( void );
+
+/** !
+ * Queue jobs of each priority, lowest first, behind a busy worker. The worker
+ * must run them highest priority first
+ *
+ * @return true if the test passed, else false
+ */
+bool test_priority ( void );
+
+/** !
+ * Submit jobs one at a time to workers that park right away. A lost wakeup
+ * leaves a job in the queue, and its future times out
+ *
+ * @return true if the test passed, else false
+ */
+bool test_park_wakeup ( void );
+
+/** !
+ * Run jobs one at a time on a busy polling thread pool, and check that a busy
+ * polling thread pool can't be elastic
+ *
+ * @return true if the test passed, else false
+ */
+bool test_busy_poll ( void );
+
+/** !
+ * Execute more jobs with inline parameters than there are descriptors. Each
+ * job must see its own copy of its parameter, and each copy must be destroyed
+ *
+ * @return true if the test passed, else false
+ */
+bool test_execute_inline ( void );
+
+/** !
+ * Wait on a task group while an unrelated job keeps the only worker busy. The
+ * caller must run the group's jobs itself, including the jobs they execute
+ *
+ * @return true if the test passed, else false
+ */
+bool test_group_wait ( void );
+
+/** !
+ * On a thread pool with one thread, a job waits on a task group, on a future,
+ * and on a parallel loop, from inside the worker. Each wait must finish
+ *
+ * @return true if the test passed, else false
+ */
+bool test_nested_waits ( void );
+
+/** !
+ * Check the results of thread_pool_future_then and thread_pool_when_all, and
+ * that thread_pool_when_all rejects a future that appears twice
+ *
+ * @return true if the test passed, else false
+ */
+bool test_continuations ( void );
+
+/** !
+ * Cancel a periodic timer, and a one shot timer before it fires
+ *
+ * @return true if the test passed, else false
+ */
+bool test_timer_cancel ( void );
+
+/** !
+ * Destroy a thread pool while handles to a periodic timer, and to a one shot 
+ * timer that has fired, are held, then cancel both
+ *
+ * @return true if the test passed, else false
+ */
+bool test_timer_outlives_pool ( void );
+
+/** !
+ * Fill the queue of a thread pool whose only worker is busy, then submit one
+ * more job under an overflow policy
+ *
+ * @param overflow the overflow policy
+ *
+ * @return true if the test passed, else false
+ */
+bool test_overflow ( enum thread_pool_overflow_e overflow );
+
+/** !
+ * Run a set of jobs, then check that the statistics count each of them
+ *
+ * @return true if the test passed, else false
+ */
+bool test_stats ( void );
+
+/** !
+ * Run a schedule on a thread pool, twice. A task must run after the task
+ * before it in its thread, and after each task it waits on
+ *
+ * @return true if the test passed, else false
+ */
+bool test_schedule_graph ( void );
+
+/** !
+ * Repeat a schedule where one task waits on two tasks of other threads. The
+ * task must never run before both of its inputs for the same iteration, no
+ * thread may run more than a window of iterations ahead, and a schedule with a
+ * window must pause every thread at the same iteration
+ *
+ * @param pool     true to run on a thread pool, false to run on dedicated threads
+ * @param pipeline the most iterations in flight at once, or 0 to leave it unset
+ *
+ * @return true if the test passed, else false
+ */
+bool test_schedule_waits ( bool pool, size_t pipeline );
+
+// Jobs
+void *steal_root ( void *p_parameter );
+void *count_job ( void *p_parameter );
+void *gate_job ( void *p_parameter );
+void  for_body ( size_t begin, size_t end, void *p_context );
+void  reduce_sum ( size_t begin, size_t end, void *p_partial, void *p_context );
+void  combine_sum ( void *p_partial, const void *p_other, void *p_context );
+void *priority_job ( void *p_parameter );
+void *identity_job ( void *p_parameter );
+void *inline_job ( void *p_parameter );
+void  inline_destructor ( void *p_parameter );
+void *group_child ( void *p_parameter );
+void *nested_root ( void *p_parameter );
+void  nested_for_body ( size_t begin, size_t end, void *p_context );
+void *twice_job ( void *p_parameter );
+void *overflow_job ( void *p_parameter );
+void *schedule_task_first ( void *p_parameter );
+void *schedule_task_second ( void *p_parameter );
+void *schedule_task_third ( void *p_parameter );
+void *schedule_task_a ( void *p_parameter );
+void *schedule_task_b ( void *p_parameter );
+void *schedule_task_c ( void *p_parameter );
+
+// Entry point
+int main ( int argc, const char *argv[] )
+{
+
+    // Supress warnings
+    (void) argc;
+    (void) argv;
+
+    // Formatting
+    log_info("╭───────────────╮\n");
+    log_info("│ parallel test │\n");
+    log_info("╰───────────────╯\n\n");
+
+    // Run each test
+    parallel_test_report("work stealing: an owner pop racing a steal runs each job once", test_steal_last_job());
+    parallel_test_report("wait idle: wait for every job, and time out", test_wait_idle());
+    parallel_test_report("batch: each job of a batch runs once", test_execute_batch());
+    parallel_test_report("parallel for: each index once, without waiting on other jobs", test_parallel_for());
+    parallel_test_report("parallel reduce: sum a range", test_parallel_reduce());
+    parallel_test_report("elastic: grow to the maximum, then retire idle workers", test_elastic());
+    parallel_test_report("priority: higher priorities run first", test_priority());
+    parallel_test_report("park: no wakeup is lost between a park and a submit", test_park_wakeup());
+    parallel_test_report("busy poll: run each job, and refuse to be elastic", test_busy_poll());
+    parallel_test_report("inline: copy each parameter, and recycle descriptors", test_execute_inline());
+    parallel_test_report("groups: wait on a group, without waiting on other jobs", test_group_wait());
+    parallel_test_report("nested: waits inside the only worker finish", test_nested_waits());
+    parallel_test_report("futures: then and when all", test_continuations());
+    parallel_test_report("timers: cancel a periodic timer, and a one shot timer", test_timer_cancel());
+    parallel_test_report("timers: cancel a handle after the thread pool is destroyed", test_timer_outlives_pool());
+    parallel_test_report("overflow: reject", test_overflow(THREAD_POOL_OVERFLOW_REJECT));
+    parallel_test_report("overflow: block with a timeout", test_overflow(THREAD_POOL_OVERFLOW_BLOCK));
+    parallel_test_report("overflow: caller runs", test_overflow(THREAD_POOL_OVERFLOW_CALLER_RUNS));
+    parallel_test_report("statistics: count each job", test_stats());
+    parallel_test_report("schedule: run a task graph on a thread pool", test_schedule_graph());
+    parallel_test_report("schedule: wait on several tasks, on threads", test_schedule_waits(false, 0));
+    parallel_test_report("schedule: wait on several tasks, on a thread pool", test_schedule_waits(true, 0));
+    parallel_test_report("schedule: threads, in order", test_schedule_waits(false, 1));
+    parallel_test_report("schedule: threads, pipelined", test_schedule_waits(false, PARALLEL_TEST_SCHEDULE_PIPELINE));
+    parallel_test_report("schedule: thread pool, in order", test_schedule_waits(true, 1));
+    parallel_test_report("schedule: thread pool, pipelined", test_schedule_waits(true, PARALLEL_TEST_SCHEDULE_PIPELINE));
+
+    // Print the summary
+    log_info("\n%zu of %zu tests passed\n", total_passes, total_tests);
+
+    // Done
+    return ( total_passes == total_tests ) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+void parallel_test_report ( const char *name, bool passed )
+{
+
+    // Print the result
+    if ( passed ) log_pass("[pass] %s\n", name);
+    else          log_fail("[fail] %s\n", name);
+
+    // Count the test
+    total_tests++;
+    total_passes += passed;
+
+    // Done
+    return;
+}
+
+void parallel_test_sleep ( size_t milliseconds )
+{
+
+    // Sleep
+    nanosleep(&(struct timespec) { .tv_sec = (time_t) ( milliseconds / 1000 ), .tv_nsec = (long) ( milliseconds % 1000 ) * 1000000 }, (void *) 0);
+
+    // Done
+    return;
+}
+
+void parallel_test_gate_close ( void )
+{
+
+    // Close the gate
+    atomic_store(&gate_open, false);
+    atomic_store(&gate_started, 0);
+
+    // Done
+    return;
+}
+
+bool parallel_test_gate_wait ( size_t quantity )
+{
+
+    // Wait for the jobs to start
+    for (size_t i = 0; i < PARALLEL_TEST_TIMEOUT; i++)
+    {
+
+        // Started?
+        if ( atomic_load(&gate_started) >= quantity ) return true;
+
+        // Wait
+        parallel_test_sleep(1);
+    }
+
+    // Error
+    return false;
+}
+
+bool test_steal_last_job ( void )
+{
+
+    // Initialized data
+    thread_pool_attributes _attributes = { .thread_quantity = PARALLEL_TEST_THREADS, .mode = THREAD_POOL_MODE_WORK_STEALING };
+    thread_pool_future    *_p_roots[PARALLEL_TEST_THREADS] = { 0 };
+    bool                   passed = true;
+
+    // Construct a thread pool
+    if ( thread_pool_construct_with_attributes(&p_test_pool, &_attributes) == 0 ) return false;
+
+    // Start a root job for each worker
+    for (size_t i = 0; i < PARALLEL_TEST_THREADS; i++)
+        if ( thread_pool_execute_future(p_test_pool, steal_root, (void *) i, &_p_roots[i]) == 0 ) return false;
+
+    // Wait for each root job. A stuck thread pool can't be destroyed
+    for (size_t i = 0; i < PARALLEL_TEST_THREADS; i++)
+        if ( thread_pool_future_get_timeout(_p_roots[i], PARALLEL_TEST_TIMEOUT * 6, (void *) 0) == 0 ) return false;
+
+    // Each job must run exactly once
+    for (size_t i = 0; i < PARALLEL_TEST_THREADS; i++)
+        for (size_t j = 0; j < PARALLEL_TEST_STEAL_ROUNDS; j++)
+            if ( atomic_load(&steal_runs[i][j]) != 1 ) passed = false;
+
+    // Clean up
+    for (size_t i = 0; i < PARALLEL_TEST_THREADS; i++)
+        thread_pool_future_destroy(&_p_roots[i]);
+    thread_pool_destroy(&p_test_pool);
+
+    // Done
+    return passed && atomic_load(&steal_errors) == 0;
+}
+
+bool test_wait_idle ( void )
+{
+
+    // Initialized data
+    bool passed = true;
+
+    // Construct a thread pool
+    if ( thread_pool_construct(&p_test_pool, PARALLEL_TEST_THREADS) == 0 ) return false;
+
+    // Wait for a set of jobs
+    for (size_t i = 0; i < PARALLEL_TEST_IDLE_JOBS; i++)
+        if ( thread_pool_execute(p_test_pool, count_job, &idle_runs) == 0 ) return false;
+    if ( thread_pool_wait_idle(p_test_pool) == 0 ) passed = false;
+
+    // Every job is done
+    if ( atomic_load(&idle_runs) != PARALLEL_TEST_IDLE_JOBS ) passed = false;
+    if ( thread_pool_is_idle(p_test_pool) == false ) passed = false;
+
+    // Keep a worker busy
+    parallel_test_gate_close();
+    if ( thread_pool_execute(p_test_pool, gate_job, (void *) 0) == 0 ) return false;
+    if ( parallel_test_gate_wait(1) == false ) passed = false;
+
+    // The wait times out while the job runs
+    if ( thread_pool_wait_idle_timeout(p_test_pool, 20) ) passed = false;
+    if ( thread_pool_is_idle(p_test_pool) ) passed = false;
+
+    // Let the worker go
+    atomic_store(&gate_open, true);
+    if ( thread_pool_wait_idle_timeout(p_test_pool, PARALLEL_TEST_TIMEOUT) == 0 ) return false;
+
+    // Clean up
+    thread_pool_destroy(&p_test_pool);
+
+    // Done
+    return passed;
+}
+
+bool test_execute_batch ( void )
+{
+
+    // Initialized data
+    void *_p_parameters[PARALLEL_TEST_BATCH_JOBS] = { 0 };
+    bool  passed = true;
+
+    // Construct a thread pool
+    if ( thread_pool_construct(&p_test_pool, PARALLEL_TEST_THREADS) == 0 ) return false;
+
+    // Give each job its own counter
+    for (size_t i = 0; i < PARALLEL_TEST_BATCH_JOBS; i++)
+        _p_parameters[i] = &batch_runs[i];
+
+    // Execute the batch
+    if ( thread_pool_execute_batch(p_test_pool, count_job, _p_parameters, PARALLEL_TEST_BATCH_JOBS) == 0 ) return false;
+    if ( thread_pool_wait_idle(p_test_pool) == 0 ) return false;
+
+    // Each job must run exactly once
+    for (size_t i = 0; i < PARALLEL_TEST_BATCH_JOBS; i++)
+        if ( atomic_load(&batch_runs[i]) != 1 ) passed = false;
+
+    // An empty batch does nothing
+    if ( thread_pool_execute_batch(p_test_pool, count_job, _p_parameters, 0) == 0 ) passed = false;
+
+    // Clean up
+    thread_pool_destroy(&p_test_pool);
+
+    // Done
+    return passed;
+}
+
+bool test_parallel_for ( void )
+{
+
+    // Initialized data
+    bool passed = true;
+
+    // Construct a thread pool
+    if ( thread_pool_construct(&p_test_pool, PARALLEL_TEST_THREADS) == 0 ) return false;
+
+    // Keep a worker busy with an unrelated job
+    parallel_test_gate_close();
+    if ( thread_pool_execute(p_test_pool, gate_job, (void *) 0) == 0 ) return false;
+    if ( parallel_test_gate_wait(1) == false ) passed = false;
+
+    // Run the loop
+    if ( parallel_for(p_test_pool, 0, PARALLEL_TEST_FOR_INDICES, PARALLEL_TEST_FOR_GRAIN, for_body, (void *) 0) == 0 ) passed = false;
+
+    // Each index must be visited exactly once
+    for (size_t i = 0; i < PARALLEL_TEST_FOR_INDICES; i++)
+        if ( atomic_load(&for_hits[i]) != 1 ) passed = false;
+
+    // The range was split
+    if ( atomic_load(&for_pieces) < 2 ) passed = false;
+
+    // An empty range has no pieces
+    atomic_store(&for_pieces, 0);
+    if ( parallel_for(p_test_pool, 5, 5, PARALLEL_TEST_FOR_GRAIN, for_body, (void *) 0) == 0 ) passed = false;
+    if ( atomic_load(&for_pieces) ) passed = false;
+
+    // Let the worker go
+    atomic_store(&gate_open, true);
+    thread_pool_wait_idle(p_test_pool);
+
+    // Clean up
+    thread_pool_destroy(&p_test_pool);
+
+    // Done
+    return passed;
+}
+
+bool test_parallel_reduce ( void )
+{
+
+    // Initialized data
+    uint64_t identity = 0,
+             result   = 0;
+    bool     passed   = true;
+
+    // Construct a thread pool
+    if ( thread_pool_construct(&p_test_pool, PARALLEL_TEST_THREADS) == 0 ) return false;
+
+    // Sum the range
+    if ( parallel_reduce(p_test_pool, 0, PARALLEL_TEST_REDUCE_INDICES, PARALLEL_TEST_REDUCE_GRAIN, sizeof(uint64_t), &identity, reduce_sum, combine_sum, (void *) 0, &result) == 0 ) passed = false;
+    if ( result != (uint64_t) PARALLEL_TEST_REDUCE_INDICES * ( PARALLEL_TEST_REDUCE_INDICES - 1 ) / 2 ) passed = false;
+
+    // An empty range reduces to the identity
+    identity = 7;
+    if ( parallel_reduce(p_test_pool, 3, 3, PARALLEL_TEST_REDUCE_GRAIN, sizeof(uint64_t), &identity, reduce_sum, combine_sum, (void *) 0, &result) == 0 ) passed = false;
+    if ( result != 7 ) passed = false;
+
+    // Clean up
+    thread_pool_destroy(&p_test_pool);
+
+    // Done
+    return passed;
+}
+
+bool test_elastic ( void )
+{
+
+    // Initialized data
+    thread_pool_attributes _attributes =
+    {
+        .thread_quantity     = 1,
+        .max_thread_quantity = PARALLEL_TEST_ELASTIC_THREADS,
+        .idle_milliseconds   = PARALLEL_TEST_ELASTIC_MILLISECONDS
+    };
+    bool passed = true;
+
+    // Construct an elastic thread pool
+    if ( thread_pool_construct_with_attributes(&p_test_pool, &_attributes) == 0 ) return false;
+
+    // Keep every worker busy. Each job waits in the queue, so the thread pool grows
+    parallel_test_gate_close();
+    for (size_t i = 0; i < PARALLEL_TEST_ELASTIC_THREADS; i++)
+    {
+        if ( thread_pool_execute(p_test_pool, gate_job, (void *) 0) == 0 ) passed = false;
+        if ( parallel_test_gate_wait(i + 1) == false ) passed = false;
+    }
+    if ( thread_pool_get_thread_quantity(p_test_pool) != PARALLEL_TEST_ELASTIC_THREADS ) passed = false;
+
+    // The thread pool is at its maximum, so one more job waits
+    if ( thread_pool_execute(p_test_pool, gate_job, (void *) 0) == 0 ) passed = false;
+    parallel_test_sleep(PARALLEL_TEST_ELASTIC_MILLISECONDS);
+    if ( atomic_load(&gate_started) != PARALLEL_TEST_ELASTIC_THREADS ) passed = false;
+    if ( thread_pool_get_thread_quantity(p_test_pool) != PARALLEL_TEST_ELASTIC_THREADS ) passed = false;
+
+    // Let the workers go
+    atomic_store(&gate_open, true);
+    if ( thread_pool_wait_idle_timeout(p_test_pool, PARALLEL_TEST_TIMEOUT) == 0 ) return false;
+
+    // Idle workers retire, down to the minimum
+    for (size_t i = 0; i < PARALLEL_TEST_TIMEOUT && thread_pool_get_thread_quantity(p_test_pool) > 1; i++)
+        parallel_test_sleep(1);
+    if ( thread_pool_get_thread_quantity(p_test_pool) != 1 ) passed = false;
+
+    // Clean up
+    thread_pool_destroy(&p_test_pool);
+
+    // Done
+    return passed;
+}
+
+bool test_priority ( void )
+{
+
+    // Initialized data
+    bool passed = true;
+
+    // Construct a thread pool with one thread
+    if ( thread_pool_construct(&p_test_pool, 1) == 0 ) return false;
+
+    // Keep the worker busy
+    parallel_test_gate_close();
+    if ( thread_pool_execute(p_test_pool, gate_job, (void *) 0) == 0 ) return false;
+    if ( parallel_test_gate_wait(1) == false ) passed = false;
+
+    // Queue the lowest priority first
+    for (size_t i = THREAD_POOL_PRIORITY_QUANTITY; i-- > 0;)
+        for (size_t j = 0; j < PARALLEL_TEST_PRIORITY_JOBS; j++)
+            if ( thread_pool_execute_with_priority(p_test_pool, priority_job, (void *) i, (enum thread_pool_priority_e) i) == 0 ) passed = false;
+
+    // Let the worker go
+    atomic_store(&gate_open, true);
+    if ( thread_pool_wait_idle_timeout(p_test_pool, PARALLEL_TEST_TIMEOUT) == 0 ) return false;
+
+    // The jobs ran highest priority first
+    if ( atomic_load(&priority_next) != THREAD_POOL_PRIORITY_QUANTITY * PARALLEL_TEST_PRIORITY_JOBS ) passed = false;
+    for (size_t i = 0; i < THREAD_POOL_PRIORITY_QUANTITY * PARALLEL_TEST_PRIORITY_JOBS; i++)
+        if ( priority_order[i] != i / PARALLEL_TEST_PRIORITY_JOBS ) passed = false;
+
+    // Clean up
+    thread_pool_destroy(&p_test_pool);
+
+    // Done
+    return passed;
+}
+
+bool test_park_wakeup ( void )
+{
+
+    // Initialized data
+    thread_pool_attributes _attributes = { .thread_quantity = 2, .spin_iterations = THREAD_POOL_SPIN_NONE };
+    thread_pool_future    *p_future = (void *) 0;
+
+    // Construct a thread pool whose workers park as soon as they are idle
+    if ( thread_pool_construct_with_attributes(&p_test_pool, &_attributes) == 0 ) return false;
+
+    // Submit one job at a time
+    for (size_t i = 0; i < PARALLEL_TEST_PARK_ROUNDS; i++)
+    {
+
+        // Submit a job
+        if ( thread_pool_execute_future(p_test_pool, count_job, &park_runs, &p_future) == 0 ) return false;
+
+        // A lost wakeup leaves the job in the queue
+        if ( thread_pool_future_get_timeout(p_future, PARALLEL_TEST_TIMEOUT, (void *) 0) == 0 ) return false;
+
+        // Clean up
+        thread_pool_future_destroy(&p_future);
+
+        // Give the workers time to park, now and then
+        if ( ( i & 63 ) == 0 ) parallel_test_sleep(1);
+    }
+
+    // Clean up
+    thread_pool_destroy(&p_test_pool);
+
+    // Done
+    return atomic_load(&park_runs) == PARALLEL_TEST_PARK_ROUNDS;
+}
+
+bool test_busy_poll ( void )
+{
+
+    // Initialized data
+    thread_pool_attributes _attributes = { .thread_quantity = 1, .wait = THREAD_POOL_WAIT_BUSY_POLL };
+    thread_pool_future    *p_future = (void *) 0;
+    thread_pool           *p_elastic = (void *) 0;
+    bool                   passed = true;
+
+    // Construct a busy polling thread pool
+    if ( thread_pool_construct_with_attributes(&p_test_pool, &_attributes) == 0 ) return false;
+
+    // Submit one job at a time
+    for (size_t i = 0; i < PARALLEL_TEST_BUSY_POLL_ROUNDS; i++)
+    {
+
+        // Initialized data
+        void *p_result = (void *) 0;
+
+        // Submit a job
+        if ( thread_pool_execute_future(p_test_pool, identity_job, (void *) i, &p_future) == 0 ) return false;
+
+        // Wait for the job
+        if ( thread_pool_future_get_timeout(p_future, PARALLEL_TEST_TIMEOUT, &p_result) == 0 ) return false;
+        if ( p_result != (void *) i ) passed = false;
+
+        // Clean up
+        thread_pool_future_destroy(&p_future);
+    }
+
+    // Clean up
+    thread_pool_destroy(&p_test_pool);
+
+    // A busy polling thread pool can't grow
+    _attributes.max_thread_quantity = 2;
+    if ( thread_pool_construct_with_attributes(&p_elastic, &_attributes) ) passed = false, thread_pool_destroy(&p_elastic);
+
+    // Done
+    return passed;
+}
+
+bool test_execute_inline ( void )
+{
+
+    // Initialized data
+    thread_pool_attributes _attributes = { .thread_quantity = PARALLEL_TEST_THREADS, .descriptor_quantity = PARALLEL_TEST_INLINE_DESCRIPTORS };
+    inline_parameter       _parameter  = { 0 };
+    char                   _too_big[THREAD_POOL_INLINE_PARAMETER_SIZE + 1] = { 0 };
+    bool                   passed = true;
+
+    // Construct a thread pool with a few descriptors
+    if ( thread_pool_construct_with_attributes(&p_test_pool, &_attributes) == 0 ) return false;
+
+    // Execute the jobs
+    for (size_t i = 0; i < PARALLEL_TEST_INLINE_JOBS; i++)
+    {
+
+        // Populate the parameter
+        _parameter = (inline_parameter) { .index = i, .check = ~i };
+        snprintf(_parameter._text, sizeof(_parameter._text), "%zu", i);
+
+        // Execute the job
+        if ( thread_pool_execute_inline(p_test_pool, inline_job, &_parameter, sizeof(_parameter), inline_destructor) == 0 ) passed = false;
+
+        // The job has its own copy
+        memset(&_parameter, 0xff, sizeof(_parameter));
+    }
+
+    // Wait for the jobs
+    if ( thread_pool_wait_idle_timeout(p_test_pool, PARALLEL_TEST_TIMEOUT) == 0 ) return false;
+
+    // Each job saw its own parameter, and each copy was destroyed
+    if ( atomic_load(&inline_errors) ) passed = false;
+    if ( atomic_load(&inline_sum) != (size_t) PARALLEL_TEST_INLINE_JOBS * ( PARALLEL_TEST_INLINE_JOBS - 1 ) / 2 ) passed = false;
+    if ( atomic_load(&inline_destroyed) != PARALLEL_TEST_INLINE_JOBS ) passed = false;
+
+    // A parameter that doesn't fit is an error
+    if ( thread_pool_execute_inline(p_test_pool, inline_job, _too_big, sizeof(_too_big), (void *) 0) ) passed = false;
+
+    // Clean up
+    thread_pool_destroy(&p_test_pool);
+
+    // Done
+    return passed;
+}
+
+bool test_group_wait ( void )
+{
+
+    // Initialized data
+    thread_pool_group *p_group = (void *) 0;
+    bool               passed  = true;
+
+    // Construct a thread pool with one thread
+    if ( thread_pool_construct(&p_test_pool, 1) == 0 ) return false;
+
+    // Keep the worker busy with an unrelated job
+    parallel_test_gate_close();
+    if ( thread_pool_execute(p_test_pool, gate_job, (void *) 0) == 0 ) return false;
+    if ( parallel_test_gate_wait(1) == false ) passed = false;
+
+    // Execute jobs that execute more jobs in the same group
+    atomic_store(&group_runs, 0);
+    if ( thread_pool_group_construct(&p_group, p_test_pool) == 0 ) return false;
+    for (size_t i = 0; i < PARALLEL_TEST_GROUP_JOBS; i++)
+        if ( thread_pool_group_execute(p_group, group_child, p_group) == 0 ) passed = false;
+
+    // The caller runs the group's jobs, since the worker is busy
+    if ( thread_pool_group_wait(p_group) == 0 ) passed = false;
+    if ( atomic_load(&group_runs) != 2 * PARALLEL_TEST_GROUP_JOBS ) passed = false;
+
+    // Let the worker go
+    atomic_store(&gate_open, true);
+
+    // Clean up
+    thread_pool_group_destroy(&p_group);
+    thread_pool_wait_idle(p_test_pool);
+    thread_pool_destroy(&p_test_pool);
+
+    // Done
+    return passed;
+}
+
+bool test_nested_waits ( void )
+{
+
+    // Initialized data
+    thread_pool_future *p_root   = (void *) 0;
+    void               *p_result = (void *) 0;
+
+    // Construct a thread pool with one thread
+    if ( thread_pool_construct(&p_test_pool, 1) == 0 ) return false;
+
+    // Wait from inside the worker
+    if ( thread_pool_execute_future(p_test_pool, nested_root, (void *) 0, &p_root) == 0 ) return false;
+
+    // A stuck worker can't be destroyed
+    if ( thread_pool_future_get_timeout(p_root, PARALLEL_TEST_TIMEOUT, &p_result) == 0 ) return false;
+
+    // Clean up
+    thread_pool_future_destroy(&p_root);
+    thread_pool_destroy(&p_test_pool);
+
+    // Done
+    return p_result == (void *) 1;
+}
+
+bool test_continuations ( void )
+{
+
+    // Initialized data
+    thread_pool_future *p_future = (void *) 0,
+                       *p_then   = (void *) 0,
+                       *p_all    = (void *) 1,
+                       *_p_futures[PARALLEL_TEST_WHEN_ALL_FUTURES] = { 0 };
+    void               *p_result = (void *) 0;
+    uintptr_t           sum      = 0;
+    bool                passed   = true;
+
+    // Construct a thread pool
+    if ( thread_pool_construct(&p_test_pool, PARALLEL_TEST_THREADS) == 0 ) return false;
+
+    // Double a job's result in a continuation
+    if ( thread_pool_execute_future(p_test_pool, identity_job, (void *) 21, &p_future) == 0 ) return false;
+    if ( thread_pool_future_then(p_future, twice_job, &p_then) == 0 ) return false;
+    if ( thread_pool_future_get_timeout(p_then, PARALLEL_TEST_TIMEOUT, &p_result) == 0 ) return false;
+    if ( p_result != (void *) 42 ) passed = false;
+
+    // A future has one continuation
+    if ( thread_pool_future_then(p_future, twice_job, (void *) 0) ) passed = false;
+
+    // Clean up
+    thread_pool_future_destroy(&p_future);
+    thread_pool_future_destroy(&p_then);
+
+    // Wait on a set of futures
+    for (size_t i = 0; i < PARALLEL_TEST_WHEN_ALL_FUTURES; i++)
+        if ( thread_pool_execute_future(p_test_pool, identity_job, (void *) ( i + 1 ), &_p_futures[i]) == 0 ) return false;
+    if ( thread_pool_when_all(p_test_pool, _p_futures, PARALLEL_TEST_WHEN_ALL_FUTURES, &p_all) == 0 ) return false;
+    if ( thread_pool_future_get_timeout(p_all, PARALLEL_TEST_TIMEOUT, &p_result) == 0 ) return false;
+
+    // The result is the set of futures, and each one is done
+    if ( p_result != (void *) _p_futures ) passed = false;
+    for (size_t i = 0; i < PARALLEL_TEST_WHEN_ALL_FUTURES; i++)
+    {
+
+        // Initialized data
+        void *p_value = (void *) 0;
+
+        // Add the result
+        if ( thread_pool_future_try_get(_p_futures[i], &p_value) == 0 ) passed = false;
+        sum += (uintptr_t) p_value;
+    }
+    if ( sum != PARALLEL_TEST_WHEN_ALL_FUTURES * ( PARALLEL_TEST_WHEN_ALL_FUTURES + 1 ) / 2 ) passed = false;
+
+    // Clean up
+    thread_pool_future_destroy(&p_all);
+    for (size_t i = 0; i < PARALLEL_TEST_WHEN_ALL_FUTURES; i++)
+        thread_pool_future_destroy(&_p_futures[i]);
+
+    // A future that appears twice fails, without leaving a future that never finishes
+    if ( thread_pool_execute_future(p_test_pool, identity_job, (void *) 1, &p_future) == 0 ) return false;
+    _p_futures[0] = p_future;
+    _p_futures[1] = p_future;
+    p_all         = (void *) 1;
+    if ( thread_pool_when_all(p_test_pool, _p_futures, 2, &p_all) ) passed = false;
+    if ( p_all ) passed = false;
+    if ( thread_pool_future_get_timeout(p_future, PARALLEL_TEST_TIMEOUT, (void *) 0) == 0 ) return false;
+
+    // Clean up
+    thread_pool_future_destroy(&p_future);
+    thread_pool_destroy(&p_test_pool);
+
+    // Done
+    return passed;
+}
+
+bool test_timer_cancel ( void )
+{
+
+    // Initialized data
+    thread_pool_timer *p_timer = (void *) 0;
+    size_t             runs    = 0;
+    bool               passed  = true;
+
+    // Construct a thread pool
+    if ( thread_pool_construct(&p_test_pool, 2) == 0 ) return false;
+
+    // Run a periodic job for a while
+    if ( thread_pool_execute_every(p_test_pool, PARALLEL_TEST_TIMER_PERIOD, count_job, &timer_runs, &p_timer) == 0 ) return false;
+    parallel_test_sleep(20 * PARALLEL_TEST_TIMER_PERIOD);
+
+    // Cancel it
+    thread_pool_timer_cancel(&p_timer);
+    runs = atomic_load(&timer_runs);
+
+    // A run the timer had already queued may still happen, but no more
+    parallel_test_sleep(10 * PARALLEL_TEST_TIMER_PERIOD);
+    if ( runs == 0 || atomic_load(&timer_runs) > runs + 1 ) passed = false;
+
+    // Cancel a one shot timer before it fires
+    runs = atomic_load(&timer_runs);
+    if ( thread_pool_execute_after(p_test_pool, 20 * PARALLEL_TEST_TIMER_PERIOD, count_job, &timer_runs, &p_timer) == 0 ) return false;
+    thread_pool_timer_cancel(&p_timer);
+
+    // It never runs
+    parallel_test_sleep(40 * PARALLEL_TEST_TIMER_PERIOD);
+    if ( atomic_load(&timer_runs) != runs ) passed = false;
+
+    // Clean up
+    thread_pool_destroy(&p_test_pool);
+
+    // Done
+    return passed;
+}
+
+bool test_timer_outlives_pool ( void )
+{
+
+    // Initialized data
+    thread_pool_timer *p_periodic = (void *) 0,
+                      *p_one_shot = (void *) 0;
+    size_t             runs       = 0;
+    bool               passed     = true;
+
+    // Construct a thread pool
+    if ( thread_pool_construct(&p_test_pool, 2) == 0 ) return false;
+
+    // Start a periodic timer, and a one shot timer
+    runs = atomic_load(&timer_runs);
+    if ( thread_pool_execute_every(p_test_pool, PARALLEL_TEST_TIMER_PERIOD, count_job, &timer_runs, &p_periodic) == 0 ) return false;
+    if ( thread_pool_execute_after(p_test_pool, PARALLEL_TEST_TIMER_PERIOD, count_job, &timer_runs, &p_one_shot) == 0 ) return false;
+
+    // Let the one shot timer fire
+    parallel_test_sleep(20 * PARALLEL_TEST_TIMER_PERIOD);
+    if ( atomic_load(&timer_runs) == runs ) passed = false;
+
+    // Destroy the thread pool, with both handles held
+    thread_pool_destroy(&p_test_pool);
+
+    // Release the handles
+    if ( thread_pool_timer_cancel(&p_periodic) == 0 ) passed = false;
+    if ( thread_pool_timer_cancel(&p_one_shot) == 0 ) passed = false;
+
+    // Done
+    return passed;
+}
+
+bool test_overflow ( enum thread_pool_overflow_e overflow )
+{
+
+    // Initialized data
+    thread_pool_attributes _attributes =
+    {
+        .thread_quantity       = 1,
+        .queue_length          = PARALLEL_TEST_QUEUE_LENGTH,
+        .overflow              = overflow,
+        .overflow_milliseconds = PARALLEL_TEST_OVERFLOW_MILLISECONDS
+    };
+    int  result = 0,
+         error  = 0;
+    bool passed = true;
+
+    // Reset the state
+    atomic_store(&overflow_runs, 0);
+    overflow_caller = (pthread_t) 0;
+
+    // Construct a thread pool with one thread, and a short queue
+    if ( thread_pool_construct_with_attributes(&p_test_pool, &_attributes) == 0 ) return false;
+
+    // Keep the worker busy
+    parallel_test_gate_close();
+    if ( thread_pool_execute(p_test_pool, gate_job, (void *) 0) == 0 ) return false;
+    if ( parallel_test_gate_wait(1) == false ) passed = false;
+
+    // Fill the queue
+    for (size_t i = 0; i < PARALLEL_TEST_QUEUE_LENGTH; i++)
+        if ( thread_pool_execute(p_test_pool, overflow_job, (void *) 0) == 0 ) passed = false;
+
+    // Submit one more job
+    errno  = 0;
+    result = thread_pool_execute(p_test_pool, overflow_job, (void *) 0);
+    error  = errno;
+
+    // Check the policy
+    if ( overflow == THREAD_POOL_OVERFLOW_REJECT      && ( result != 0 || error != EAGAIN ) ) passed = false;
+    if ( overflow == THREAD_POOL_OVERFLOW_BLOCK       && ( result != 0 || error != ETIMEDOUT ) ) passed = false;
+    if ( overflow == THREAD_POOL_OVERFLOW_CALLER_RUNS && ( result != 1 || atomic_load(&overflow_runs) != 1 || pthread_equal(overflow_caller, pthread_self()) == 0 ) ) passed = false;
+
+    // Let the worker go
+    atomic_store(&gate_open, true);
+    thread_pool_wait_idle(p_test_pool);
+
+    // A rejected or timed out job never runs
+    if ( atomic_load(&overflow_runs) != PARALLEL_TEST_QUEUE_LENGTH + ( overflow == THREAD_POOL_OVERFLOW_CALLER_RUNS ) ) passed = false;
+
+    // Clean up
+    thread_pool_destroy(&p_test_pool);
+
+    // Done
+    return passed;
+}
+
+bool test_stats ( void )
+{
+
+    // Initialized data
+    thread_pool_statistics _statistics = { 0 };
+    uint64_t               latencies   = 0;
+    bool                   passed      = true;
+
+    // Construct a thread pool
+    if ( thread_pool_construct(&p_test_pool, 2) == 0 ) return false;
+
+    // Run the jobs
+    for (size_t i = 0; i < PARALLEL_TEST_STATS_JOBS; i++)
+        if ( thread_pool_execute(p_test_pool, count_job, &stats_runs) == 0 ) return false;
+    if ( thread_pool_wait_idle(p_test_pool) == 0 ) return false;
+
+    // Get the statistics
+    if ( thread_pool_stats(p_test_pool, &_statistics) == 0 ) return false;
+
+    // Each job was counted once, with its latency
+    for (size_t i = 0; i < THREAD_POOL_LATENCY_BUCKETS; i++)
+        latencies += _statistics.latency[i];
+    if ( _statistics.thread_quantity != 2 ) passed = false;
+    if ( _statistics.jobs != PARALLEL_TEST_STATS_JOBS ) passed = false;
+    if ( latencies != PARALLEL_TEST_STATS_JOBS ) passed = false;
+    if ( _statistics.busy_nanoseconds == 0 ) passed = false;
+
+    // Nothing is waiting, and a shared queue has nothing to steal
+    if ( _statistics.queue_depth ) passed = false;
+    if ( _statistics.steals ) passed = false;
+
+    // Clean up
+    thread_pool_destroy(&p_test_pool);
+
+    // Done
+    return passed;
+}
+
+bool test_schedule_graph ( void )
+{
+
+    // Initialized data
+    char        _text[]    = "{\"name\":\"test\",\"threads\":{\"A\":[{\"task\":\"test first\"},{\"task\":\"test second\"}],\"B\":[{\"task\":\"test third\",\"wait\":[\"A:test second\"]}]}}";
+    json_value *p_value    = (void *) 0;
+    schedule   *p_schedule = (void *) 0;
+    bool        passed     = true;
+
+    // Register the tasks
+    parallel_register_task("test first", schedule_task_first);
+    parallel_register_task("test second", schedule_task_second);
+    parallel_register_task("test third", schedule_task_third);
+
+    // Load the schedule
+    if ( json_value_parse(_text, 0, &p_value) == 0 ) return false;
+    if ( schedule_load_as_json_value(&p_schedule, p_value) == 0 ) return false;
+
+    // Construct a thread pool
+    if ( thread_pool_construct(&p_test_pool, PARALLEL_TEST_THREADS) == 0 ) return false;
+
+    // Run the schedule twice
+    for (size_t i = 0; i < 2; i++)
+    {
+
+        // Reset the state
+        atomic_store(&schedule_sequence, 0);
+
+        // Run the schedule
+        if ( schedule_start_on_thread_pool(p_schedule, p_test_pool, (void *) 0) == 0 ) return false;
+        schedule_wait_idle(p_schedule);
+
+        // Each task ran once, in order
+        if ( atomic_load(&schedule_sequence) != 3 ) passed = false;
+        for (size_t j = 0; j < 3; j++)
+            if ( schedule_order[j] != j ) passed = false;
+    }
+
+    // Clean up
+    schedule_stop(p_schedule);
+    schedule_destroy(&p_schedule);
+    thread_pool_destroy(&p_test_pool);
+
+    // Done
+    return passed;
+}
+
+bool test_schedule_waits ( bool pool, size_t pipeline )
+{
+
+    // Initialized data
+    char         _text[512] = { 0 };
+    json_value  *p_value    = (void *) 0;
+    schedule    *p_schedule = (void *) 0;
+    thread_pool *p_pool     = (void *) 0;
+    bool         passed     = true;
+
+    // Reset the state
+    atomic_store(&schedule_a, 0);
+    atomic_store(&schedule_b, 0);
+    atomic_store(&schedule_c, 0);
+    atomic_store(&schedule_violations, 0);
+
+    // A thread pool runs one iteration at a time without a pipeline, and dedicated threads have no window
+    schedule_window = ( pipeline ) ? pipeline : ( pool ) ? 1 : 0;
+
+    // Register the tasks
+    parallel_register_task("test a", schedule_task_a);
+    parallel_register_task("test b", schedule_task_b);
+    parallel_register_task("test c", schedule_task_c);
+
+    // Write the schedule
+    if ( pipeline ) snprintf(_text, sizeof(_text), "{\"name\":\"test\",\"repeat\":true,\"pipeline\":%zu,\"threads\":{\"A\":[{\"task\":\"test a\"}],\"B\":[{\"task\":\"test b\"}],\"C\":[{\"task\":\"test c\",\"wait\":[\"A:test a\",\"B:test b\"]}]}}", pipeline);
+    else            snprintf(_text, sizeof(_text), "{\"name\":\"test\",\"repeat\":true,\"threads\":{\"A\":[{\"task\":\"test a\"}],\"B\":[{\"task\":\"test b\"}],\"C\":[{\"task\":\"test c\",\"wait\":[\"A:test a\",\"B:test b\"]}]}}");
+
+    // Load the schedule
+    if ( json_value_parse(_text, 0, &p_value) == 0 ) return false;
+    if ( schedule_load_as_json_value(&p_schedule, p_value) == 0 ) return false;
+
+    // Start the schedule
+    if ( pool )
+    {
+        if ( thread_pool_construct(&p_pool, PARALLEL_TEST_THREADS) == 0 ) return false;
+        if ( schedule_start_on_thread_pool(p_schedule, p_pool, (void *) 0) == 0 ) return false;
+    }
+    else if ( schedule_start(p_schedule, (void *) 0) == 0 ) return false;
+
+    // A running schedule can't be started again
+    if ( pool && schedule_start_on_thread_pool(p_schedule, p_pool, (void *) 0) ) passed = false;
+    if ( schedule_start(p_schedule, (void *) 0) ) passed = false;
+
+    // Let it repeat for a while
+    parallel_test_sleep(PARALLEL_TEST_SCHEDULE_MILLISECONDS);
+
+    // Finish the iterations in flight
+    schedule_pause(p_schedule);
+    schedule_wait_idle(p_schedule);
+    schedule_stop(p_schedule);
+
+    // No task ran early
+    if ( atomic_load(&schedule_c) == 0 ) passed = false;
+    if ( atomic_load(&schedule_violations) ) passed = false;
+
+    // A window pauses every thread at the same iteration
+    if ( schedule_window && atomic_load(&schedule_a) != atomic_load(&schedule_c) ) passed = false;
+    if ( schedule_window && atomic_load(&schedule_b) != atomic_load(&schedule_c) ) passed = false;
+
+    // Clean up
+    schedule_destroy(&p_schedule);
+    if ( p_pool ) thread_pool_destroy(&p_pool);
+
+    // Done
+    return passed;
+}
+
+void *steal_root ( void *p_parameter )
+{
+
+    // Initialized data
+    size_t index = (size_t) p_parameter;
+
+    // Push one job at a time, then wait for it. The wait pops the job from this
+    // worker's deque, unless an idle worker steals it first
+    for (size_t i = 0; i < PARALLEL_TEST_STEAL_ROUNDS; i++)
+    {
+
+        // Initialized data
+        thread_pool_future *p_future = (void *) 0;
+
+        // Push the job
+        if ( thread_pool_execute_future(p_test_pool, count_job, &steal_runs[index][i], &p_future) == 0 )
+        {
+            atomic_fetch_add(&steal_errors, 1);
+            continue;
+        }
+
+        // Wait for the job
+        thread_pool_future_wait(p_future, (void *) 0);
+
+        // Clean up
+        thread_pool_future_destroy(&p_future);
+    }
+
+    // Done
+    return (void *) 0;
+}
+
+void *count_job ( void *p_parameter )
+{
+
+    // Count the run
+    atomic_fetch_add((atomic_size_t *) p_parameter, 1);
+
+    // Done
+    return (void *) 0;
+}
+
+void *gate_job ( void *p_parameter )
+{
+
+    // Supress warnings
+    (void) p_parameter;
+
+    // The job started
+    atomic_fetch_add(&gate_started, 1);
+
+    // Wait for the gate to open
+    while ( atomic_load(&gate_open) == false ) parallel_test_sleep(1);
+
+    // Done
+    return (void *) 0;
+}
+
+void for_body ( size_t begin, size_t end, void *p_context )
+{
+
+    // Supress warnings
+    (void) p_context;
+
+    // Visit each index
+    for (size_t i = begin; i < end; i++)
+        atomic_fetch_add(&for_hits[i], 1);
+
+    // Count the piece
+    atomic_fetch_add(&for_pieces, 1);
+
+    // Done
+    return;
+}
+
+void reduce_sum ( size_t begin, size_t end, void *p_partial, void *p_context )
+{
+
+    // Supress warnings
+    (void) p_context;
+
+    // Add each index to the partial
+    for (size_t i = begin; i < end; i++)
+        *(uint64_t *) p_partial += i;
+
+    // Done
+    return;
+}
+
+void combine_sum ( void *p_partial, const void *p_other, void *p_context )
+{
+
+    // Supress warnings
+    (void) p_context;
+
+    // Add the other partial
+    *(uint64_t *) p_partial += *(const uint64_t *) p_other;
+
+    // Done
+    return;
+}
+
+void *priority_job ( void *p_parameter )
+{
+
+    // Store the priority of the job, in the order the jobs ran
+    priority_order[atomic_fetch_add(&priority_next, 1)] = (size_t) p_parameter;
+
+    // Done
+    return (void *) 0;
+}
+
+void *identity_job ( void *p_parameter )
+{
+
+    // Done
+    return p_parameter;
+}
+
+void *inline_job ( void *p_parameter )
+{
+
+    // Initialized data
+    inline_parameter *p_inline_parameter = p_parameter;
+    char              _text[40]          = { 0 };
+
+    // Check the copy
+    snprintf(_text, sizeof(_text), "%zu", p_inline_parameter->index);
+    if ( p_inline_parameter->check != ~p_inline_parameter->index || strcmp(_text, p_inline_parameter->_text) ) atomic_fetch_add(&inline_errors, 1);
+
+    // Add the index
+    atomic_fetch_add(&inline_sum, p_inline_parameter->index);
+
+    // Done
+    return (void *) 0;
+}
+
+void inline_destructor ( void *p_parameter )
+{
+
+    // Initialized data
+    inline_parameter *p_inline_parameter = p_parameter;
+
+    // The copy is still intact
+    if ( p_inline_parameter->check != ~p_inline_parameter->index ) atomic_fetch_add(&inline_errors, 1);
+
+    // Count the copy
+    atomic_fetch_add(&inline_destroyed, 1);
+
+    // Done
+    return;
+}
+
+void *group_child ( void *p_parameter )
+{
+
+    // Count the run
+    atomic_fetch_add(&group_runs, 1);
+
+    // Execute a job in the same group
+    thread_pool_group_execute((thread_pool_group *) p_parameter, count_job, &group_runs);
+
+    // Done
+    return (void *) 0;
+}
+
+void *nested_root ( void *p_parameter )
+{
+
+    // Supress warnings
+    (void) p_parameter;
+
+    // Initialized data
+    thread_pool_group  *p_group  = (void *) 0;
+    thread_pool_future *p_future = (void *) 0;
+    void               *p_result = (void *) 0;
+    bool                passed   = true;
+
+    // Construct a group
+    atomic_store(&group_runs, 0);
+    if ( thread_pool_group_construct(&p_group, p_test_pool) == 0 ) return (void *) 0;
+
+    // Execute jobs that execute more jobs in the same group
+    for (size_t i = 0; i < PARALLEL_TEST_GROUP_JOBS; i++)
+        if ( thread_pool_group_execute(p_group, group_child, p_group) == 0 ) passed = false;
+
+    // This is the only worker, so it has to run the group's jobs itself
+    thread_pool_group_wait(p_group);
+    if ( atomic_load(&group_runs) != 2 * PARALLEL_TEST_GROUP_JOBS ) passed = false;
+
+    // Clean up
+    thread_pool_group_destroy(&p_group);
+
+    // Wait on a future
+    if ( thread_pool_execute_future(p_test_pool, identity_job, (void *) 7, &p_future) == 0 ) return (void *) 0;
+    thread_pool_future_wait(p_future, &p_result);
+    if ( p_result != (void *) 7 ) passed = false;
+
+    // Clean up
+    thread_pool_future_destroy(&p_future);
+
+    // Wait on a parallel loop
+    if ( parallel_for(p_test_pool, 0, PARALLEL_TEST_NESTED_INDICES, 16, nested_for_body, (void *) 0) == 0 ) passed = false;
+    if ( atomic_load(&nested_indices) != PARALLEL_TEST_NESTED_INDICES ) passed = false;
+
+    // Done
+    return (void *) (uintptr_t) passed;
+}
+
+void nested_for_body ( size_t begin, size_t end, void *p_context )
+{
+
+    // Supress warnings
+    (void) p_context;
+
+    // Count the indices
+    atomic_fetch_add(&nested_indices, end - begin);
+
+    // Done
+    return;
+}
+
+void *twice_job ( void *p_parameter )
+{
+
+    // Done
+    return (void *) ( (uintptr_t) p_parameter * 2 );
+}
+
+void *overflow_job ( void *p_parameter )
+{
+
+    // Supress warnings
+    (void) p_parameter;
+
+    // Store the thread that ran the job
+    overflow_caller = pthread_self();
+
+    // Count the run
+    atomic_fetch_add(&overflow_runs, 1);
+
+    // Done
+    return (void *) 0;
+}
+
+void *schedule_task_first ( void *p_parameter )
+{
+
+    // Supress warnings
+    (void) p_parameter;
+
+    // Store the position of the task
+    schedule_order[0] = atomic_fetch_add(&schedule_sequence, 1);
+
+    // Done
+    return (void *) 0;
+}
+
+void *schedule_task_second ( void *p_parameter )
+{
+
+    // Supress warnings
+    (void) p_parameter;
+
+    // Store the position of the task
+    schedule_order[1] = atomic_fetch_add(&schedule_sequence, 1);
+
+    // Done
+    return (void *) 0;
+}
+
+void *schedule_task_third ( void *p_parameter )
+{
+
+    // Supress warnings
+    (void) p_parameter;
+
+    // Store the position of the task
+    schedule_order[2] = atomic_fetch_add(&schedule_sequence, 1);
+
+    // Done
+    return (void *) 0;
+}
+
+void *schedule_task_a ( void *p_parameter )
+{
+
+    // Supress warnings
+    (void) p_parameter;
+
+    // Initialized data
+    size_t iteration = atomic_load(&schedule_a);
+
+    // Iteration n starts only after every thread finished iteration n - window
+    if ( schedule_window && iteration >= atomic_load(&schedule_c) + schedule_window ) atomic_fetch_add(&schedule_violations, 1);
+
+    // Count the run
+    atomic_fetch_add(&schedule_a, 1);
+
+    // Done
+    return (void *) 0;
+}
+
+void *schedule_task_b ( void *p_parameter )
+{
+
+    // Supress warnings
+    (void) p_parameter;
+
+    // Initialized data
+    size_t iteration = atomic_load(&schedule_b);
+
+    // Iteration n starts only after every thread finished iteration n - window
+    if ( schedule_window && iteration >= atomic_load(&schedule_c) + schedule_window ) atomic_fetch_add(&schedule_violations, 1);
+
+    // Count the run
+    atomic_fetch_add(&schedule_b, 1);
+
+    // Done
+    return (void *) 0;
+}
+
+void *schedule_task_c ( void *p_parameter )
+{
+
+    // Supress warnings
+    (void) p_parameter;
+
+    // Initialized data
+    size_t iteration = atomic_load(&schedule_c);
+
+    // Both inputs of this iteration are done
+    if ( atomic_load(&schedule_a) < iteration + 1 ) atomic_fetch_add(&schedule_violations, 1);
+    if ( atomic_load(&schedule_b) < iteration + 1 ) atomic_fetch_add(&schedule_violations, 1);
+
+    // Take longer than the inputs, so they run ahead
+    parallel_test_sleep(1);
+
+    // Count the run
+    atomic_fetch_add(&schedule_c, 1);
+
+    // Done
+    return (void *) 0;
+}
@@ -6,8 +6,13 @@
  * @author Jacob Smith
  */
 
+// Standard library
+#include <stdatomic.h>
+#include <pthread.h>
+
 // Header
 #include <parallel/schedule.h>
+#include <parallel/trace.h>
 
 // Preprocessor definitions
 #define PARALLEL_SCHEDULE_NAME_LENGTH        (63 + 1)
@@ -15,27 +20,45 @@
 #define PARALLEL_SCHEDULE_TASK_NAME_LENGTH   (63 + 1)
 #define PARALLEL_SCHEDULE_MAX_THREADS        64
 #define PARALLEL_SCHEDULE_MAX_TASKS          256
+#define PARALLEL_SCHEDULE_MAX_PIPELINE       64
 
 // Forward declarations
 struct parallel_schedule_thread_s;
 struct parallel_schedule_task_s;
+struct parallel_schedule_wait_s;
 struct parallel_schedule_work_parameter_s;
 
 // Type definitions
 typedef struct parallel_schedule_thread_s         parallel_schedule_thread;
 typedef struct parallel_schedule_task_s           parallel_schedule_task;
+typedef struct parallel_schedule_wait_s           parallel_schedule_wait;
 typedef struct parallel_schedule_work_parameter_s parallel_schedule_work_parameter;
 
 // Structure definitions
+struct parallel_schedule_wait_s
+{
+    parallel_schedule_task *p_task; // the task to wait on, resolved when the schedule is loaded
+    char _thread [PARALLEL_SCHEDULE_THREAD_NAME_LENGTH],
+         _task [PARALLEL_SCHEDULE_TASK_NAME_LENGTH];
+};
+
 struct parallel_schedule_task_s
 {
-    bool dependent, dependency, ready;
+    bool dependent, dependency, ready, first;
     int dependencies;
     fn_parallel_task *pfn_task;
-    monitor _monitor;
-    char _name [PARALLEL_SCHEDULE_TASK_NAME_LENGTH],
-         _wait_thread [PARALLEL_SCHEDULE_THREAD_NAME_LENGTH],
-         _wait_task [PARALLEL_SCHEDULE_TASK_NAME_LENGTH];
+    size_t wait_quantity;
+    parallel_schedule_wait *p_waits; // the tasks this task waits on
+    atomic_size_t runs;              // the quantity of times this task has finished
+    pthread_mutex_t _lock;
+    pthread_cond_t _done;
+    parallel_schedule_task **pp_successors; // the task after this task in its thread, and each task that waits on this task
+    size_t successor_quantity;
+    size_t in_degree;                       // the quantity of tasks this task waits on, including the task before it in its thread
+    atomic_size_t *p_pending;               // for each iteration in flight, the quantity of signals this task still waits on, on a thread pool
+    parallel_schedule_task *p_first;        // the first task of this task's thread, if this task is the last
+    schedule *p_schedule;
+    char _name [PARALLEL_SCHEDULE_TASK_NAME_LENGTH];
 };
 
 struct parallel_schedule_thread_s
@@ -60,7 +83,20 @@ struct schedule_s
     size_t running_threads;
     dict *p_threads;
     bool repeat;
+    enum parallel_thread_placement_e placement;
     void *p_parameter;
+    thread_pool *p_thread_pool;             // the thread pool the schedule runs on, or null pointer for dedicated threads
+    size_t pipeline;                        // the most iterations in flight at once
+    bool pipelined;                         // set if the schedule sets a pipeline. Dedicated threads without one are not held to a window
+    atomic_size_t admitted;                 // the quantity of iterations that may start
+    bool closed;                            // set once no more iterations will be admitted. Guarded by _admit_lock
+    atomic_size_t busy;                     // task jobs in flight, plus one until the last iteration finishes, on a thread pool
+    atomic_size_t *p_finished;              // for each iteration in flight, the quantity of threads that finished it
+    parallel_schedule_task **pp_firsts;     // the first task of each thread that has tasks
+    size_t tasked_thread_quantity;
+    pthread_mutex_t _admit_lock;
+    pthread_cond_t _admit;
+    pthread_cond_t _idle;                   // signaled when no thread is running. Waited on with _admit_lock
     char  _name [PARALLEL_SCHEDULE_NAME_LENGTH];
     char  _main_thread_name [PARALLEL_SCHEDULE_THREAD_NAME_LENGTH];
     parallel_schedule_work_parameter _work_parameters[PARALLEL_SCHEDULE_MAX_THREADS];
@@ -118,7 +154,157 @@ void *parallel_schedule_work ( parallel_schedule_work_parameter *p_parameter );
  */
 void *parallel_schedule_main_work ( parallel_schedule_work_parameter *p_parameter );
 
-// TODO: Document
+/** !
+ * Block until a task has finished a quantity of runs. A thread on its nth 
+ * iteration waits for run n of the task, so a run that finished before the 
+ * wait is never missed
+ * 
+ * @param p_task the task
+ * @param runs   the quantity of runs
+ * 
+ * @return void
+ */
+void parallel_schedule_task_wait ( parallel_schedule_task *p_task, size_t runs );
+
+/** !
+ * Count a run of a task, and wake the tasks that wait on it
+ * 
+ * @param p_task the task
+ * 
+ * @return void
+ */
+void parallel_schedule_task_finish ( parallel_schedule_task *p_task );
+
+/** !
+ * Unlock a task. Cleanup handler for a thread cancelled while it waits
+ * 
+ * @param p_task the task
+ * 
+ * @return void
+ */
+void parallel_schedule_task_unlock ( void *p_task );
+
+/** !
+ * Run a task on a thread pool, then signal each successor. A successor that no
+ * longer waits on anything is dispatched; the first one runs next on the same 
+ * thread, without a trip through the pool. The last task of a thread also 
+ * signals the first task of its thread, for the next iteration
+ * 
+ * @param p_task the task
+ * 
+ * @return null pointer
+ */
+void *parallel_schedule_task_run ( parallel_schedule_task *p_task );
+
+/** !
+ * Signal a task on a thread pool, for one iteration. Each task waits on a 
+ * signal from each task it waits on, and from the task before it in its 
+ * thread. The first task of a thread instead waits on the last task of its 
+ * thread from the iteration before, and on the iteration's admission
+ * 
+ * @param p_task    the task
+ * @param iteration the iteration
+ * 
+ * @return true if this was the task's last signal, else false
+ */
+bool parallel_schedule_task_signal ( parallel_schedule_task *p_task, size_t iteration );
+
+/** !
+ * Submit a task to the schedule's thread pool. If the pool sheds the task, 
+ * run it on the calling thread
+ * 
+ * @param p_task the task
+ * 
+ * @return void
+ */
+void parallel_schedule_task_dispatch ( parallel_schedule_task *p_task );
+
+/** !
+ * Reset the iteration state of a schedule before it starts. Admit the first 
+ * pipeline iterations, or just the first iteration if the schedule does not 
+ * repeat
+ * 
+ * @param p_schedule the schedule
+ * 
+ * @return void
+ */
+void parallel_schedule_reset ( schedule *p_schedule );
+
+/** !
+ * Block until an iteration of a schedule may start. An iteration may start 
+ * once the iteration a pipeline before it has finished on every thread. 
+ * Without a window, each thread starts its next iteration until the schedule 
+ * pauses, however far ahead of the other threads it is
+ * 
+ * @param p_schedule the schedule
+ * @param iteration  the iteration
+ * 
+ * @return true if the iteration may start, false if the schedule has stopped 
+ *         admitting iterations
+ */
+bool parallel_schedule_admit ( schedule *p_schedule, size_t iteration );
+
+/** !
+ * Is a schedule held to a window of iterations? A schedule on a thread pool 
+ * always is, with a window of one iteration if it does not set a pipeline. 
+ * Dedicated threads are only if the schedule sets a pipeline
+ * 
+ * @param p_schedule the schedule
+ * 
+ * @return true if the schedule admits iterations through a window, else false
+ */
+bool parallel_schedule_windowed ( const schedule *p_schedule );
+
+/** !
+ * Unlock a schedule's admission lock. Cleanup handler for a thread cancelled 
+ * while it waits for admission
+ * 
+ * @param p_schedule the schedule
+ * 
+ * @return void
+ */
+void parallel_schedule_admit_unlock ( void *p_schedule );
+
+/** !
+ * Count a thread that finished an iteration. The last thread to finish it 
+ * admits another iteration if the schedule repeats, or stops admitting 
+ * iterations
+ * 
+ * @param p_schedule the schedule
+ * @param iteration  the iteration
+ * 
+ * @return void
+ */
+void parallel_schedule_iteration_finish ( schedule *p_schedule, size_t iteration );
+
+/** !
+ * Drop a reference to a schedule running on a thread pool. The last reference 
+ * marks the schedule idle
+ * 
+ * @param p_schedule the schedule
+ * 
+ * @return void
+ */
+void parallel_schedule_release ( schedule *p_schedule );
+
+/** !
+ * Wake each caller of schedule_wait_idle. Called after the quantity of 
+ * running threads drops to zero
+ * 
+ * @param p_schedule the schedule
+ * 
+ * @return void
+ */
+void parallel_schedule_idle ( schedule *p_schedule );
+
+/** !
+ * Release a schedule thread, and the waits, successors, counts, lock and 
+ * condition variable of each of its tasks
+ * 
+ * @param pp_thread pointer to the schedule thread
+ * 
+ * @return 1 on success, 0 on error
+ */
 int parallel_schedule_thread_destroy ( parallel_schedule_thread **pp_thread );
 
 /**!
@@ -200,7 +386,7 @@ int parallel_schedule_thread_create ( parallel_schedule_thread **const pp_schedu
     if ( p_schedule_thread == (void *) 0 ) goto no_mem;
 
     // Zero set memory
-    memset(p_schedule_thread, 0, sizeof(parallel_schedule_thread));
+    memset(p_schedule_thread, 0, sizeof(parallel_schedule_thread) + (task_quantity * sizeof(parallel_schedule_task)));
 
     // Store the task quantity
     p_schedule_thread->task_quantity = task_quantity;
@@ -358,9 +544,13 @@ int schedule_load_as_json_value ( schedule **const pp_schedule, const json_value
     const json_value *const p_name        = dict_get(p_dict, "name"),
                      *const p_threads     = dict_get(p_dict, "threads"),
                      *const p_main_thread = dict_get(p_dict, "main thread"),
-                     *const p_repeat      = dict_get(p_dict, "repeat");
-    schedule  _schedule  = { 0 }, 
+                     *const p_repeat      = dict_get(p_dict, "repeat"),
+                     *const p_placement   = dict_get(p_dict, "placement"),
+                     *const p_pipeline    = dict_get(p_dict, "pipeline");
+    schedule  _schedule  = { .pipeline = 1 }, 
                       *p_schedule = (void *) 0;
+    const parallel_schedule_task *p_unresolved_task = (void *) 0;
+    const parallel_schedule_wait *p_unresolved_wait = (void *) 0;
 
     // Check for missing properties
     if ( ! ( p_name && p_threads ) ) goto missing_properties;
@@ -465,6 +655,49 @@ int schedule_load_as_json_value ( schedule **const pp_schedule, const json_value
 
     no_repeat_property:
 
+    // Jump ahead
+    if ( p_placement == (void *) 0 ) goto no_placement_property;
+
+    // Parse the placement property
+    if ( p_placement->type == JSON_VALUE_STRING )
+    {
+
+        // Initialized data
+        const char *const p_placement_string = p_placement->string;
+
+        // Store the placement property
+        if      ( strcmp(p_placement_string, "none")   == 0 ) _schedule.placement = PARALLEL_THREAD_PLACEMENT_NONE;
+        else if ( strcmp(p_placement_string, "pin")    == 0 ) _schedule.placement = PARALLEL_THREAD_PLACEMENT_PIN;
+        else if ( strcmp(p_placement_string, "spread") == 0 ) _schedule.placement = PARALLEL_THREAD_PLACEMENT_SPREAD;
+        else if ( strcmp(p_placement_string, "pack")   == 0 ) _schedule.placement = PARALLEL_THREAD_PLACEMENT_PACK;
+        else goto wrong_placement_value;
+    }
+
+    // Default
+    else goto wrong_placement_value;
+
+    no_placement_property:
+
+    // Jump ahead
+    if ( p_pipeline == (void *) 0 ) goto no_pipeline_property;
+
+    // Parse the pipeline property
+    if ( p_pipeline->type == JSON_VALUE_INTEGER )
+    {
+
+        // Error check
+        if ( p_pipeline->integer < 1 || p_pipeline->integer > PARALLEL_SCHEDULE_MAX_PIPELINE ) goto pipeline_out_of_range;
+
+        // Store the pipeline property
+        _schedule.pipeline  = (size_t) p_pipeline->integer;
+        _schedule.pipelined = true;
+    }
+
+    // Default
+    else goto wrong_pipeline_type;
+
+    no_pipeline_property:
+
     // Validate the schedule
     {
 
@@ -473,6 +706,9 @@ int schedule_load_as_json_value ( schedule **const pp_schedule, const json_value
         parallel_schedule_thread *_p_threads [PARALLEL_SCHEDULE_MAX_THREADS] = { 0 };
         parallel_schedule_thread *p_thread = (void *) 0;
         parallel_schedule_task   *p_task = (void *) 0;
+        parallel_schedule_task  **pp_order = (void *) 0;
+        size_t task_quantity = 0,
+               ordered       = 0;
         
         // Store the threads from the schedule
         dict_values(_schedule.p_threads, (void **)_p_threads);
@@ -491,35 +727,32 @@ int schedule_load_as_json_value ( schedule **const pp_schedule, const json_value
                 // Store the task
                 p_task = &p_thread->tasks[j];
 
-                // Will this task wait for something else?
-                if ( p_task->dependent )
+                // Iterate through each task this task waits on
+                for (size_t k = 0; k < p_task->wait_quantity; k++)
                 {
                     
                     // Initialized data
-                    parallel_schedule_thread *p_dependency_thread = dict_get(_schedule.p_threads, p_task->_wait_thread);
-
-                    // TODO: Error check
-                    if ( p_dependency_thread == (void *) 0 );
-
-                    // Iterate through each task
-                    for (size_t k = 0; k < p_dependency_thread->task_quantity; k++)
-                    {
-                        
-                        // Initialized data
-                        parallel_schedule_task *i_dependency_task = &p_dependency_thread->tasks[k];
-                        struct { char *th, *ta; } thread_task[64] = { 0 };
-
-                        // Will the task wait on this task?
-                        i_dependency_task->dependency = ( strcmp(i_dependency_task->_name, p_task->_wait_task) == 0 );
-
-                        if ( i_dependency_task->dependency )
-                        {
-                            thread_task[i].ta = p_thread->_name,
-                            thread_task[i].th = p_task->_name;
-                            i_dependency_task->dependency = true;
-                            i_dependency_task->dependencies++;
-                        }
-                    }
+                    parallel_schedule_wait   *p_wait              = &p_task->p_waits[k];
+                    parallel_schedule_thread *p_dependency_thread = (parallel_schedule_thread *) dict_get(_schedule.p_threads, p_wait->_thread);
+
+                    // Store the task and the wait for the error message
+                    p_unresolved_task = p_task;
+                    p_unresolved_wait = p_wait;
+
+                    // Error check
+                    if ( p_dependency_thread == (void *) 0 ) goto unresolved_wait;
+
+                    // Find the task to wait on
+                    for (size_t l = 0; l < p_dependency_thread->task_quantity && p_wait->p_task == (void *) 0; l++)
+                        if ( strcmp(p_dependency_thread->tasks[l]._name, p_wait->_task) == 0 )
+                            p_wait->p_task = &p_dependency_thread->tasks[l];
+
+                    // Error check
+                    if ( p_wait->p_task == (void *) 0 ) goto unresolved_wait;
+
+                    // The task signals when it finishes
+                    p_wait->p_task->dependency = true;
+                    p_wait->p_task->dependencies++;
                 }
             }
         }
@@ -531,12 +764,102 @@ int schedule_load_as_json_value ( schedule **const pp_schedule, const json_value
             // Store the thread
             p_thread = _p_threads[i];
 
+            // Count the tasks
+            task_quantity += p_thread->task_quantity;
+
+            // Count the threads that have tasks
+            if ( p_thread->task_quantity ) _schedule.tasked_thread_quantity++;
+
             // Iterate through each task
             for (size_t j = 0; j < p_thread->task_quantity; j++)
+            {
                 
                 // Store the task
-                p_task = &p_thread->tasks[j];            
+                p_task = &p_thread->tasks[j];
+
+                // The task waits on the task before it, and on its wait task
+                p_task->in_degree = ( j > 0 ) + p_task->wait_quantity;
+
+                // Allocate room for the tasks that wait on this task, and the task after it
+                p_task->pp_successors = PARALLEL_REALLOC(0, ( p_task->dependencies + 1 ) * sizeof(parallel_schedule_task *));
+
+                // Error check
+                if ( p_task->pp_successors == (void *) 0 ) goto no_mem;
+
+                // Allocate a count of signals for each iteration in flight
+                p_task->p_pending = PARALLEL_REALLOC(0, _schedule.pipeline * sizeof(atomic_size_t));
+
+                // Error check
+                if ( p_task->p_pending == (void *) 0 ) goto no_mem;
+
+                // The task after this one in its thread is a successor
+                if ( j + 1 < p_thread->task_quantity ) p_task->pp_successors[p_task->successor_quantity++] = &p_thread->tasks[j + 1];
+
+                // The first task of the next iteration follows the last task of this one
+                p_task->first = ( j == 0 );
+                if ( j + 1 == p_thread->task_quantity ) p_task->p_first = &p_thread->tasks[0];
+            }
+        }
+
+        // Allocate memory for the first task of each thread
+        _schedule.pp_firsts = PARALLEL_REALLOC(0, ( _schedule.tasked_thread_quantity + 1 ) * sizeof(parallel_schedule_task *));
+
+        // Allocate a count of finished threads for each iteration in flight
+        _schedule.p_finished = PARALLEL_REALLOC(0, _schedule.pipeline * sizeof(atomic_size_t));
+
+        // Error check
+        if ( _schedule.pp_firsts  == (void *) 0 ) goto no_mem;
+        if ( _schedule.p_finished == (void *) 0 ) goto no_mem;
+
+        // Store the first task of each thread
+        for (size_t i = 0, j = 0; i < thread_quantity; i++)
+            if ( _p_threads[i]->task_quantity ) _schedule.pp_firsts[j++] = &_p_threads[i]->tasks[0];
+
+        // Iterate over each thread
+        for (size_t i = 0; i < thread_quantity; i++)
+        {
+            
+            // Store the thread
+            p_thread = _p_threads[i];
+
+            // Each task is a successor of each task it waits on
+            for (size_t j = 0; j < p_thread->task_quantity; j++)
+                for (size_t k = 0; k < p_thread->tasks[j].wait_quantity; k++)
+                    p_thread->tasks[j].p_waits[k].p_task->pp_successors[p_thread->tasks[j].p_waits[k].p_task->successor_quantity++] = &p_thread->tasks[j];
         }
+
+        // Allocate memory for the task order. It only proves there is no cycle
+        pp_order = PARALLEL_REALLOC(0, ( task_quantity + 1 ) * sizeof(parallel_schedule_task *));
+
+        // Error check
+        if ( pp_order == (void *) 0 ) goto no_mem;
+
+        // Start with the tasks that wait on nothing
+        for (size_t i = 0; i < thread_quantity; i++)
+            for (size_t j = 0; j < _p_threads[i]->task_quantity; j++)
+            {
+
+                // Store the task
+                p_task = &_p_threads[i]->tasks[j];
+
+                // Count the tasks it waits on
+                atomic_store(&p_task->p_pending[0], p_task->in_degree);
+
+                // Ready?
+                if ( p_task->in_degree == 0 ) pp_order[ordered++] = p_task;
+            }
+
+        // Order the rest of the tasks after the tasks they wait on
+        for (size_t i = 0; i < ordered; i++)
+            for (size_t j = 0; j < pp_order[i]->successor_quantity; j++)
+                if ( atomic_fetch_sub(&pp_order[i]->pp_successors[j]->p_pending[0], 1) == 1 )
+                    pp_order[ordered++] = pp_order[i]->pp_successors[j];
+
+        // Free the task order
+        PARALLEL_FREE(pp_order);
+
+        // Error check
+        if ( ordered < task_quantity ) goto cyclic_wait;
     }
 
     // Allocate memory for a schedule
@@ -551,6 +874,29 @@ int schedule_load_as_json_value ( schedule **const pp_schedule, const json_value
     // Construct a mutex for the schedule
     mutex_create(&p_schedule->_lock);
 
+    // Construct the lock and the condition variable that admit iterations
+    pthread_mutex_init(&p_schedule->_admit_lock, NULL);
+    pthread_cond_init(&p_schedule->_admit, NULL);
+
+    // Construct the condition variable that signals the schedule is idle
+    pthread_cond_init(&p_schedule->_idle, NULL);
+
+    // Point each task back at the schedule
+    {
+
+        // Initialized data
+        size_t thread_quantity = dict_values(p_schedule->p_threads, 0);
+        parallel_schedule_thread *_p_threads [PARALLEL_SCHEDULE_MAX_THREADS] = { 0 };
+
+        // Store the threads from the schedule
+        dict_values(p_schedule->p_threads, (void **)_p_threads);
+
+        // Iterate through each task of each thread
+        for (size_t i = 0; i < thread_quantity; i++)
+            for (size_t j = 0; j < _p_threads[i]->task_quantity; j++)
+                _p_threads[i]->tasks[j].p_schedule = p_schedule;
+    }
+
     // Return a pointer to the caller
     *pp_schedule = p_schedule;
 
@@ -626,8 +972,32 @@ int schedule_load_as_json_value ( schedule **const pp_schedule, const json_value
                     log_error("[parallel] [schedule] \"repeat\" property of schedule object must be of type [ boolean ] in call to function \"%s\"\n\"Refer to schedule schema: [TODO: Schedule schema URL] \n", __FUNCTION__);
                 #endif
 
-                // Error
-                return 0;
+                // Clean up
+                goto destroy_threads;
+
+            wrong_placement_value:
+                #ifndef NDEBUG
+                    log_error("[parallel] [schedule] \"placement\" property of schedule object must be one of [ \"none\", \"pin\", \"spread\", \"pack\" ] in call to function \"%s\"\n\"Refer to schedule schema: [TODO: Schedule schema URL] \n", __FUNCTION__);
+                #endif
+
+                // Clean up
+                goto destroy_threads;
+
+            wrong_pipeline_type:
+                #ifndef NDEBUG
+                    log_error("[parallel] [schedule] \"pipeline\" property of schedule object must be of type [ integer ] in call to function \"%s\"\n\"Refer to schedule schema: [TODO: Schedule schema URL] \n", __FUNCTION__);
+                #endif
+
+                // Clean up
+                goto destroy_threads;
+
+            pipeline_out_of_range:
+                #ifndef NDEBUG
+                    log_error("[parallel] [schedule] \"pipeline\" property of schedule object must be between 1 and %d in call to function \"%s\"\n\"Refer to schedule schema: [TODO: Schedule schema URL] \n", PARALLEL_SCHEDULE_MAX_PIPELINE, __FUNCTION__);
+                #endif
+
+                // Clean up
+                goto destroy_threads;
 
             name_property_too_long:
                 #ifndef NDEBUG
@@ -686,16 +1056,74 @@ int schedule_load_as_json_value ( schedule **const pp_schedule, const json_value
                     log_error("[parallel] [schedule] Failed to allocate schedule in call to functon \"%s\"\n", __FUNCTION__);
                 #endif
 
-                // Error
-                return 0;
+                // Clean up
+                goto destroy_threads;
 
             failed_to_create_thread:
                 #ifndef NDEBUG
                     log_error("[parallel] [schedule] Failed to create scheduler thread in call to functon \"%s\"\n", __FUNCTION__);
                 #endif
 
+                // Clean up
+                goto destroy_threads;
+        }
+
+        // Schedule errors
+        {
+            unresolved_wait:
+                #ifndef NDEBUG
+                    log_error("[parallel] [schedule] Task \"%s\" waits on \"%s:%s\", which is not in schedule \"%s\" in call to function \"%s\"\n", p_unresolved_task->_name, p_unresolved_wait->_thread, p_unresolved_wait->_task, _schedule._name, __FUNCTION__);
+                #endif
+
+                // Clean up
+                goto destroy_threads;
+
+            cyclic_wait:
+                #ifndef NDEBUG
+                    log_error("[parallel] [schedule] Tasks of schedule \"%s\" wait on each other in a cycle in call to function \"%s\"\n", _schedule._name, __FUNCTION__);
+                #endif
+
+                // Clean up
+                goto destroy_threads;
+        }
+
+        // Standard library errors
+        {
+            no_mem:
+                #ifndef NDEBUG
+                    log_error("[Standard Library] Failed to allocate memory in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Clean up
+                goto destroy_threads;
+        }
+
+        // Clean up
+        {
+            destroy_threads:
+            {
+
+                // Initialized data
+                size_t thread_quantity = ( _schedule.p_threads ) ? dict_values(_schedule.p_threads, 0) : 0;
+                parallel_schedule_thread *_p_threads [PARALLEL_SCHEDULE_MAX_THREADS] = { 0 };
+
+                // Store the threads loaded so far
+                if ( thread_quantity ) dict_values(_schedule.p_threads, (void **)_p_threads);
+
+                // Release each thread
+                for (size_t i = 0; i < thread_quantity; i++)
+                    parallel_schedule_thread_destroy(&_p_threads[i]);
+
+                // Destroy the dictionary of threads
+                if ( _schedule.p_threads ) dict_destroy(&_schedule.p_threads);
+
+                // Free the first tasks, and the finished counts
+                PARALLEL_FREE(_schedule.pp_firsts);
+                PARALLEL_FREE(_schedule.p_finished);
+
                 // Error
                 return 0;
+            }
         }
     }
 }
@@ -740,6 +1168,7 @@ int parallel_schedule_thread_load_as_json_value ( parallel_schedule_thread **con
             dict *p_dict = p_ith_value->object;
             const json_value *const p_task = dict_get(p_dict, "task"),
                              *const p_wait = dict_get(p_dict, "wait");
+            size_t wait_quantity = 0;
             
             // Check for missing properties
             if ( p_task == (void *) 0 ) goto missing_properties;
@@ -777,6 +1206,10 @@ int parallel_schedule_thread_load_as_json_value ( parallel_schedule_thread **con
 
                 // Store the task function pointer
                 p_schedule_thread->tasks[i].pfn_task = pfn_task;
+
+                // Construct the lock and the condition variable the task signals
+                pthread_mutex_init(&p_schedule_thread->tasks[i]._lock, NULL);
+                pthread_cond_init(&p_schedule_thread->tasks[i]._done, NULL);
             }
 
             // Default
@@ -789,14 +1222,50 @@ int parallel_schedule_thread_load_as_json_value ( parallel_schedule_thread **con
             if ( p_wait == (void *) 0 ) continue;
 
             // Parse the wait property
-            if ( p_wait->type == JSON_VALUE_STRING )
+            if ( p_wait->type == JSON_VALUE_STRING ) wait_quantity = 1;
+
+            // An array of waits
+            else if ( p_wait->type == JSON_VALUE_ARRAY ) wait_quantity = array_size(p_wait->list);
+
+            // Default 
+            else goto wrong_task_wait_type;
+
+            // Error check
+            if ( wait_quantity < 1 ) goto wait_is_empty;
+
+            // Allocate memory for the waits
+            p_schedule_thread->tasks[i].p_waits = PARALLEL_REALLOC(0, wait_quantity * sizeof(parallel_schedule_wait));
+
+            // Error check
+            if ( p_schedule_thread->tasks[i].p_waits == (void *) 0 ) goto no_mem;
+
+            // Zero set memory
+            memset(p_schedule_thread->tasks[i].p_waits, 0, wait_quantity * sizeof(parallel_schedule_wait));
+
+            // Store the quantity of waits
+            p_schedule_thread->tasks[i].wait_quantity = wait_quantity;
+
+            // Iterate through each wait
+            for (size_t j = 0; j < wait_quantity; j++)
             {
 
                 // Initialized data
-                char *wait_thread      = p_wait->string, 
-                     *wait_task        = strchr(wait_thread, ':');
-                size_t wait_thread_len = 0,
-                       wait_task_len   = 0;
+                const json_value       *p_jth_wait = p_wait;
+                parallel_schedule_wait *p_schedule_wait = &p_schedule_thread->tasks[i].p_waits[j];
+                char   *wait_thread     = (void *) 0, 
+                       *wait_task       = (void *) 0;
+                size_t  wait_thread_len = 0,
+                        wait_task_len   = 0;
+
+                // Store the jth wait
+                if ( p_wait->type == JSON_VALUE_ARRAY ) (void) array_index(p_wait->list, j, (void **)&p_jth_wait);
+
+                // Error check
+                if ( p_jth_wait->type != JSON_VALUE_STRING ) goto wrong_task_wait_type;
+
+                // Find the delimiter
+                wait_thread = p_jth_wait->string;
+                wait_task   = strchr(wait_thread, ':');
 
                 // Error check
                 if ( wait_task == (void *) 0 ) goto no_colon_delimiter;
@@ -817,14 +1286,11 @@ int parallel_schedule_thread_load_as_json_value ( parallel_schedule_thread **con
                 if ( wait_thread_len < 1 ) goto wait_thread_too_short;
 
                 // Copy the wait thread
-                strncpy(p_schedule_thread->tasks[i]._wait_thread, wait_thread, wait_thread_len);
+                strncpy(p_schedule_wait->_thread, wait_thread, wait_thread_len);
 
                 // Copy the wait task
-                strncpy(p_schedule_thread->tasks[i]._wait_task, wait_task, wait_task_len);
+                strncpy(p_schedule_wait->_task, wait_task, wait_task_len);
             }
-
-            // Default 
-            else goto wrong_task_wait_type;
         }
 
         // Default
@@ -842,14 +1308,15 @@ int parallel_schedule_thread_load_as_json_value ( parallel_schedule_thread **con
     wrong_task_type:
     wrong_task_task_type:
     wrong_task_wait_type:
+    wait_is_empty:
     no_colon_delimiter:
     wait_task_too_long:
     wait_task_too_short:
     wait_thread_too_long:
     wait_thread_too_short:
 
-        // Error
-        return 0;
+        // Clean up
+        goto destroy_thread;
 
 
     // Error handling
@@ -901,8 +1368,8 @@ int parallel_schedule_thread_load_as_json_value ( parallel_schedule_thread **con
                     log_error("[parallel] [schedule] Unrecognized task \"%s\" was encountered while constructing therad \"%s\" in call to function \"%s\"\n", error_state, name, __FUNCTION__);
                 #endif
 
-                // Error
-                return 0;
+                // Clean up
+                goto destroy_thread;
             
             failed_to_allocate_schedule_thread:
                 #ifndef NDEBUG
@@ -912,6 +1379,28 @@ int parallel_schedule_thread_load_as_json_value ( parallel_schedule_thread **con
                 // Error
                 return 0;
         }
+
+        // Standard library errors
+        {
+            no_mem:
+                #ifndef NDEBUG
+                    log_error("[Standard Library] Failed to allocate memory in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Clean up
+                goto destroy_thread;
+        }
+
+        // Clean up
+        {
+            destroy_thread:
+
+                // Release the thread, and each task constructed so far
+                parallel_schedule_thread_destroy(&p_schedule_thread);
+
+                // Error
+                return 0;
+        }
     }   
 }
 
@@ -926,11 +1415,31 @@ int schedule_start ( schedule *const p_schedule, void *const p_parameter )
     parallel_schedule_thread *_p_threads [PARALLEL_SCHEDULE_MAX_THREADS] = { 0 };
     parallel_schedule_thread *p_main_thread = (void *)0;
     parallel_schedule_work_parameter *p_main_thread_work_parameter = (void *) 0;
+    size_t spawned_threads = 0;
     bool ready = false;
+    bool running = false;
+
+    // Lock
+    mutex_lock(&p_schedule->_lock);
+
+    // Store the running state
+    running = ( p_schedule->running_threads != 0 );
+
+    // Unlock
+    mutex_unlock(&p_schedule->_lock);
+
+    // Error check
+    if ( running ) goto schedule_running;
 
     // Store the parameter
     p_schedule->p_parameter = p_parameter;
 
+    // Run on dedicated threads
+    p_schedule->p_thread_pool = (void *) 0;
+
+    // Reset the iterations, since each thread counts its iterations from zero
+    parallel_schedule_reset(p_schedule);
+
     // Store the threads from the schedule
     dict_values(p_schedule->p_threads, (void **)_p_threads);
 
@@ -962,8 +1471,8 @@ int schedule_start ( schedule *const p_schedule, void *const p_parameter )
             continue;
         }
         
-        // Spawn the thread
-        if ( parallel_thread_start(&p_thread->p_parallel_thread, (fn_parallel_task *) parallel_schedule_work, &p_schedule->_work_parameters[i]) == 0 ) goto failed_to_create_thread;
+        // Spawn the thread on the CPU the placement policy chooses
+        if ( parallel_thread_start_with_affinity(&p_thread->p_parallel_thread, (fn_parallel_task *) parallel_schedule_work, &p_schedule->_work_parameters[i], parallel_thread_placement_cpu(p_schedule->placement, spawned_threads++)) == 0 ) goto failed_to_create_thread;
     }
     
     // Start the main thread
@@ -1007,24 +1516,208 @@ int schedule_start ( schedule *const p_schedule, void *const p_parameter )
                 return 0;
         }
 
-        // Parallel errors
+        // Schedule errors
         {
-            failed_to_create_thread:
+            schedule_running:
                 #ifndef NDEBUG
-                    log_error("[parallel] [schedule] Failed to spawn thread in call to function \"%s\"\n", __FUNCTION__);
+                    log_error("[parallel] [schedule] Schedule \"%s\" is already running in call to function \"%s\"\n", p_schedule->_name, __FUNCTION__);
                 #endif
 
                 // Error
                 return 0;
         }
-    }
-}
+
+        // Parallel errors
+        {
+            failed_to_create_thread:
+                #ifndef NDEBUG
+                    log_error("[parallel] [schedule] Failed to spawn thread in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+int schedule_start_on_thread_pool ( schedule *const p_schedule, thread_pool *const p_thread_pool, void *const p_parameter )
+{
+
+    // Argument check
+    if ( p_schedule    == (void *) 0 ) goto no_schedule;
+    if ( p_thread_pool == (void *) 0 ) goto no_thread_pool;
+
+    // Initialized data
+    size_t admitted = 0;
+    bool running = false;
+
+    // Nothing to run
+    if ( p_schedule->tasked_thread_quantity == 0 ) return 1;
+
+    // Lock
+    mutex_lock(&p_schedule->_lock);
+
+    // Store the running state
+    running = ( p_schedule->running_threads != 0 );
+
+    // The schedule runs until its last iteration finishes
+    if ( running == false ) p_schedule->running_threads++;
+
+    // Unlock
+    mutex_unlock(&p_schedule->_lock);
+
+    // Error check
+    if ( running ) goto schedule_running;
+
+    // Store the parameter
+    p_schedule->p_parameter = p_parameter;
+
+    // Store the thread pool
+    p_schedule->p_thread_pool = p_thread_pool;
+
+    // Reset the iterations
+    parallel_schedule_reset(p_schedule);
+
+    // Store the iterations the reset admitted
+    admitted = atomic_load(&p_schedule->admitted);
+
+    // Hold a reference until the last iteration finishes
+    atomic_store(&p_schedule->busy, 1);
+
+    // Admit each iteration the reset admitted
+    for (size_t i = 0; i < admitted; i++)
+        for (size_t j = 0; j < p_schedule->tasked_thread_quantity; j++)
+            if ( parallel_schedule_task_signal(p_schedule->pp_firsts[j], i) )
+                parallel_schedule_task_dispatch(p_schedule->pp_firsts[j]);
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_schedule:
+                #ifndef NDEBUG
+                    log_error("[parallel] [schedule] Null pointer provided for parameter \"p_schedule\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            no_thread_pool:
+                #ifndef NDEBUG
+                    log_error("[parallel] [schedule] Null pointer provided for parameter \"p_thread_pool\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+
+        // Schedule errors
+        {
+            schedule_running:
+                #ifndef NDEBUG
+                    log_error("[parallel] [schedule] Schedule \"%s\" is already running in call to function \"%s\"\n", p_schedule->_name, __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+int schedule_get_placement ( schedule *const p_schedule, const char *const thread_name, int *const p_cpu, int *const p_node )
+{
+
+    // Argument check
+    if ( p_schedule  == (void *) 0 ) goto no_schedule;
+    if ( thread_name == (void *) 0 ) goto no_thread_name;
+
+    // Initialized data
+    parallel_schedule_thread *p_thread = (parallel_schedule_thread *) dict_get(p_schedule->p_threads, thread_name);
+
+    // Error check
+    if ( p_thread == (void *) 0 ) goto no_such_thread;
+
+    // The main thread, and threads that are not running, are not placed
+    if ( p_thread->p_parallel_thread == (void *) 0 )
+    {
+
+        // Return -1 to the caller
+        if ( p_cpu  ) *p_cpu  = -1;
+        if ( p_node ) *p_node = -1;
+
+        // Success
+        return 1;
+    }
+
+    // Success
+    return parallel_thread_get_affinity(p_thread->p_parallel_thread, p_cpu, p_node);
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_schedule:
+                #ifndef NDEBUG
+                    log_error("[parallel] [schedule] Null pointer provided for parameter \"p_schedule\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            no_thread_name:
+                #ifndef NDEBUG
+                    log_error("[parallel] [schedule] Null pointer provided for parameter \"thread_name\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+
+        // Schedule errors
+        {
+            no_such_thread:
+                #ifndef NDEBUG
+                    log_error("[parallel] [schedule] Schedule \"%s\" has no thread named \"%s\" in call to function \"%s\"\n", p_schedule->_name, thread_name, __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
 
 int schedule_wait_idle ( schedule *const p_schedule )
 {
-    
-    // Spin until all threads are done
-    while (p_schedule->running_threads) sleep(0);
+
+    // Initialized data
+    size_t running_threads = 0;
+
+    // Lock
+    pthread_mutex_lock(&p_schedule->_admit_lock);
+
+    // Sleep until all threads are done
+    for (;;)
+    {
+
+        // Store the quantity of running threads
+        mutex_lock(&p_schedule->_lock);
+        running_threads = p_schedule->running_threads;
+        mutex_unlock(&p_schedule->_lock);
+
+        // Done?
+        if ( running_threads == 0 ) break;
+
+        // Wait for the last thread to stop
+        pthread_cond_wait(&p_schedule->_idle, &p_schedule->_admit_lock);
+    }
+
+    // Unlock
+    pthread_mutex_unlock(&p_schedule->_admit_lock);
 
     // Success
     return 1;
@@ -1033,9 +1726,15 @@ int schedule_wait_idle ( schedule *const p_schedule )
 int schedule_pause ( schedule *const p_schedule )
 {
 
+    // Lock
+    pthread_mutex_lock(&p_schedule->_admit_lock);
+
     // Clear the repeat flag
     p_schedule->repeat = false;
 
+    // Unlock
+    pthread_mutex_unlock(&p_schedule->_admit_lock);
+
     // Success
     return 1;
 } 
@@ -1049,9 +1748,24 @@ int schedule_stop ( schedule *const p_schedule )
     // Initialized data
     size_t thread_quantity = dict_values(p_schedule->p_threads, 0);
     parallel_schedule_thread *_p_threads[PARALLEL_SCHEDULE_MAX_THREADS] = { 0 };
+    bool idle = false;
 
     // Clear the repeat flag
-    p_schedule->repeat = false;
+    schedule_pause(p_schedule);
+
+    // Running on a thread pool?
+    if ( p_schedule->p_thread_pool )
+    {
+
+        // Jobs can't be cancelled, so wait for the last iteration
+        schedule_wait_idle(p_schedule);
+
+        // Detach the thread pool
+        p_schedule->p_thread_pool = (void *) 0;
+
+        // Success
+        return 1;
+    }
 
     // Store the threads from the schedule
     dict_values(p_schedule->p_threads, (void **)_p_threads);
@@ -1074,7 +1788,22 @@ int schedule_stop ( schedule *const p_schedule )
 
         // Join the thread
         if ( parallel_thread_join(&p_thread->p_parallel_thread) == 0 ) goto failed_to_destroy_thread;
+
+        // Lock
+        mutex_lock(&p_schedule->_lock);
+
+        // A thread cancelled before it stopped is no longer running
+        if ( p_thread->running ) idle = ( --p_schedule->running_threads == 0 );
+
+        // Clear the running flag
+        p_thread->running = false;
+
+        // Unlock
+        mutex_unlock(&p_schedule->_lock);
     }
+
+    // Wake the callers of schedule_wait_idle
+    if ( idle ) parallel_schedule_idle(p_schedule);
     
     // Success
     return 1;
@@ -1109,11 +1838,63 @@ int schedule_stop ( schedule *const p_schedule )
 int schedule_destroy ( schedule **const pp_schedule )
 {
 
-    // TODO
-    //
+    // Argument check
+    if ( pp_schedule  == (void *) 0 ) goto no_schedule;
+    if ( *pp_schedule == (void *) 0 ) goto no_schedule;
+
+    // Initialized data
+    schedule *p_schedule = *pp_schedule;
+    size_t thread_quantity = ( p_schedule->p_threads ) ? dict_values(p_schedule->p_threads, 0) : 0;
+    parallel_schedule_thread *_p_threads [PARALLEL_SCHEDULE_MAX_THREADS] = { 0 };
+
+    // No more pointer for caller
+    *pp_schedule = (void *) 0;
+
+    // Store the threads
+    if ( thread_quantity ) dict_values(p_schedule->p_threads, (void **)_p_threads);
+
+    // Release each thread
+    for (size_t i = 0; i < thread_quantity; i++)
+        parallel_schedule_thread_destroy(&_p_threads[i]);
+
+    // Destroy the dictionary of threads
+    if ( p_schedule->p_threads ) dict_destroy(&p_schedule->p_threads);
+
+    // Free the first tasks, and the finished counts
+    PARALLEL_FREE(p_schedule->pp_firsts);
+    PARALLEL_FREE(p_schedule->p_finished);
+
+    // Destroy the lock and the condition variables that admit iterations
+    pthread_cond_destroy(&p_schedule->_idle);
+    pthread_cond_destroy(&p_schedule->_admit);
+    pthread_mutex_destroy(&p_schedule->_admit_lock);
+
+    // Destroy the mutex
+    mutex_destroy(&p_schedule->_lock);
+
+    // Destroy the monitor
+    monitor_destroy(&p_schedule->_montior);
+
+    // Release the schedule
+    PARALLEL_FREE(p_schedule);
 
     // Success
     return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_schedule:
+                #ifndef NDEBUG
+                    log_error("[parallel] [schedule] Null pointer provided for parameter \"pp_schedule\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
 }
 
 void *parallel_schedule_work ( parallel_schedule_work_parameter *p_parameter )
@@ -1126,7 +1907,12 @@ void *parallel_schedule_work ( parallel_schedule_work_parameter *p_parameter )
     schedule        *p_schedule        = p_parameter->p_schedule;
     parallel_schedule_thread *p_schedule_thread = p_parameter->p_thread;
     parallel_schedule_task   *i_task            = (void *) 0;
+    size_t                    iteration         = 0;
+    bool                      idle              = false;
     
+    // Name the thread's track in a trace
+    parallel_trace_name_thread(p_schedule_thread->_name);
+
     // Lock
     mutex_lock(&p_schedule->_lock);
 
@@ -1144,6 +1930,9 @@ void *parallel_schedule_work ( parallel_schedule_work_parameter *p_parameter )
 
     turnover:
 
+    // Wait for the iteration to be admitted. A thread without tasks has nothing to run
+    if ( p_schedule_thread->task_quantity == 0 || parallel_schedule_admit(p_schedule, iteration) == false ) goto stopped;
+
     // Iterate through each task
     for (size_t i = 0; i < p_schedule_thread->task_quantity; i++)
     {
@@ -1151,21 +1940,35 @@ void *parallel_schedule_work ( parallel_schedule_work_parameter *p_parameter )
         // Initialized data
         i_task = &p_schedule_thread->tasks[i];
 
-        // Wait
-        if ( i_task->dependent ) goto wait_logic;
+        // Wait for this iteration's run of each task this task depends on
+        for (size_t j = 0; j < i_task->wait_quantity; j++)
+        {
 
-        // Done waiting
-        done:
+            // Wait
+            PARALLEL_TRACE_BEGIN("wait", i_task->p_waits[j]._task, (void *) 0);
+            parallel_schedule_task_wait(i_task->p_waits[j].p_task, iteration + 1);
+            PARALLEL_TRACE_END("wait", i_task->p_waits[j]._task, (void *) 0);
+        }
 
         // Run the task
+        PARALLEL_TRACE_BEGIN(i_task->_name, (void *) 0, (const void *) i_task->pfn_task);
         i_task->pfn_task(p_parameter->p_schedule->p_parameter);
+        PARALLEL_TRACE_END(i_task->_name, (void *) 0, (const void *) i_task->pfn_task);
         
         // Signal
-        if ( i_task->dependency ) monitor_notify_all(&i_task->_monitor);
+        if ( i_task->dependency ) parallel_schedule_task_finish(i_task);
     }
+
+    // The thread finished the iteration
+    parallel_schedule_iteration_finish(p_schedule, iteration);
+
+    // Count the iteration
+    iteration++;
     
-    // Repeat?
-    if ( p_schedule->repeat ) goto turnover;
+    // Next iteration
+    goto turnover;
+
+    stopped:
 
     // Lock
     mutex_lock(&p_schedule->_lock);
@@ -1174,41 +1977,17 @@ void *parallel_schedule_work ( parallel_schedule_work_parameter *p_parameter )
     p_schedule_thread->running = false;
 
     // Decrement the quantity of running threads
-    p_schedule->running_threads--;
+    idle = ( --p_schedule->running_threads == 0 );
 
     // Unlock
     mutex_unlock(&p_schedule->_lock);
 
+    // The last thread wakes the callers of schedule_wait_idle
+    if ( idle ) parallel_schedule_idle(p_schedule);
+
     // Success
     return (void *) 1;
 
-    wait_logic:
-    {
-
-        // Initialized data
-        char *thread_name = i_task->_wait_thread;
-        const parallel_schedule_thread *const p_schedule_thread = dict_get(p_schedule->p_threads, thread_name);
-        
-        // Find the monitor 
-        for (size_t i = 0; i < p_schedule_thread->task_quantity; i++)
-        {
-        
-            // Check the monitor
-            if ( strcmp(p_schedule_thread->tasks[i]._name, i_task->_wait_task) == 0 ) 
-            {
-
-                // Wait
-                monitor_wait(&p_schedule_thread->tasks[i]._monitor);
-
-                // Done
-                goto done;
-            }
-        }
-
-        // Default
-        goto failed_to_find_monitor;
-    }
-
     // Error handling
     {
 
@@ -1222,17 +2001,6 @@ void *parallel_schedule_work ( parallel_schedule_work_parameter *p_parameter )
                 // Error
                 return 0;
         }
-
-        // Parallel errors
-        {
-            failed_to_find_monitor:
-                #ifndef NDEBUG
-                    log_error("[parallel] [schedule] Failed to find monitor for dependant task on thread\"%s\" in call to function \"%s\"\n", p_schedule_thread->_name, __FUNCTION__);
-                #endif
-
-                // Error
-                return 0;
-        }
     }
 }
 
@@ -1246,7 +2014,12 @@ void *parallel_schedule_main_work ( parallel_schedule_work_parameter *p_paramete
     schedule        *p_schedule        = p_parameter->p_schedule;
     parallel_schedule_thread *p_schedule_thread = p_parameter->p_thread;
     parallel_schedule_task   *i_task            = (void *) 0;
+    size_t                    iteration         = 0;
+    bool                      idle              = false;
     
+    // Name the thread's track in a trace
+    parallel_trace_name_thread(p_schedule_thread->_name);
+
     // Lock
     mutex_lock(&p_schedule->_lock);
 
@@ -1264,6 +2037,9 @@ void *parallel_schedule_main_work ( parallel_schedule_work_parameter *p_paramete
     
     turnover:
 
+    // Wait for the iteration to be admitted. A thread without tasks has nothing to run
+    if ( p_schedule_thread->task_quantity == 0 || parallel_schedule_admit(p_schedule, iteration) == false ) goto stopped;
+
     // Iterate through each task
     for (size_t i = 0; i < p_schedule_thread->task_quantity; i++)
     {
@@ -1271,21 +2047,35 @@ void *parallel_schedule_main_work ( parallel_schedule_work_parameter *p_paramete
         // Initialized data
         i_task = &p_schedule_thread->tasks[i];
 
-        // Wait
-        if ( i_task->dependent ) goto wait_logic;
+        // Wait for this iteration's run of each task this task depends on
+        for (size_t j = 0; j < i_task->wait_quantity; j++)
+        {
 
-        // Done waiting
-        done:
+            // Wait
+            PARALLEL_TRACE_BEGIN("wait", i_task->p_waits[j]._task, (void *) 0);
+            parallel_schedule_task_wait(i_task->p_waits[j].p_task, iteration + 1);
+            PARALLEL_TRACE_END("wait", i_task->p_waits[j]._task, (void *) 0);
+        }
 
         // Run the task
+        PARALLEL_TRACE_BEGIN(i_task->_name, (void *) 0, (const void *) i_task->pfn_task);
         i_task->pfn_task(p_parameter->p_schedule->p_parameter);
+        PARALLEL_TRACE_END(i_task->_name, (void *) 0, (const void *) i_task->pfn_task);
         
         // Signal
-        if ( i_task->dependency ) monitor_notify_all(&i_task->_monitor);
+        if ( i_task->dependency ) parallel_schedule_task_finish(i_task);
     }
+
+    // The thread finished the iteration
+    parallel_schedule_iteration_finish(p_schedule, iteration);
+
+    // Count the iteration
+    iteration++;
     
-    // Repeat?
-    if ( p_schedule->repeat ) goto turnover;
+    // Next iteration
+    goto turnover;
+
+    stopped:
 
     // Lock
     mutex_lock(&p_schedule->_lock);
@@ -1294,60 +2084,417 @@ void *parallel_schedule_main_work ( parallel_schedule_work_parameter *p_paramete
     p_schedule_thread->running = false;
 
     // Decrement the quantity of running threads
-    p_schedule->running_threads--;
+    idle = ( --p_schedule->running_threads == 0 );
 
     // Unlock
     mutex_unlock(&p_schedule->_lock);
 
+    // The last thread wakes the callers of schedule_wait_idle
+    if ( idle ) parallel_schedule_idle(p_schedule);
+
     // Success
     return (void *) 1;
 
-    wait_logic:
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_work_parameter:
+                #ifndef NDEBUG
+                    log_error("[parallel] [schedule] Null pointer provided for parameter \"p_parameter\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+void parallel_schedule_task_wait ( parallel_schedule_task *p_task, size_t runs )
+{
+
+    // Fast path; the run is already done
+    if ( atomic_load_explicit(&p_task->runs, memory_order_acquire) >= runs ) return;
+
+    // Lock
+    pthread_mutex_lock(&p_task->_lock);
+
+    // Release the lock if schedule_stop cancels the thread while it waits
+    pthread_cleanup_push(parallel_schedule_task_unlock, p_task);
+
+    // Wait for the run
+    while ( atomic_load_explicit(&p_task->runs, memory_order_acquire) < runs )
+        pthread_cond_wait(&p_task->_done, &p_task->_lock);
+
+    // Unlock
+    pthread_cleanup_pop(1);
+
+    // Done
+    return;
+}
+
+void parallel_schedule_task_finish ( parallel_schedule_task *p_task )
+{
+
+    // Lock
+    pthread_mutex_lock(&p_task->_lock);
+
+    // Count the run. Only the task's own thread writes this
+    atomic_store_explicit(&p_task->runs, atomic_load_explicit(&p_task->runs, memory_order_relaxed) + 1, memory_order_release);
+
+    // Wake every waiter
+    pthread_cond_broadcast(&p_task->_done);
+
+    // Unlock
+    pthread_mutex_unlock(&p_task->_lock);
+
+    // Done
+    return;
+}
+
+void parallel_schedule_task_unlock ( void *p_task )
+{
+
+    // Unlock
+    pthread_mutex_unlock(&((parallel_schedule_task *) p_task)->_lock);
+
+    // Done
+    return;
+}
+
+void *parallel_schedule_task_run ( parallel_schedule_task *p_task )
+{
+
+    // Initialized data
+    schedule *p_schedule = p_task->p_schedule;
+
+    // Run tasks until no successor is ready
+    while ( p_task )
     {
 
         // Initialized data
-        char *thread_name = i_task->_wait_thread;
-        parallel_schedule_thread *const p_schedule_thread_wait = dict_get(p_schedule->p_threads, thread_name);
-        
-        // Find the monitor 
-        for (size_t i = 0; i < p_schedule_thread_wait->task_quantity; i++)
+        parallel_schedule_task *p_next    = (void *) 0;
+        size_t                  iteration = atomic_load_explicit(&p_task->runs, memory_order_relaxed);
+
+        // Run the task
+        PARALLEL_TRACE_BEGIN(p_task->_name, (void *) 0, (const void *) p_task->pfn_task);
+        p_task->pfn_task(p_schedule->p_parameter);
+        PARALLEL_TRACE_END(p_task->_name, (void *) 0, (const void *) p_task->pfn_task);
+
+        // Count the run. The next run is dispatched after this one, so this is the next run's iteration
+        atomic_store_explicit(&p_task->runs, iteration + 1, memory_order_relaxed);
+
+        // Signal each successor
+        for (size_t i = 0; i < p_task->successor_quantity; i++)
+            if ( parallel_schedule_task_signal(p_task->pp_successors[i], iteration) )
+            {
+
+                // Run the first one on this thread, next
+                if ( p_next == (void *) 0 ) p_next = p_task->pp_successors[i];
+
+                // Dispatch the rest
+                else parallel_schedule_task_dispatch(p_task->pp_successors[i]);
+            }
+
+        // Last task of its thread?
+        if ( p_task->p_first )
         {
-        
-            // Check the monitor
-            if ( strcmp(p_schedule_thread_wait->tasks[i]._name, i_task->_wait_task) == 0 ) 
+
+            // The thread finished the iteration
+            parallel_schedule_iteration_finish(p_schedule, iteration);
+
+            // Signal the first task of the thread, for the next iteration
+            if ( parallel_schedule_task_signal(p_task->p_first, iteration + 1) )
             {
 
-                // Wait
-                monitor_wait(&p_schedule_thread_wait->tasks[i]._monitor);
+                // Run it on this thread, next
+                if ( p_next == (void *) 0 ) p_next = p_task->p_first;
 
-                // Done
-                goto done;
+                // Dispatch it
+                else parallel_schedule_task_dispatch(p_task->p_first);
             }
         }
 
-        // Default
-        goto failed_to_find_monitor;
+        // Next
+        p_task = p_next;
     }
 
-    // Error handling
+    // Drop the job's reference
+    parallel_schedule_release(p_schedule);
+
+    // Done
+    return (void *) 0;
+}
+
+bool parallel_schedule_task_signal ( parallel_schedule_task *p_task, size_t iteration )
+{
+
+    // Initialized data
+    atomic_size_t *p_pending = &p_task->p_pending[iteration % p_task->p_schedule->pipeline];
+
+    // Wait for the rest of the signals
+    if ( atomic_fetch_sub(p_pending, 1) != 1 ) return false;
+
+    // Reuse the count for the iteration a pipeline later. Nothing can signal 
+    // that iteration until this one runs
+    atomic_store_explicit(p_pending, p_task->in_degree + ( p_task->first ? 2 : 0 ), memory_order_relaxed);
+
+    // Success
+    return true;
+}
+
+void parallel_schedule_task_dispatch ( parallel_schedule_task *p_task )
+{
+
+    // Take a reference for the job
+    atomic_fetch_add(&p_task->p_schedule->busy, 1);
+
+    // Submit the task, or run it here if the pool sheds it
+    if ( thread_pool_execute(p_task->p_schedule->p_thread_pool, (fn_parallel_task *) parallel_schedule_task_run, p_task) == 0 )
+        parallel_schedule_task_run(p_task);
+
+    // Done
+    return;
+}
+
+void parallel_schedule_reset ( schedule *p_schedule )
+{
+
+    // Initialized data
+    size_t thread_quantity = dict_values(p_schedule->p_threads, 0);
+    parallel_schedule_thread *_p_threads [PARALLEL_SCHEDULE_MAX_THREADS] = { 0 };
+
+    // Store the threads from the schedule
+    dict_values(p_schedule->p_threads, (void **)_p_threads);
+
+    // Iterate through each thread
+    for (size_t i = 0; i < thread_quantity; i++)
     {
 
-        // Argument errors
+        // Iterate through each task of the thread
+        for (size_t k = 0; k < _p_threads[i]->task_quantity; k++)
         {
-            no_work_parameter:
-                #ifndef NDEBUG
-                    log_error("[parallel] [schedule] Null pointer provided for parameter \"p_parameter\" in call to function \"%s\"\n", __FUNCTION__);
-                #endif
 
-                // Error
-                return 0;
+            // Initialized data
+            parallel_schedule_task *p_task = &_p_threads[i]->tasks[k];
+
+            // Count runs from zero
+            atomic_store(&p_task->runs, 0);
+
+            // Count the signals of each iteration in flight
+            for (size_t j = 0; j < p_schedule->pipeline; j++)
+                atomic_store(&p_task->p_pending[j], p_task->in_degree + ( p_task->first ? 2 : 0 ));
+
+            // The first iteration does not wait on an iteration before it
+            if ( p_task->first ) atomic_store(&p_task->p_pending[0], p_task->in_degree + 1);
         }
+    }
 
-        // Parallel errors
+    // No thread has finished an iteration
+    for (size_t i = 0; i < p_schedule->pipeline; i++)
+        atomic_store(&p_schedule->p_finished[i], 0);
+
+    // Admit a pipeline of iterations, or just one
+    atomic_store(&p_schedule->admitted, ( p_schedule->repeat ) ? p_schedule->pipeline : 1);
+
+    // Admit more iterations if the schedule repeats
+    p_schedule->closed = !p_schedule->repeat;
+
+    // Done
+    return;
+}
+
+bool parallel_schedule_admit ( schedule *p_schedule, size_t iteration )
+{
+
+    // Initialized data
+    bool admitted = false;
+
+    // Without a window, a thread runs the first iteration, then repeats until the schedule pauses
+    if ( parallel_schedule_windowed(p_schedule) == false ) return iteration == 0 || p_schedule->repeat;
+
+    // Fast path; the iteration is already admitted
+    if ( iteration < atomic_load(&p_schedule->admitted) ) return true;
+
+    // Lock
+    pthread_mutex_lock(&p_schedule->_admit_lock);
+
+    // Release the lock if schedule_stop cancels the thread while it waits
+    pthread_cleanup_push(parallel_schedule_admit_unlock, p_schedule);
+
+    // Wait for the iteration, or for the schedule to stop admitting iterations
+    while ( iteration >= atomic_load(&p_schedule->admitted) && p_schedule->closed == false )
+        pthread_cond_wait(&p_schedule->_admit, &p_schedule->_admit_lock);
+
+    // Store the result
+    admitted = ( iteration < atomic_load(&p_schedule->admitted) );
+
+    // Unlock
+    pthread_cleanup_pop(1);
+
+    // Done
+    return admitted;
+}
+
+bool parallel_schedule_windowed ( const schedule *p_schedule )
+{
+
+    // Done
+    return p_schedule->pipelined || p_schedule->p_thread_pool;
+}
+
+void parallel_schedule_admit_unlock ( void *p_schedule )
+{
+
+    // Unlock
+    pthread_mutex_unlock(&((schedule *) p_schedule)->_admit_lock);
+
+    // Done
+    return;
+}
+
+void parallel_schedule_iteration_finish ( schedule *p_schedule, size_t iteration )
+{
+
+    // Without a window, finishing an iteration admits nothing
+    if ( parallel_schedule_windowed(p_schedule) == false ) return;
+
+    // Initialized data
+    atomic_size_t *p_finished = &p_schedule->p_finished[iteration % p_schedule->pipeline];
+    size_t         next       = 0;
+    bool           admit      = false,
+                   last       = false;
+
+    // Wait for the rest of the threads
+    if ( atomic_fetch_add(p_finished, 1) + 1 < p_schedule->tasked_thread_quantity ) return;
+
+    // Reuse the count for the iteration a pipeline later
+    atomic_store(p_finished, 0);
+
+    // Lock
+    pthread_mutex_lock(&p_schedule->_admit_lock);
+
+    // Stop admitting iterations once the repeat flag is clear
+    if ( p_schedule->repeat == false ) p_schedule->closed = true;
+
+    // Admit another iteration
+    if ( p_schedule->closed == false ) next = atomic_fetch_add(&p_schedule->admitted, 1), admit = true;
+
+    // Was this the last iteration?
+    else last = ( iteration + 1 == atomic_load(&p_schedule->admitted) );
+
+    // Wake the threads waiting for admission
+    pthread_cond_broadcast(&p_schedule->_admit);
+
+    // Unlock
+    pthread_mutex_unlock(&p_schedule->_admit_lock);
+
+    // Dedicated threads admit themselves
+    if ( p_schedule->p_thread_pool == (void *) 0 ) return;
+
+    // Signal the first task of each thread, for the admitted iteration
+    if ( admit )
+        for (size_t i = 0; i < p_schedule->tasked_thread_quantity; i++)
+            if ( parallel_schedule_task_signal(p_schedule->pp_firsts[i], next) )
+                parallel_schedule_task_dispatch(p_schedule->pp_firsts[i]);
+
+    // Drop the reference the schedule held until its last iteration
+    if ( last ) parallel_schedule_release(p_schedule);
+
+    // Done
+    return;
+}
+
+void parallel_schedule_release ( schedule *p_schedule )
+{
+
+    // Not the last reference?
+    if ( atomic_fetch_sub(&p_schedule->busy, 1) != 1 ) return;
+
+    // Initialized data
+    bool idle = false;
+
+    // Lock
+    mutex_lock(&p_schedule->_lock);
+
+    // The schedule is idle
+    idle = ( --p_schedule->running_threads == 0 );
+
+    // Unlock
+    mutex_unlock(&p_schedule->_lock);
+
+    // Wake the callers of schedule_wait_idle
+    if ( idle ) parallel_schedule_idle(p_schedule);
+
+    // Done
+    return;
+}
+
+void parallel_schedule_idle ( schedule *p_schedule )
+{
+
+    // Lock
+    pthread_mutex_lock(&p_schedule->_admit_lock);
+
+    // Wake the waiters. A waiter reads the quantity of running threads while
+    // it holds this lock, so the wakeup can't land between its check and its wait
+    pthread_cond_broadcast(&p_schedule->_idle);
+
+    // Unlock
+    pthread_mutex_unlock(&p_schedule->_admit_lock);
+
+    // Done
+    return;
+}
+
+int parallel_schedule_thread_destroy ( parallel_schedule_thread **pp_thread )
+{
+
+    // Argument check
+    if ( pp_thread  == (void *) 0 ) goto no_thread;
+    if ( *pp_thread == (void *) 0 ) goto no_thread;
+
+    // Initialized data
+    parallel_schedule_thread *p_thread = *pp_thread;
+
+    // No more pointer for caller
+    *pp_thread = (void *) 0;
+
+    // Iterate through each task
+    for (size_t i = 0; i < p_thread->task_quantity; i++)
+    {
+
+        // Initialized data
+        parallel_schedule_task *p_task = &p_thread->tasks[i];
+
+        // A task without a function was never constructed
+        if ( p_task->pfn_task == (void *) 0 ) continue;
+
+        // Destroy the lock and the condition variable
+        pthread_cond_destroy(&p_task->_done);
+        pthread_mutex_destroy(&p_task->_lock);
+
+        // Free the waits, the successors, and the counts
+        PARALLEL_FREE(p_task->p_waits);
+        PARALLEL_FREE(p_task->pp_successors);
+        PARALLEL_FREE(p_task->p_pending);
+    }
+
+    // Free the schedule thread
+    PARALLEL_FREE(p_thread);
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
         {
-            failed_to_find_monitor:
+            no_thread:
                 #ifndef NDEBUG
-                    log_error("[parallel] [schedule] Failed to find monitor for dependant task on thread\"%s\" in call to function \"%s\"\n", p_schedule_thread->_name, __FUNCTION__);
+                    log_error("[parallel] [schedule] Null pointer provided for parameter \"pp_thread\" in call to function \"%s\"\n", __FUNCTION__);
                 #endif
 
                 // Error
@@ -1356,8 +2503,6 @@ void *parallel_schedule_main_work ( parallel_schedule_work_parameter *p_paramete
     }
 }
 
-int parallel_schedule_thread_destroy ( parallel_schedule_thread **pp_thread );
-
 size_t load_file ( const char *path, void *buffer, bool binary_mode )
 {
 
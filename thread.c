@@ -6,10 +6,118 @@
  * @author Jacob Smith
  */
 
+// Feature test macros
+#ifndef _GNU_SOURCE
+    #define _GNU_SOURCE
+#endif
+
+// Standard library
+#ifndef _WIN64
+    #include <sched.h>
+    #include <stdint.h>
+    #include <dirent.h>
+#endif
+
 // parallel
 #include <parallel/parallel.h>
 #include <parallel/thread.h>
 
+// Preprocessor definitions
+#define PARALLEL_THREAD_MAX_CPUS  1024
+#define PARALLEL_THREAD_SYSFS_CPU "/sys/devices/system/cpu"
+#define PARALLEL_THREAD_SYSFS_NODE "/sys/devices/system/node"
+
+// Forward declarations
+struct parallel_thread_topology_s;
+struct parallel_thread_topology_cpu_s;
+
+// Type definitions
+typedef struct parallel_thread_topology_s     parallel_thread_topology;
+typedef struct parallel_thread_topology_cpu_s parallel_thread_topology_cpu;
+
+// Structure definitions
+struct parallel_thread_topology_cpu_s
+{
+    int cpu, package, core, node, sibling, rank;
+};
+
+struct parallel_thread_topology_s
+{
+    size_t cpu_quantity;
+    int    _pin[PARALLEL_THREAD_MAX_CPUS],
+           _spread[PARALLEL_THREAD_MAX_CPUS],
+           _pack[PARALLEL_THREAD_MAX_CPUS],
+           _node[PARALLEL_THREAD_MAX_CPUS];
+};
+
+// Data
+static parallel_thread_topology _topology = { 0 };
+#ifndef _WIN64
+    static pthread_once_t topology_once = PTHREAD_ONCE_INIT;
+#endif
+
+// Function declarations
+/** !
+ * Read the CPU topology from sysfs, and order the CPUs for each placement 
+ * policy. Runs once
+ *
+ * @param void
+ *
+ * @return void
+ */
+void parallel_thread_topology_load ( void );
+
+/** !
+ * Read one integer from a sysfs file
+ *
+ * @param path    the path of the file
+ * @param default_value the value to return if the file can't be read
+ *
+ * @return the integer
+ */
+int parallel_thread_sysfs_int ( const char *path, int default_value );
+
+/** !
+ * Parse a sysfs CPU list, like "0-3,8,10-11", and call a function for each CPU
+ *
+ * @param path       the path of the file
+ * @param pfn_cpu    called once per CPU
+ * @param p_context  passed to pfn_cpu
+ *
+ * @return 1 on success, 0 if the file can't be read
+ */
+int parallel_thread_sysfs_cpu_list ( const char *path, void (*pfn_cpu)(int cpu, void *p_context), void *p_context );
+
+/** !
+ * Store the NUMA node of a CPU
+ *
+ * @param cpu       the CPU
+ * @param p_context the NUMA node
+ *
+ * @return void
+ */
+void parallel_thread_topology_set_node ( int cpu, void *p_context );
+
+/** !
+ * Order CPUs to spread threads across cores and NUMA nodes
+ *
+ * @param p_a pointer to a parallel_thread_topology_cpu
+ * @param p_b pointer to a parallel_thread_topology_cpu
+ *
+ * @return a negative, zero, or positive value, like strcmp
+ */
+int parallel_thread_topology_compare_spread ( const void *p_a, const void *p_b );
+
+/** !
+ * Order CPUs to pack threads into NUMA nodes
+ *
+ * @param p_a pointer to a parallel_thread_topology_cpu
+ * @param p_b pointer to a parallel_thread_topology_cpu
+ *
+ * @return a negative, zero, or positive value, like strcmp
+ */
+int parallel_thread_topology_compare_pack ( const void *p_a, const void *p_b );
+
 int parallel_thread_create ( parallel_thread **pp_parallel_thread )
 {
     
@@ -59,6 +167,13 @@ int parallel_thread_create ( parallel_thread **pp_parallel_thread )
 }
 
 int parallel_thread_start ( parallel_thread **pp_parallel_thread, fn_parallel_task *pfn_task, void *p_parameter )
+{
+
+    // Let the kernel place the thread
+    return parallel_thread_start_with_affinity(pp_parallel_thread, pfn_task, p_parameter, -1);
+}
+
+int parallel_thread_start_with_affinity ( parallel_thread **pp_parallel_thread, fn_parallel_task *pfn_task, void *p_parameter, int cpu )
 {
 
     // Argument check
@@ -78,8 +193,40 @@ int parallel_thread_start ( parallel_thread **pp_parallel_thread, fn_parallel_ta
         //
 
     #else
-        // Create a pthread
-        if ( pthread_create(&p_parallel_thread->platform_dependent_thread, NULL, pfn_task, p_parameter) != 0 ) goto failed_to_create_pthread;
+
+        // Store the CPU
+        p_parallel_thread->cpu = -1;
+
+        // Create a pthread that is pinned from the start ...
+        if ( cpu >= 0 && cpu < CPU_SETSIZE )
+        {
+
+            // Initialized data
+            pthread_attr_t _attributes;
+            cpu_set_t      _cpu_set;
+            int            result = 0;
+
+            // Build the attributes
+            CPU_ZERO(&_cpu_set);
+            CPU_SET(cpu, &_cpu_set);
+            pthread_attr_init(&_attributes);
+            pthread_attr_setaffinity_np(&_attributes, sizeof(cpu_set_t), &_cpu_set);
+
+            // Create a pthread
+            result = pthread_create(&p_parallel_thread->platform_dependent_thread, &_attributes, pfn_task, p_parameter);
+
+            // Clean up
+            pthread_attr_destroy(&_attributes);
+
+            // Error check
+            if ( result != 0 ) goto failed_to_create_pthread;
+
+            // Store the CPU
+            p_parallel_thread->cpu = cpu;
+        }
+
+        // ... or create a pthread the kernel may move
+        else if ( pthread_create(&p_parallel_thread->platform_dependent_thread, NULL, pfn_task, p_parameter) != 0 ) goto failed_to_create_pthread;
     #endif
 
     // Return a pointer to the caller
@@ -259,3 +406,396 @@ int parallel_thread_destory ( parallel_thread **pp_parallel_thread )
         }
     }
 }
+
+int parallel_thread_set_affinity ( parallel_thread *p_parallel_thread, int cpu )
+{
+
+    // Argument check
+    if ( p_parallel_thread == (void *) 0 ) goto no_parallel_thread;
+
+    // Platform dependent implementation
+    #ifdef _WIN64
+
+        // TODO:
+        //
+
+    #else
+    {
+
+        // Initialized data
+        cpu_set_t _cpu_set;
+
+        // Pin to one CPU ...
+        if ( cpu >= 0 )
+        {
+
+            // Error check
+            if ( cpu >= CPU_SETSIZE ) goto invalid_cpu;
+
+            // Build the CPU set
+            CPU_ZERO(&_cpu_set);
+            CPU_SET(cpu, &_cpu_set);
+        }
+
+        // ... or allow every CPU this process may run on
+        else if ( sched_getaffinity(0, sizeof(cpu_set_t), &_cpu_set) != 0 ) goto failed_to_set_affinity;
+
+        // Set the affinity
+        if ( pthread_setaffinity_np(p_parallel_thread->platform_dependent_thread, sizeof(cpu_set_t), &_cpu_set) != 0 ) goto failed_to_set_affinity;
+
+        // Store the CPU
+        p_parallel_thread->cpu = ( cpu >= 0 ) ? cpu : -1;
+    }
+    #endif
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_parallel_thread:
+                #ifndef NDEBUG
+                    log_error("[parallel] [thread] Null pointer provided for parameter \"p_parallel_thread\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            invalid_cpu:
+                #ifndef NDEBUG
+                    log_error("[parallel] [thread] Parameter \"cpu\" is out of range in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+
+        // pthread errors
+        {
+            failed_to_set_affinity:
+                #ifndef NDEBUG
+                    log_error("[parallel] [thread] Call to \"pthread_setaffinity_np\" returned an erroneous value in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+int parallel_thread_get_affinity ( parallel_thread *p_parallel_thread, int *p_cpu, int *p_node )
+{
+
+    // Argument check
+    if ( p_parallel_thread == (void *) 0 ) goto no_parallel_thread;
+
+    // Return the CPU to the caller
+    if ( p_cpu ) *p_cpu = p_parallel_thread->cpu;
+
+    // Return the NUMA node to the caller
+    if ( p_node ) *p_node = parallel_thread_cpu_node(p_parallel_thread->cpu);
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_parallel_thread:
+                #ifndef NDEBUG
+                    log_error("[parallel] [thread] Null pointer provided for parameter \"p_parallel_thread\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+int parallel_thread_placement_cpu ( enum parallel_thread_placement_e placement, size_t index )
+{
+
+    // Platform dependent implementation
+    #ifdef _WIN64
+
+        // TODO:
+        //
+        return -1;
+
+    #else
+
+        // Read the topology
+        pthread_once(&topology_once, parallel_thread_topology_load);
+
+        // The topology is unknown
+        if ( _topology.cpu_quantity == 0 ) return -1;
+
+        // Wrap around when there are more threads than CPUs
+        index %= _topology.cpu_quantity;
+
+        // Strategy
+        switch ( placement )
+        {
+            case PARALLEL_THREAD_PLACEMENT_PIN:    return _topology._pin[index];
+            case PARALLEL_THREAD_PLACEMENT_SPREAD: return _topology._spread[index];
+            case PARALLEL_THREAD_PLACEMENT_PACK:   return _topology._pack[index];
+            default:                               return -1;
+        }
+    #endif
+}
+
+int parallel_thread_cpu_node ( int cpu )
+{
+
+    // Platform dependent implementation
+    #ifdef _WIN64
+
+        // TODO:
+        //
+        return -1;
+
+    #else
+
+        // Read the topology
+        pthread_once(&topology_once, parallel_thread_topology_load);
+
+        // Error check
+        if ( cpu < 0 || cpu >= PARALLEL_THREAD_MAX_CPUS ) return -1;
+
+        // Done
+        return _topology._node[cpu];
+    #endif
+}
+
+#ifndef _WIN64
+
+void parallel_thread_topology_set_node ( int cpu, void *p_context )
+{
+
+    // Store the node of the CPU
+    if ( cpu >= 0 && cpu < PARALLEL_THREAD_MAX_CPUS ) _topology._node[cpu] = (int) (intptr_t) p_context;
+
+    // Done
+    return;
+}
+
+int parallel_thread_topology_compare_spread ( const void *p_a, const void *p_b )
+{
+
+    // Initialized data
+    const parallel_thread_topology_cpu *a = p_a,
+                                       *b = p_b;
+
+    // First hyperthreads first, then by position within the node, then alternate nodes
+    if ( a->sibling != b->sibling ) return ( a->sibling > b->sibling ) - ( a->sibling < b->sibling );
+    if ( a->rank    != b->rank    ) return ( a->rank    > b->rank    ) - ( a->rank    < b->rank    );
+    if ( a->node    != b->node    ) return ( a->node    > b->node    ) - ( a->node    < b->node    );
+
+    // Done
+    return ( a->cpu > b->cpu ) - ( a->cpu < b->cpu );
+}
+
+int parallel_thread_topology_compare_pack ( const void *p_a, const void *p_b )
+{
+
+    // Initialized data
+    const parallel_thread_topology_cpu *a = p_a,
+                                       *b = p_b;
+
+    // Fill a node, one hyperthread per core first, before moving to the next node
+    if ( a->node    != b->node    ) return ( a->node    > b->node    ) - ( a->node    < b->node    );
+    if ( a->sibling != b->sibling ) return ( a->sibling > b->sibling ) - ( a->sibling < b->sibling );
+    if ( a->rank    != b->rank    ) return ( a->rank    > b->rank    ) - ( a->rank    < b->rank    );
+
+    // Done
+    return ( a->cpu > b->cpu ) - ( a->cpu < b->cpu );
+}
+
+void parallel_thread_topology_load ( void )
+{
+
+    // Initialized data
+    static parallel_thread_topology_cpu _cpus[PARALLEL_THREAD_MAX_CPUS];
+    cpu_set_t                           _allowed;
+    size_t                              quantity = 0;
+    char                                _path[128] = { 0 };
+    DIR                                *p_dir    = (void *) 0;
+
+    // Every CPU is on node 0, unless sysfs says otherwise
+    memset(_topology._node, 0, sizeof(_topology._node));
+
+    // Read the NUMA node of each CPU
+    if ( ( p_dir = opendir(PARALLEL_THREAD_SYSFS_NODE) ) )
+    {
+
+        // Initialized data
+        struct dirent *p_entry = (void *) 0;
+
+        // Iterate over each node
+        while ( ( p_entry = readdir(p_dir) ) )
+        {
+
+            // Initialized data
+            int node = -1;
+
+            // Skip entries that are not nodes
+            if ( sscanf(p_entry->d_name, "node%d", &node) != 1 ) continue;
+
+            // Read the node's CPUs
+            snprintf(_path, sizeof(_path), PARALLEL_THREAD_SYSFS_NODE "/node%d/cpulist", node);
+            parallel_thread_sysfs_cpu_list(_path, parallel_thread_topology_set_node, (void *) (intptr_t) node);
+        }
+
+        // Clean up
+        closedir(p_dir);
+    }
+
+    // Only place threads on CPUs this process may run on
+    if ( sched_getaffinity(0, sizeof(cpu_set_t), &_allowed) != 0 ) return;
+
+    // Read the core of each CPU
+    for (int cpu = 0; cpu < PARALLEL_THREAD_MAX_CPUS && cpu < CPU_SETSIZE; cpu++)
+    {
+
+        // Skip CPUs this process may not run on
+        if ( CPU_ISSET(cpu, &_allowed) == 0 ) continue;
+
+        // Store the CPU
+        _cpus[quantity].cpu  = cpu;
+        _cpus[quantity].node = _topology._node[cpu];
+
+        // Read the package
+        snprintf(_path, sizeof(_path), PARALLEL_THREAD_SYSFS_CPU "/cpu%d/topology/physical_package_id", cpu);
+        _cpus[quantity].package = parallel_thread_sysfs_int(_path, 0);
+
+        // Read the core. Without sysfs, every CPU is its own core
+        snprintf(_path, sizeof(_path), PARALLEL_THREAD_SYSFS_CPU "/cpu%d/topology/core_id", cpu);
+        _cpus[quantity].core = parallel_thread_sysfs_int(_path, cpu);
+
+        // Store the quantity of CPUs
+        quantity++;
+    }
+
+    // Rank each CPU. Sibling is the CPU's position among the hyperthreads of 
+    // its core. Rank is the position of its core among the cores of its node
+    for (size_t i = 0; i < quantity; i++)
+    {
+
+        // Initialized data
+        int sibling = 0;
+
+        // Count the hyperthreads of the same core with lower numbers
+        for (size_t j = 0; j < i; j++)
+            if ( _cpus[j].package == _cpus[i].package && _cpus[j].core == _cpus[i].core ) sibling++;
+
+        // Store the sibling
+        _cpus[i].sibling = sibling;
+    }
+    for (size_t i = 0; i < quantity; i++)
+    {
+
+        // Initialized data
+        int rank = 0;
+
+        // Count the cores of the same node with lower numbered first hyperthreads
+        if ( _cpus[i].sibling == 0 )
+            for (size_t j = 0; j < quantity; j++)
+                if ( _cpus[j].sibling == 0 && _cpus[j].node == _cpus[i].node && _cpus[j].cpu < _cpus[i].cpu ) rank++;
+
+        // Store the rank
+        _cpus[i].rank = rank;
+    }
+
+    // The other hyperthreads of a core share the rank of its first hyperthread
+    for (size_t i = 0; i < quantity; i++)
+        for (size_t j = 0; j < quantity && _cpus[i].sibling; j++)
+            if ( _cpus[j].sibling == 0 && _cpus[j].package == _cpus[i].package && _cpus[j].core == _cpus[i].core ) _cpus[i].rank = _cpus[j].rank;
+
+    // Pin in the order the kernel numbers CPUs
+    for (size_t i = 0; i < quantity; i++) _topology._pin[i] = _cpus[i].cpu;
+
+    // Order the CPUs to spread threads
+    qsort(_cpus, quantity, sizeof(parallel_thread_topology_cpu), parallel_thread_topology_compare_spread);
+    for (size_t i = 0; i < quantity; i++) _topology._spread[i] = _cpus[i].cpu;
+
+    // Order the CPUs to pack threads
+    qsort(_cpus, quantity, sizeof(parallel_thread_topology_cpu), parallel_thread_topology_compare_pack);
+    for (size_t i = 0; i < quantity; i++) _topology._pack[i] = _cpus[i].cpu;
+
+    // Store the quantity of CPUs
+    _topology.cpu_quantity = quantity;
+
+    // Done
+    return;
+}
+
+int parallel_thread_sysfs_int ( const char *path, int default_value )
+{
+
+    // Initialized data
+    FILE *p_file = fopen(path, "r");
+    int   value  = default_value;
+
+    // The file can't be read
+    if ( p_file == (void *) 0 ) return default_value;
+
+    // Read the integer
+    if ( fscanf(p_file, "%d", &value) != 1 ) value = default_value;
+
+    // Clean up
+    fclose(p_file);
+
+    // Done
+    return value;
+}
+
+int parallel_thread_sysfs_cpu_list ( const char *path, void (*pfn_cpu)(int cpu, void *p_context), void *p_context )
+{
+
+    // Initialized data
+    FILE *p_file = fopen(path, "r");
+    int   first  = 0,
+          last   = 0,
+          c      = 0;
+
+    // The file can't be read
+    if ( p_file == (void *) 0 ) return 0;
+
+    // Each entry is a CPU, or a range of CPUs ...
+    while ( fscanf(p_file, "%d", &first) == 1 )
+    {
+
+        // Assume a single CPU
+        last = first;
+
+        // ... separated by commas
+        if ( ( c = fgetc(p_file) ) == '-' )
+        {
+
+            // Read the end of the range
+            if ( fscanf(p_file, "%d", &last) != 1 ) break;
+
+            // Read the separator
+            c = fgetc(p_file);
+        }
+
+        // Visit each CPU in the range
+        for (int cpu = first; cpu <= last; cpu++) pfn_cpu(cpu, p_context);
+
+        // The end of the list
+        if ( c != ',' ) break;
+    }
+
+    // Clean up
+    fclose(p_file);
+
+    // Success
+    return 1;
+}
+
+#endif
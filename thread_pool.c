@@ -1,39 +1,193 @@
 /** !
  * High level abstraction of a thread pool
- * 
+ *
  * @file thread_pool.c
  *
  * @author Jacob Smith
  */
 
+// Feature test macros
+#ifndef _GNU_SOURCE
+    #define _GNU_SOURCE
+#endif
+
+// Standard library
+#include <stdint.h>
+#include <stdatomic.h>
+#include <time.h>
+#include <errno.h>
+#include <stddef.h>
+#include <sched.h>
+
+// Linux
+#ifdef __linux__
+    #include <unistd.h>
+    #include <sys/syscall.h>
+    #include <linux/futex.h>
+#endif
+
 // Header
 #include <parallel/thread_pool.h>
+#include <parallel/trace.h>
 
 // Preprocessor definitions
 #define PARALLEL_THREAD_POOL_NAME_LENGTH        (63 + 1)
 #define PARALLEL_THREAD_POOL_THREAD_NAME_LENGTH (63 + 1)
 #define PARALLEL_THREAD_POOL_TASK_NAME_LENGTH   (63 + 1)
-#define PARALLEL_THREAD_POOL_MAX_THREADS        64
+#define PARALLEL_THREAD_POOL_MAX_THREADS        1024
 #define PARALLEL_THREAD_POOL_MAX_TASKS          256
+#define PARALLEL_THREAD_POOL_QUEUE_LENGTH       4096
+#define PARALLEL_THREAD_POOL_DEQUE_LENGTH       1024
+#define PARALLEL_THREAD_POOL_FUTURES            1024
+#define PARALLEL_THREAD_POOL_DESCRIPTORS        1024
+#define PARALLEL_THREAD_POOL_GROUP_QUEUE_LENGTH 256
+#define PARALLEL_THREAD_POOL_FOR_PIECES         8
+#define PARALLEL_THREAD_POOL_FOR_RANGES         64
+#define PARALLEL_THREAD_POOL_REDUCE_STACK       256
+#define PARALLEL_THREAD_POOL_IDLE_MILLISECONDS  10000
+#define PARALLEL_THREAD_POOL_STARVATION_LIMIT   32
+#define PARALLEL_THREAD_POOL_SPIN_ITERATIONS    1024
+#define PARALLEL_THREAD_POOL_BACKOFF_LIMIT      32
+#define PARALLEL_THREAD_POOL_HELP_MILLISECONDS  1
+#define PARALLEL_THREAD_POOL_TIMER_LEVELS       4
+#define PARALLEL_THREAD_POOL_TIMER_SLOT_BITS    6
+#define PARALLEL_THREAD_POOL_TIMER_SLOTS        ( 1 << PARALLEL_THREAD_POOL_TIMER_SLOT_BITS )
+#define PARALLEL_THREAD_POOL_TIMER_TICK         1000000ULL // nanoseconds
+#define PARALLEL_THREAD_POOL_STATS_SAMPLE       64         // jobs between queue depth samples
+#define PARALLEL_CACHE_LINE_SIZE                64         // bytes
+
+// Tell the core this thread is spinning
+#if defined(__x86_64__) || defined(__i386__)
+    #define PARALLEL_THREAD_POOL_PAUSE() __builtin_ia32_pause()
+#elif defined(__aarch64__)
+    #define PARALLEL_THREAD_POOL_PAUSE() __asm__ __volatile__ ( "yield" )
+#else
+    #define PARALLEL_THREAD_POOL_PAUSE() atomic_signal_fence(memory_order_seq_cst)
+#endif
+
+// Add to a counter that only one thread writes. Readers see a torn snapshot at
+// worst, and nothing locks the cache line
+#define PARALLEL_THREAD_POOL_STAT_ADD(counter, value) atomic_store_explicit(&(counter), atomic_load_explicit(&(counter), memory_order_relaxed) + (value), memory_order_relaxed)
+
+// Worker states
+#define PARALLEL_THREAD_POOL_WORKER_EMPTY   0
+#define PARALLEL_THREAD_POOL_WORKER_RUNNING 1
+#define PARALLEL_THREAD_POOL_WORKER_RETIRED 2
+
+// Future states
+#define PARALLEL_THREAD_POOL_FUTURE_DONE     0x1U
+#define PARALLEL_THREAD_POOL_FUTURE_WAITER   0x2U
+#define PARALLEL_THREAD_POOL_FUTURE_DETACHED 0x4U
+#define PARALLEL_THREAD_POOL_FUTURE_CHAINED  0x8U
 
 // Forward declarations
+struct thread_pool_job_s;
+struct thread_pool_queue_cell_s;
+struct thread_pool_queue_s;
+struct thread_pool_deque_cell_s;
+struct thread_pool_deque_s;
 struct thread_pool_thread_s;
 struct thread_pool_work_parameter_s;
+struct thread_pool_future_s;
+struct thread_pool_descriptor_s;
+struct thread_pool_for_s;
+struct thread_pool_for_range_s;
+struct thread_pool_reduce_s;
+struct thread_pool_reduce_slot_s;
+struct thread_pool_timer_wheel_s;
 
 // Type definitions
+typedef struct thread_pool_job_s            thread_pool_job;
+typedef struct thread_pool_queue_cell_s     thread_pool_queue_cell;
+typedef struct thread_pool_queue_s          thread_pool_queue;
+typedef struct thread_pool_deque_cell_s     thread_pool_deque_cell;
+typedef struct thread_pool_deque_s          thread_pool_deque;
 typedef struct thread_pool_thread_s         thread_pool_thread;
 typedef struct thread_pool_work_parameter_s thread_pool_work_parameter;
+typedef struct thread_pool_descriptor_s     thread_pool_descriptor;
+typedef struct thread_pool_for_s            thread_pool_for;
+typedef struct thread_pool_for_range_s      thread_pool_for_range;
+typedef struct thread_pool_reduce_s         thread_pool_reduce;
+typedef struct thread_pool_reduce_slot_s    thread_pool_reduce_slot;
+typedef struct thread_pool_timer_wheel_s    thread_pool_timer_wheel;
 
 // Structure definitions
-struct thread_pool_thread_s
+struct thread_pool_job_s
 {
-    bool              running;
-    monitor           _montior;
-    void             *ret;
-    void             *p_parameter;
     fn_parallel_task *pfn_parallel_task;
-    parallel_thread  *p_parallel_thread;
+    void             *p_parameter;
+    uint64_t          submitted; // nanoseconds on the monotonic clock
+};
+
+struct thread_pool_queue_cell_s
+{
+    atomic_size_t   sequence;
+    thread_pool_job _job;
+};
+
+struct thread_pool_queue_s
+{
+    size_t                  mask;
+    thread_pool_queue_cell *p_cells;
+    char                    _pad0[PARALLEL_CACHE_LINE_SIZE];
+    atomic_size_t           enqueue_position;
+    char                    _pad1[PARALLEL_CACHE_LINE_SIZE];
+    atomic_size_t           dequeue_position;
+    char                    _pad2[PARALLEL_CACHE_LINE_SIZE];
+};
+
+struct thread_pool_deque_cell_s
+{
+    _Atomic(fn_parallel_task *) pfn_parallel_task;
+    _Atomic(void *)             p_parameter;
+    _Atomic(uint64_t)           submitted;
+};
+
+struct thread_pool_deque_s
+{
+    size_t                  mask;
+    thread_pool_deque_cell *p_cells;
+    char                    _pad0[PARALLEL_CACHE_LINE_SIZE];
+    atomic_intptr_t         top;
+    char                    _pad1[PARALLEL_CACHE_LINE_SIZE];
+    atomic_intptr_t         bottom;
+    char                    _pad2[PARALLEL_CACHE_LINE_SIZE];
+};
 
+struct thread_pool_thread_s
+{
+
+    // Written when the worker parks, wakes, or retires
+    void                       *ret;
+    parallel_thread            *p_parallel_thread;
+    int                         state;
+    int                         cpu;
+    atomic_uint                 unparked;
+    thread_pool_work_parameter *p_next_parked;
+    #ifndef __linux__
+        pthread_mutex_t         _park_lock;
+        pthread_cond_t          _park;
+    #endif
+    char                        _pad0[PARALLEL_CACHE_LINE_SIZE];
+
+    // Written by the worker for every job. Nobody else reads these
+    unsigned long long victim_seed;
+    size_t             priority_streak;
+    size_t             nesting;   // jobs this worker is running, counting jobs run while waiting in a job
+    uint64_t           last;      // when the worker started waiting for a job
+    char               _pad1[PARALLEL_CACHE_LINE_SIZE];
+
+    // Written by the worker for every job, read by thread_pool_stats
+    _Atomic(uint64_t)  jobs,
+                       busy_nanoseconds,
+                       idle_nanoseconds,
+                       steals,
+                       max_queue_depth;
+    _Atomic(uint64_t)  latency[THREAD_POOL_LATENCY_BUCKETS];
+    char               _pad2[PARALLEL_CACHE_LINE_SIZE];
+
+    // Pads its own top and bottom
+    thread_pool_deque  _deque;
 };
 
 struct thread_pool_work_parameter_s
@@ -42,52 +196,226 @@ struct thread_pool_work_parameter_s
     thread_pool_thread  _thread;
 };
 
+struct thread_pool_future_s
+{
+    atomic_uint                   state;
+    atomic_uint                   next;
+    void                         *ret;
+    fn_parallel_task             *pfn_parallel_task;
+    void                         *p_parameter;
+    thread_pool                  *p_thread_pool;
+    _Atomic(thread_pool_future *) p_continuation; // points to this future once it is done
+    atomic_size_t                 pending;        // antecedents that haven't finished
+    pthread_mutex_t               _lock;
+    pthread_cond_t                _done;
+};
+
+struct thread_pool_descriptor_s
+{
+    _Alignas(PARALLEL_CACHE_LINE_SIZE) atomic_uint next;
+    thread_pool                                   *p_thread_pool;
+    fn_parallel_task                              *pfn_parallel_task;
+    fn_parallel_destructor                        *pfn_destructor;
+    void                                          *p_parameter;
+    _Alignas(max_align_t) unsigned char            _parameter[THREAD_POOL_INLINE_PARAMETER_SIZE];
+};
+
+struct thread_pool_group_s
+{
+
+    // Written by waiters, and by the job that finishes the group
+    thread_pool       *p_thread_pool;
+    atomic_size_t      waiters,
+                       waiting_producers; // producers waiting on a full queue of the group
+    pthread_mutex_t    _lock;
+    pthread_cond_t     _done;
+    char               _pad0[PARALLEL_CACHE_LINE_SIZE];
+
+    // Written by every job of the group
+    atomic_size_t      outstanding_jobs;
+    atomic_size_t      references;
+    char               _pad1[PARALLEL_CACHE_LINE_SIZE];
+
+    // Pads its own producer and consumer positions
+    thread_pool_queue  _queue;
+};
+
+struct thread_pool_timer_s
+{
+    thread_pool_timer       *p_next,
+                            *p_previous,
+                            *p_handle_next,     // the list of timers with a handle
+                            *p_handle_previous;
+    thread_pool_timer_wheel *p_wheel;           // null after the timer wheel is destroyed
+    fn_parallel_task        *pfn_parallel_task;
+    void                    *p_parameter;
+    uint64_t                 expiry, // in ticks
+                             period; // in ticks, 0 for a one shot timer
+    size_t                   references;
+    int                      level,  // -1 when the timer is not in the wheel
+                             slot;
+};
+
+struct thread_pool_timer_wheel_s
+{
+    thread_pool       *p_thread_pool;
+    parallel_thread   *p_parallel_thread;
+    bool               running;
+    uint64_t           start,     // the monotonic clock at tick 0, in nanoseconds
+                       tick,      // the last tick that was run
+                       wake_tick; // when the timer thread wakes up next
+    size_t             timer_quantity;
+    uint64_t           occupied[PARALLEL_THREAD_POOL_TIMER_LEVELS];
+    thread_pool_timer *p_slots[PARALLEL_THREAD_POOL_TIMER_LEVELS][PARALLEL_THREAD_POOL_TIMER_SLOTS];
+    thread_pool_timer *p_handles; // timers a caller holds a handle to, in or out of the wheel
+    pthread_mutex_t    _lock;
+    pthread_cond_t     _changed;
+};
+
+struct thread_pool_for_range_s
+{
+    thread_pool_for *p_for;
+    size_t           first,
+                     last;
+};
+
+struct thread_pool_for_s
+{
+    thread_pool           *p_thread_pool;
+    fn_parallel_for       *pfn_parallel_for;
+    void                  *p_context;
+    size_t                 begin,
+                           end,
+                           piece_size;
+    atomic_size_t          pending_ranges;
+    atomic_size_t          next_range;
+    thread_pool_for_range *p_ranges;
+    bool                   done;
+    pthread_mutex_t        _lock;
+    pthread_cond_t         _done;
+};
+
+struct thread_pool_reduce_slot_s
+{
+    bool                                busy,
+                                        used;
+    _Alignas(max_align_t) unsigned char _value[];
+};
+
+struct thread_pool_reduce_s
+{
+    thread_pool          *p_thread_pool;
+    fn_parallel_reduce   *pfn_parallel_reduce;
+    fn_parallel_combine  *pfn_parallel_combine;
+    const void           *p_identity;
+    void                 *p_context;
+    pthread_t             caller;
+    size_t                size,
+                          slot_size,
+                          slot_quantity;
+    unsigned char        *p_slots;
+    atomic_bool           failed;
+    pthread_mutex_t       _shared_lock;
+};
+
 struct thread_pool_s
 {
-    monitor _montior;
-    mutex _lock;
-    size_t thread_quantity;
-    size_t running_threads;
+
+    // Written at construction, read by everyone
+    enum thread_pool_mode_e    mode;
+    enum thread_pool_wait_e    wait;
+    enum thread_pool_overflow_e overflow;
+    size_t                     overflow_milliseconds,
+                               thread_quantity,
+                               min_thread_quantity,
+                               idle_milliseconds,
+                               future_quantity,
+                               descriptor_quantity,
+                               spin_iterations;
+    thread_pool_future        *p_futures;
+    thread_pool_descriptor    *p_descriptors;
+    void                      *p_descriptor_memory;
+    char                       _pad0[PARALLEL_CACHE_LINE_SIZE];
+
+    // Written by every submit, and by every job that finishes
+    atomic_size_t              outstanding_jobs;
+    char                       _pad1[PARALLEL_CACHE_LINE_SIZE];
+
+    // Written by workers as they spin, park and wake, read by every submit
+    atomic_size_t              sleeping_threads;
+    atomic_size_t              spinning_threads;
+    char                       _pad2[PARALLEL_CACHE_LINE_SIZE];
+
+    // Written by futures as they are taken and returned
+    _Atomic(uint64_t)          free_futures;
+    char                       _pad3[PARALLEL_CACHE_LINE_SIZE];
+
+    // Written by job descriptors as they are taken and returned
+    _Atomic(uint64_t)          free_descriptors;
+    char                       _pad5[PARALLEL_CACHE_LINE_SIZE];
+
+    // Written on slow paths; blocked producers, idle waiters, and growing or
+    // shrinking the thread pool
+    atomic_size_t              waiting_producers;
+    atomic_size_t              idle_waiters;
+    atomic_bool                running;
+    atomic_bool                growing;
+    atomic_size_t              live_threads;
+    atomic_size_t              started_threads;
+    thread_pool_work_parameter *p_parked;
+    _Atomic(thread_pool_timer_wheel *) p_timer_wheel;
+    pthread_mutex_t            _lock;
+    pthread_cond_t             _slot_available;
+    pthread_cond_t             _idle;
+    char                       _pad4[PARALLEL_CACHE_LINE_SIZE];
+
+    // Each queue pads its own producer and consumer positions
+    thread_pool_queue          _queues[THREAD_POOL_PRIORITY_QUANTITY];
+
+    // Each worker pads its own state
     thread_pool_work_parameter _threads[];
 };
 
+// Data
+static _Thread_local thread_pool_work_parameter *p_thread_pool_current_worker = (void *) 0;
+
 // Function declarations
 /** !
  * Allocate memory for a scheudle thread
- * 
+ *
  * @param pp_thread_pool_thread return
- * 
+ *
  * @sa parallel_thread_pool_destroy
- * 
+ *
  * @return 1 on success, 0 on error
 */
 int parallel_thread_pool_thread_create ( thread_pool_thread **pp_thread_pool_thread, size_t task_quantity );
 
 /** !
  * Construct a named thread from a json value
- * 
+ *
  * @param pp_thread return
  * @param name      the name
  * @param value     the json value
- * 
+ *
  * @return 1 on success, 0 on error
  */
 int parallel_thread_pool_thread_load_as_json_value ( thread_pool_thread **const pp_thread, const char *const name, const json_value *const p_value );
 
 /** !
  * Worker thread loop
- * 
+ *
  * @param p_parameter who am I?
- * 
+ *
  * @return ret
  */
 void *parallel_thread_pool_work ( thread_pool_work_parameter *p_parameter );
 
 /** !
  * Main thread loop
- * 
+ *
  * @param p_parameter who am I?
- * 
+ *
  * @return ret
  */
 void *parallel_thread_pool_main_work ( thread_pool_work_parameter *p_parameter );
@@ -97,386 +425,5383 @@ int thread_pool_thread_destroy ( thread_pool_thread **pp_thread );
 
 /** !
  * Start a worker thread
- * 
- * @param p_parameter 
- * 
- * @return 
+ *
+ * @param p_parameter
+ *
+ * @return
  */
 void *thread_pool_work ( thread_pool_work_parameter *p_parameter );
 
-// Function definitions
-int thread_pool_create ( thread_pool **const pp_thread_pool )
-{
+/** !
+ * Construct a bounded multi producer, multi consumer job queue
+ *
+ * @param p_queue  the queue
+ * @param capacity the maximum quantity of jobs. Must be a power of two
+ *
+ * @return 1 on success, 0 on error
+ */
+int thread_pool_queue_construct ( thread_pool_queue *p_queue, size_t capacity );
 
-    // Argument check
-    if ( pp_thread_pool == (void *) 0 ) goto no_thread_pool;
+/** !
+ * Add a job to the back of a queue without blocking
+ *
+ * @param p_queue the queue
+ * @param p_job   the job
+ *
+ * @return 1 on success, 0 if the queue is full
+ */
+int thread_pool_queue_enqueue ( thread_pool_queue *p_queue, const thread_pool_job *p_job );
+
+/** !
+ * Remove a job from the front of a queue without blocking
+ *
+ * @param p_queue the queue
+ * @param p_job   return
+ *
+ * @return 1 on success, 0 if the queue is empty
+ */
+int thread_pool_queue_dequeue ( thread_pool_queue *p_queue, thread_pool_job *p_job );
+
+/** !
+ * Test if a queue is empty
+ *
+ * @param p_queue the queue
+ *
+ * @return true if the queue is empty else false
+ */
+bool thread_pool_queue_empty ( thread_pool_queue *p_queue );
+
+/** !
+ * Test if a queue is full
+ *
+ * @param p_queue the queue
+ *
+ * @return true if the queue is full else false
+ */
+bool thread_pool_queue_full ( thread_pool_queue *p_queue );
+
+/** !
+ * Release a queue's cells
+ *
+ * @param p_queue the queue
+ *
+ * @return 1 on success, 0 on error
+ */
+int thread_pool_queue_destroy ( thread_pool_queue *p_queue );
+
+/** !
+ * Construct a work stealing double ended queue
+ *
+ * @param p_deque  the deque
+ * @param capacity the maximum quantity of jobs. Must be a power of two
+ *
+ * @return 1 on success, 0 on error
+ */
+int thread_pool_deque_construct ( thread_pool_deque *p_deque, size_t capacity );
+
+/** !
+ * Push a job onto the bottom of a deque. Only the owner may push
+ *
+ * @param p_deque the deque
+ * @param p_job   the job
+ *
+ * @return 1 on success, 0 if the deque is full
+ */
+int thread_pool_deque_push ( thread_pool_deque *p_deque, const thread_pool_job *p_job );
+
+/** !
+ * Pop the newest job from the bottom of a deque. Only the owner may take
+ *
+ * @param p_deque the deque
+ * @param p_job   return
+ *
+ * @return 1 on success, 0 if the deque is empty
+ */
+int thread_pool_deque_take ( thread_pool_deque *p_deque, thread_pool_job *p_job );
+
+/** !
+ * Steal the oldest job from the top of a deque. Any thread may steal
+ *
+ * @param p_deque the deque
+ * @param p_job   return
+ *
+ * @return 1 on success, 0 if the deque is empty or another thread won the job
+ */
+int thread_pool_deque_steal ( thread_pool_deque *p_deque, thread_pool_job *p_job );
+
+/** !
+ * Test if a deque is empty
+ *
+ * @param p_deque the deque
+ *
+ * @return true if the deque is empty else false
+ */
+bool thread_pool_deque_empty ( thread_pool_deque *p_deque );
+
+/** !
+ * Release a deque's cells
+ *
+ * @param p_deque the deque
+ *
+ * @return 1 on success, 0 on error
+ */
+int thread_pool_deque_destroy ( thread_pool_deque *p_deque );
+
+/** !
+ * Test if a thread pool has queued jobs
+ *
+ * @param p_thread_pool the thread pool
+ *
+ * @return true if any queue holds a job else false
+ */
+bool thread_pool_has_work ( thread_pool *p_thread_pool );
+
+/** !
+ * Find the next job for a worker. Workers take critical jobs first. Work 
+ * stealing workers then take from their own deque, then from the normal queue,
+ * then from a random victim. Background jobs come last. After a streak of 
+ * PARALLEL_THREAD_POOL_STARVATION_LIMIT jobs, the lowest priority queue goes first
+ *
+ * @param p_parameter the worker
+ * @param p_job       return
+ *
+ * @return 1 on success, 0 if there is nothing to run
+ */
+int thread_pool_next_job ( thread_pool_work_parameter *p_parameter, thread_pool_job *p_job );
+
+/** !
+ * Count a job as done. The last job to finish wakes every idle waiter
+ *
+ * @param p_thread_pool the thread pool
+ *
+ * @return void
+ */
+void thread_pool_finish_job ( thread_pool *p_thread_pool );
+
+/** !
+ * Remove a job from one of a thread pool's priority queues, and wake the 
+ * producers that are waiting for a free slot
+ *
+ * @param p_thread_pool the thread pool
+ * @param priority      the priority of the queue
+ * @param p_job         return
+ *
+ * @return 1 on success, 0 if the queue is empty
+ */
+int thread_pool_dequeue_job ( thread_pool *p_thread_pool, enum thread_pool_priority_e priority, thread_pool_job *p_job );
+
+/** !
+ * Test if the calling thread is a worker of a thread pool
+ *
+ * @param p_thread_pool the thread pool
+ *
+ * @return true if the calling thread is one of the thread pool's workers, else false
+ */
+bool thread_pool_on_worker ( thread_pool *p_thread_pool );
+
+/** !
+ * Run one queued job on the calling thread. Workers look for jobs like they 
+ * always do. Other threads take from the job queues, highest priority first, 
+ * but steal from the workers before they take a background job
+ *
+ * @param p_thread_pool the thread pool
+ *
+ * @return 1 if a job was run, else 0
+ */
+int thread_pool_help ( thread_pool *p_thread_pool );
+
+/** !
+ * Split a parallel for range in half until one piece is left, handing each
+ * upper half to the thread pool, then run the piece
+ *
+ * @param p_range the range
+ *
+ * @return null pointer
+ */
+void *thread_pool_for_run ( thread_pool_for_range *p_range );
+
+/** !
+ * Run a piece of a parallel reduce on the calling thread's partial
+ *
+ * @param begin    the first index
+ * @param end      one past the last index
+ * @param p_reduce the parallel reduce
+ *
+ * @return void
+ */
+void thread_pool_reduce_run ( size_t begin, size_t end, thread_pool_reduce *p_reduce );
+
+/** !
+ * Get one of a parallel reduce's partials
+ *
+ * @param p_reduce the parallel reduce
+ * @param index    the index of the partial
+ *
+ * @return the partial
+ */
+thread_pool_reduce_slot *thread_pool_reduce_slot_get ( thread_pool_reduce *p_reduce, size_t index );
+
+/** !
+ * Start a worker in the first free slot, if the thread pool is below its
+ * maximum quantity of threads. The caller must hold the thread pool's lock
+ *
+ * @param p_thread_pool the thread pool
+ *
+ * @return 1 on success, 0 on error
+ */
+int thread_pool_worker_start ( thread_pool *p_thread_pool );
+
+/** !
+ * Add a worker to an elastic thread pool if every worker is busy and jobs are 
+ * waiting. Producers check after they submit, and workers check before they
+ * run a job, so a burst of jobs keeps growing the pool after it is submitted
+ *
+ * @param p_thread_pool the thread pool
+ *
+ * @return void
+ */
+void thread_pool_grow ( thread_pool *p_thread_pool );
+
+/** !
+ * Put a counted job on a work stealing worker's deque, or on the job queue of
+ * its priority. Only normal jobs go on a deque. If the job queue is full, and 
+ * shed is true, the thread pool's overflow policy applies. Else, blocks until 
+ * the job fits.
+ *
+ * @param p_thread_pool the thread pool
+ * @param p_job         the job
+ * @param priority      the priority of the job
+ * @param shed          true to apply the overflow policy
+ *
+ * @return 1 if the job was queued or run, 0 if it was rejected or timed out
+ */
+int thread_pool_submit ( thread_pool *p_thread_pool, const thread_pool_job *p_job, enum thread_pool_priority_e priority, bool shed );
+
+/** !
+ * Execute a job that the thread pool has already promised to run, like a group's 
+ * job, a range of a parallel loop, a continuation, or a timer's job. These are 
+ * never shed; a full queue blocks.
+ *
+ * @param p_thread_pool     the thread pool
+ * @param pfn_parallel_task pointer to job function
+ * @param p_parameter       the parameter of the parallel task
+ *
+ * @return void
+ */
+void thread_pool_post ( thread_pool *p_thread_pool, fn_parallel_task *pfn_parallel_task, void *p_parameter );
+
+/** !
+ * Wake parked workers after jobs are submitted. Workers that are still 
+ * spinning will find the jobs on their own, so only the rest are woken
+ *
+ * @param p_thread_pool the thread pool
+ * @param quantity      the most workers to wake
+ *
+ * @return void
+ */
+void thread_pool_wake ( thread_pool *p_thread_pool, size_t quantity );
+
+/** !
+ * Wake the most recently parked workers. The caller must hold the thread pool's lock
+ *
+ * @param p_thread_pool the thread pool
+ * @param quantity      the most workers to wake
+ *
+ * @return void
+ */
+void thread_pool_unpark ( thread_pool *p_thread_pool, size_t quantity );
+
+/** !
+ * Sleep until another thread unparks this worker, with an optional deadline
+ *
+ * @param p_parameter the worker
+ * @param p_deadline  the deadline on the monotonic clock, or null pointer to wait forever
+ *
+ * @return 1 if the worker was unparked, 0 on timeout
+ */
+int thread_pool_park ( thread_pool_work_parameter *p_parameter, const struct timespec *p_deadline );
+
+/** !
+ * Construct the recycled future storage of a thread pool
+ *
+ * @param p_thread_pool   the thread pool
+ * @param future_quantity the quantity of futures
+ *
+ * @return 1 on success, 0 on error
+ */
+int thread_pool_futures_construct ( thread_pool *p_thread_pool, size_t future_quantity );
+
+/** !
+ * Take a future from a thread pool's free list
+ *
+ * @param p_thread_pool the thread pool
+ *
+ * @return a future on success, null pointer if every future is in use
+ */
+thread_pool_future *thread_pool_future_acquire ( thread_pool *p_thread_pool );
+
+/** !
+ * Return a future to a thread pool's free list
+ *
+ * @param p_future the future
+ *
+ * @return void
+ */
+void thread_pool_future_recycle ( thread_pool_future *p_future );
+
+/** !
+ * Construct the recycled job descriptors of a thread pool. Each descriptor 
+ * starts on its own cache line
+ *
+ * @param p_thread_pool       the thread pool
+ * @param descriptor_quantity the quantity of descriptors
+ *
+ * @return 1 on success, 0 on error
+ */
+int thread_pool_descriptors_construct ( thread_pool *p_thread_pool, size_t descriptor_quantity );
+
+/** !
+ * Take a job descriptor from a thread pool's free list
+ *
+ * @param p_thread_pool the thread pool
+ *
+ * @return a descriptor on success, null pointer if every descriptor is in use
+ */
+thread_pool_descriptor *thread_pool_descriptor_acquire ( thread_pool *p_thread_pool );
+
+/** !
+ * Return a job descriptor to a thread pool's free list, and wake the producers
+ * waiting for one
+ *
+ * @param p_descriptor the descriptor
+ *
+ * @return void
+ */
+void thread_pool_descriptor_recycle ( thread_pool_descriptor *p_descriptor );
+
+/** !
+ * Run a job descriptor's task, then its destructor, and recycle the descriptor
+ *
+ * @param p_descriptor the descriptor
+ *
+ * @return the result of the task
+ */
+void *thread_pool_descriptor_run ( thread_pool_descriptor *p_descriptor );
+
+/** !
+ * Run a future's task, and complete the future with its result
+ *
+ * @param p_future the future
+ *
+ * @return the result of the task
+ */
+void *thread_pool_future_run ( thread_pool_future *p_future );
+
+/** !
+ * Store a future's result, start its continuation, and wake the waiter
+ *
+ * @param p_future the future
+ * @param ret      the result
+ *
+ * @return void
+ */
+void thread_pool_future_complete ( thread_pool_future *p_future, void *ret );
+
+/** !
+ * Make a continuation the successor of a future. If the future is already 
+ * done, the continuation's antecedent arrives right away
+ *
+ * @param p_future       the future
+ * @param p_continuation the continuation
+ *
+ * @return 1 on success, 0 if the future already has a continuation
+ */
+int thread_pool_future_chain ( thread_pool_future *p_future, thread_pool_future *p_continuation );
+
+/** !
+ * Count one antecedent of a continuation as done. When the last one arrives,
+ * a continuation with a task is queued, and a continuation without one is 
+ * completed on the calling thread
+ *
+ * @param p_continuation the continuation
+ * @param ret            the antecedent's result
+ *
+ * @return void
+ */
+void thread_pool_future_arrive ( thread_pool_future *p_continuation, void *ret );
+
+/** !
+ * Wait for a future with an optional deadline
+ *
+ * @param p_future   the future
+ * @param p_deadline the deadline on the monotonic clock, or null pointer to wait forever
+ * @param pp_result  return
+ *
+ * @return 1 if the future is done, 0 on timeout
+ */
+int thread_pool_future_wait_until ( thread_pool_future *p_future, const struct timespec *p_deadline, void **pp_result );
+
+/** !
+ * Run one queued job of a task group, unless a waiter already ran it, then 
+ * drop the reference the run held. The thread pool runs one of these for each
+ * job executed through the group
+ *
+ * @param p_group the task group
+ *
+ * @return null pointer
+ */
+void *thread_pool_group_run ( thread_pool_group *p_group );
+
+/** !
+ * Run one queued job of a task group on the calling thread, and wake the 
+ * producers waiting on the group's full queue
+ *
+ * @param p_group the task group
+ *
+ * @return 1 if a job ran, 0 if the group's queue is empty
+ */
+int thread_pool_group_help ( thread_pool_group *p_group );
+
+/** !
+ * Count a job of a task group as done, and wake the waiters if it was the last
+ *
+ * @param p_group the task group
+ *
+ * @return void
+ */
+void thread_pool_group_finish_job ( thread_pool_group *p_group );
+
+/** !
+ * Drop a reference to a task group, and release it if it was the last
+ *
+ * @param p_group the task group
+ *
+ * @return void
+ */
+void thread_pool_group_release ( thread_pool_group *p_group );
+
+/** !
+ * Get the timer wheel of a thread pool. The first call constructs it, and 
+ * starts the timer thread
+ *
+ * @param p_thread_pool the thread pool
+ *
+ * @return the timer wheel on success, null pointer on error
+ */
+thread_pool_timer_wheel *thread_pool_timer_wheel_get ( thread_pool *p_thread_pool );
+
+/** !
+ * Stop the timer thread, and release the timer wheel. The wheel lets go of each
+ * timer in it, and a timer is freed only if no handle refers to it. A timer a 
+ * handle refers to is marked dead, and the handle's owner releases it
+ *
+ * @param p_wheel the timer wheel
+ *
+ * @return void
+ */
+void thread_pool_timer_wheel_destroy ( thread_pool_timer_wheel *p_wheel );
+
+/** !
+ * Get the current tick of a timer wheel
+ *
+ * @param p_wheel the timer wheel
+ *
+ * @return the tick that is in progress now
+ */
+uint64_t thread_pool_timer_wheel_now ( thread_pool_timer_wheel *p_wheel );
+
+/** !
+ * Get the next tick that has work for the timer thread. That is the next tick
+ * with a timer in the lowest level, or the next lap of the lowest level, when 
+ * a timer may come down from a higher level. The caller holds the lock
+ *
+ * @param p_wheel the timer wheel
+ *
+ * @return the next tick with work
+ */
+uint64_t thread_pool_timer_wheel_next ( thread_pool_timer_wheel *p_wheel );
+
+/** !
+ * Run the next tick of a timer wheel. Timers of a higher level whose lap starts
+ * on this tick move down, and the timers in the tick's slot queue their jobs.
+ * The caller holds the lock, which is dropped while each job is queued
+ *
+ * @param p_wheel the timer wheel
+ *
+ * @return void
+ */
+void thread_pool_timer_wheel_advance ( thread_pool_timer_wheel *p_wheel );
+
+/** !
+ * Put a timer in the slot of the level that matches how far away its expiry is.
+ * The caller holds the lock
+ *
+ * @param p_wheel the timer wheel
+ * @param p_timer the timer
+ *
+ * @return void
+ */
+void thread_pool_timer_insert ( thread_pool_timer_wheel *p_wheel, thread_pool_timer *p_timer );
+
+/** !
+ * Take a timer out of its slot. The caller holds the lock
+ *
+ * @param p_wheel the timer wheel
+ * @param p_timer the timer
+ *
+ * @return void
+ */
+void thread_pool_timer_remove ( thread_pool_timer_wheel *p_wheel, thread_pool_timer *p_timer );
+
+/** !
+ * Drop a reference to a timer, and free it if it was the last. The caller 
+ * holds the lock of the timer's wheel, if the wheel still exists
+ *
+ * @param p_timer the timer
+ *
+ * @return void
+ */
+void thread_pool_timer_release ( thread_pool_timer *p_timer );
+
+/** !
+ * Start a one shot or periodic timer
+ *
+ * @param p_thread_pool     the thread pool
+ * @param milliseconds      the delay of the first job
+ * @param period            the period, in milliseconds, or 0 for a one shot timer
+ * @param pfn_parallel_task pointer to job function
+ * @param p_parameter       the parameter of the parallel task
+ * @param pp_timer          return, may be null
+ *
+ * @return 1 on success, 0 on error
+ */
+int thread_pool_timer_start ( thread_pool *p_thread_pool, size_t milliseconds, size_t period, fn_parallel_task *pfn_parallel_task, void *p_parameter, thread_pool_timer **pp_timer );
+
+/** !
+ * Run a timer wheel until the thread pool is destroyed
+ *
+ * @param p_wheel the timer wheel
+ *
+ * @return null pointer
+ */
+void *thread_pool_timer_work ( thread_pool_timer_wheel *p_wheel );
+
+/** !
+ * Compute a deadline on the monotonic clock
+ *
+ * @param p_deadline   return
+ * @param milliseconds time from now
+ *
+ * @return void
+ */
+void thread_pool_deadline ( struct timespec *p_deadline, size_t milliseconds );
+
+/** !
+ * Read the monotonic clock
+ *
+ * @return the time, in nanoseconds
+ */
+uint64_t thread_pool_clock ( void );
+
+/** !
+ * Run a job on a worker, and count it in the worker's statistics
+ *
+ * @param p_parameter the worker
+ * @param p_job       the job
+ *
+ * @return the job's return value
+ */
+void *thread_pool_run_job ( thread_pool_work_parameter *p_parameter, const thread_pool_job *p_job );
+
+/** !
+ * Count the jobs waiting in a thread pool's queues and deques. Each position 
+ * is read on its own, so the count is only a snapshot
+ *
+ * @param p_thread_pool the thread pool
+ *
+ * @return the quantity of waiting jobs
+ */
+size_t thread_pool_queue_depth ( thread_pool *p_thread_pool );
+
+/** !
+ * Test if a deadline on the monotonic clock has passed
+ *
+ * @param p_deadline the deadline
+ *
+ * @return true if the deadline has passed else false
+ */
+bool thread_pool_deadline_passed ( const struct timespec *p_deadline );
+
+// Function definitions
+int thread_pool_create ( thread_pool **const pp_thread_pool )
+{
+
+    // Argument check
+    if ( pp_thread_pool == (void *) 0 ) goto no_thread_pool;
+
+    // Initialized data
+    thread_pool *p_thread_pool = (void *) 0;
+
+    // Allocate memory for the thread_pool
+    p_thread_pool = PARALLEL_REALLOC(0, sizeof(thread_pool));
+
+    // Error check
+    if ( p_thread_pool == (void *) 0 ) goto no_mem;
+
+    // Zero set memory
+    memset(p_thread_pool, 0, sizeof(thread_pool));
+
+    // Return a pointer to the caller
+    *pp_thread_pool = p_thread_pool;
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_thread_pool:
+                #ifndef NDEBUG
+                    log_error("[parallel] [thread pool] Null pointer provided for parameter \"pp_thread_pool\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+
+        // Standard library errors
+        {
+            no_mem:
+                #ifndef NDEBUG
+                    log_error("[Standard Library] Failed to allocate memory in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+int thread_pool_construct ( thread_pool **pp_thread_pool, int thread_quantity )
+{
+
+    // Initialized data
+    thread_pool_attributes _attributes =
+    {
+        .thread_quantity = thread_quantity,
+        .mode            = THREAD_POOL_MODE_SHARED_QUEUE
+    };
+
+    // Success
+    return thread_pool_construct_with_attributes(pp_thread_pool, &_attributes);
+}
+
+int thread_pool_construct_with_attributes ( thread_pool **pp_thread_pool, const thread_pool_attributes *p_attributes )
+{
+
+    // Argument check
+    if ( pp_thread_pool  ==                       (void *) 0 ) goto no_thread_pool;
+    if ( p_attributes    ==                       (void *) 0 ) goto no_attributes;
+    if ( p_attributes->thread_quantity <=                  0 ) goto no_thread_quantity;
+    if ( p_attributes->thread_quantity > PARALLEL_THREAD_POOL_MAX_THREADS ) goto too_many_threads;
+    if ( p_attributes->max_thread_quantity > PARALLEL_THREAD_POOL_MAX_THREADS ) goto too_many_threads;
+    if ( p_attributes->max_thread_quantity && p_attributes->max_thread_quantity < p_attributes->thread_quantity ) goto invalid_max_thread_quantity;
+    if ( p_attributes->mode >= THREAD_POOL_MODE_QUANTITY ) goto invalid_mode;
+    if ( p_attributes->placement >= PARALLEL_THREAD_PLACEMENT_QUANTITY ) goto invalid_placement;
+    if ( p_attributes->p_cpus && p_attributes->cpu_quantity == 0 ) goto invalid_placement;
+    if ( p_attributes->wait >= THREAD_POOL_WAIT_QUANTITY ) goto invalid_wait;
+    if ( p_attributes->wait == THREAD_POOL_WAIT_BUSY_POLL && p_attributes->max_thread_quantity > p_attributes->thread_quantity ) goto invalid_wait;
+    if ( p_attributes->queue_length & ( p_attributes->queue_length - 1 ) ) goto invalid_queue_length;
+    if ( p_attributes->overflow >= THREAD_POOL_OVERFLOW_QUANTITY ) goto invalid_overflow;
+
+    // Initialized data
+    thread_pool *p_thread_pool       = (void *) 0,
+                *p_grown             = (void *) 0;
+    size_t       min_thread_quantity = (size_t) p_attributes->thread_quantity,
+                 thread_quantity     = p_attributes->max_thread_quantity ? (size_t) p_attributes->max_thread_quantity : min_thread_quantity;
+
+    // Construct a thread pool
+    if ( thread_pool_create(&p_thread_pool) == 0 ) goto failed_to_create_thread_pool;
+
+    // Grow the allocation to fit a slot for every thread the pool may grow to
+    p_grown = PARALLEL_REALLOC(p_thread_pool, sizeof(thread_pool) + thread_quantity * sizeof(thread_pool_work_parameter));
+
+    // Error check
+    if ( p_grown == (void *) 0 ) goto no_mem;
+
+    // Store the grown thread pool
+    p_thread_pool = p_grown;
+
+    // Initialize data
+    memset(p_thread_pool, 0, sizeof(thread_pool) + thread_quantity * sizeof(thread_pool_work_parameter));
+
+    // Construct the lock and the condition variables first, so a failure 
+    // from here on can unwind through thread_pool_destroy
+    pthread_mutex_init(&p_thread_pool->_lock, NULL);
+
+    // Idle waits and blocked producers measure time on the monotonic clock
+    {
+
+        // Initialized data
+        pthread_condattr_t _attributes;
+
+        // Construct the condition variables
+        pthread_condattr_init(&_attributes);
+        pthread_condattr_setclock(&_attributes, CLOCK_MONOTONIC);
+        pthread_cond_init(&p_thread_pool->_idle, &_attributes);
+        pthread_cond_init(&p_thread_pool->_slot_available, &_attributes);
+        pthread_condattr_destroy(&_attributes);
+    }
+
+    // Store the bounds on the quantity of threads
+    p_thread_pool->thread_quantity     = thread_quantity;
+    p_thread_pool->min_thread_quantity = min_thread_quantity;
+
+    // Store the time a worker of an elastic pool may idle before it retires
+    p_thread_pool->idle_milliseconds = p_attributes->idle_milliseconds ? p_attributes->idle_milliseconds : PARALLEL_THREAD_POOL_IDLE_MILLISECONDS;
+
+    // Store the mode
+    p_thread_pool->mode = p_attributes->mode;
+
+    // Store how idle workers wait
+    p_thread_pool->wait = p_attributes->wait;
+
+    // Store what a submit does when the queue is full
+    p_thread_pool->overflow              = p_attributes->overflow;
+    p_thread_pool->overflow_milliseconds = p_attributes->overflow_milliseconds;
+
+    // Store the quantity of checks an idle worker spins for before it parks
+    p_thread_pool->spin_iterations = ( p_attributes->spin_iterations == THREAD_POOL_SPIN_NONE ) ? 0 :
+                                     ( p_attributes->spin_iterations == 0 ) ? PARALLEL_THREAD_POOL_SPIN_ITERATIONS : p_attributes->spin_iterations;
+
+    // Choose a CPU for each slot. Busy polling workers are always pinned
+    for (size_t i = 0; i < thread_quantity; i++)
+        p_thread_pool->_threads[i]._thread.cpu = ( p_attributes->p_cpus ) ? p_attributes->p_cpus[i % p_attributes->cpu_quantity]
+                                               : ( p_attributes->wait == THREAD_POOL_WAIT_BUSY_POLL && p_attributes->placement == PARALLEL_THREAD_PLACEMENT_NONE ) ? parallel_thread_placement_cpu(PARALLEL_THREAD_PLACEMENT_PIN, i)
+                                               : parallel_thread_placement_cpu(p_attributes->placement, i);
+
+    // Set the running flag
+    atomic_init(&p_thread_pool->running, true);
+
+    // Construct a job queue for each priority
+    for (size_t i = 0; i < THREAD_POOL_PRIORITY_QUANTITY; i++)
+        if ( thread_pool_queue_construct(&p_thread_pool->_queues[i], p_attributes->queue_length ? p_attributes->queue_length : PARALLEL_THREAD_POOL_QUEUE_LENGTH) == 0 ) goto failed_to_construct_queue;
+
+    // Construct the futures
+    if ( thread_pool_futures_construct(p_thread_pool, p_attributes->future_quantity ? p_attributes->future_quantity : PARALLEL_THREAD_POOL_FUTURES) == 0 ) goto failed_to_construct_futures;
+
+    // Construct the job descriptors
+    if ( thread_pool_descriptors_construct(p_thread_pool, p_attributes->descriptor_quantity ? p_attributes->descriptor_quantity : PARALLEL_THREAD_POOL_DESCRIPTORS) == 0 ) goto failed_to_construct_descriptors;
+
+    // Lock
+    pthread_mutex_lock(&p_thread_pool->_lock);
+
+    // Start the minimum quantity of threads
+    for (size_t i = 0; i < min_thread_quantity; i++)
+    {
+
+        // Start a worker
+        if ( thread_pool_worker_start(p_thread_pool) ) continue;
+
+        // Unlock
+        pthread_mutex_unlock(&p_thread_pool->_lock);
+
+        // Error
+        goto failed_to_start_thread;
+    }
+
+    // Unlock
+    pthread_mutex_unlock(&p_thread_pool->_lock);
+
+    // Return a pointer to the caller
+    *pp_thread_pool = p_thread_pool;
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_thread_pool:
+                #ifndef NDEBUG
+                    log_error("[parallel] [thread pool] Null pointer provided for parameter \"pp_thread_pool\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            no_attributes:
+                #ifndef NDEBUG
+                    log_error("[parallel] [thread pool] Null pointer provided for parameter \"p_attributes\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            no_thread_quantity:
+                #ifndef NDEBUG
+                    log_error("[parallel] [thread pool] Null pointer provided for parameter \"thread_quantity\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            too_many_threads:
+                #ifndef NDEBUG
+                    log_error("[parallel] [thread pool] Parameter \"thread_quantity\" must be less than %d in call to function \"%s\"\n", PARALLEL_THREAD_POOL_MAX_THREADS, __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            invalid_max_thread_quantity:
+                #ifndef NDEBUG
+                    log_error("[parallel] [thread pool] Parameter \"p_attributes->max_thread_quantity\" must not be less than \"p_attributes->thread_quantity\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            invalid_mode:
+                #ifndef NDEBUG
+                    log_error("[parallel] [thread pool] Parameter \"p_attributes->mode\" is not a thread pool mode in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            invalid_placement:
+                #ifndef NDEBUG
+                    log_error("[parallel] [thread pool] Parameter \"p_attributes->placement\" is not a placement, or \"p_attributes->cpu_quantity\" is zero, in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            invalid_wait:
+                #ifndef NDEBUG
+                    log_error("[parallel] [thread pool] Parameter \"p_attributes->wait\" is not a wait strategy, or busy polls in an elastic pool, in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            invalid_queue_length:
+                #ifndef NDEBUG
+                    log_error("[parallel] [thread pool] Parameter \"p_attributes->queue_length\" must be a power of two in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            invalid_overflow:
+                #ifndef NDEBUG
+                    log_error("[parallel] [thread pool] Parameter \"p_attributes->overflow\" is not an overflow policy in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+
+        // Parallel errors
+        {
+            failed_to_create_thread_pool:
+                #ifndef NDEBUG
+                    log_error("[parallel] [thread pool] Failed to create thread pool in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            failed_to_construct_queue:
+                #ifndef NDEBUG
+                    log_error("[parallel] [thread pool] Failed to construct job queue in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Clean up
+                goto destroy_thread_pool;
+
+            failed_to_construct_futures:
+                #ifndef NDEBUG
+                    log_error("[parallel] [thread pool] Failed to construct futures in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Clean up
+                goto destroy_thread_pool;
+
+            failed_to_construct_descriptors:
+                #ifndef NDEBUG
+                    log_error("[parallel] [thread pool] Failed to construct job descriptors in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Clean up
+                goto destroy_thread_pool;
+
+            failed_to_start_thread:
+                #ifndef NDEBUG
+                    log_error("[parallel] [thread pool] Failed to create thread in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Clean up
+                goto destroy_thread_pool;
+
+            destroy_thread_pool:
+
+                // Stop and join the workers that started, and free what was built
+                thread_pool_destroy(&p_thread_pool);
+
+                // Error
+                return 0;
+        }
+
+        // Standard library errors
+        {
+            no_mem:
+                #ifndef NDEBUG
+                    log_error("[Standard Library] Failed to allocate memory in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Free the thread pool
+                PARALLEL_FREE(p_thread_pool);
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+int thread_pool_execute ( thread_pool *p_thread_pool, fn_parallel_task *pfn_parallel_task, void *p_parameter )
+{
+
+    // Success
+    return thread_pool_execute_with_priority(p_thread_pool, pfn_parallel_task, p_parameter, THREAD_POOL_PRIORITY_NORMAL);
+}
+
+int thread_pool_execute_with_priority ( thread_pool *p_thread_pool, fn_parallel_task *pfn_parallel_task, void *p_parameter, enum thread_pool_priority_e priority )
+{
+
+    // Argument check
+    if ( p_thread_pool     == (void *) 0 ) goto no_thread_pool;
+    if ( pfn_parallel_task == (void *) 0 ) goto no_parallel_task;
+    if ( priority >= THREAD_POOL_PRIORITY_QUANTITY ) goto invalid_priority;
+
+    // Initialized data
+    thread_pool_job _job =
+    {
+        .pfn_parallel_task = pfn_parallel_task,
+        .p_parameter       = p_parameter
+    };
+
+    // Count the job before a worker can see it
+    atomic_fetch_add(&p_thread_pool->outstanding_jobs, 1);
+
+    // Submit the job
+    if ( thread_pool_submit(p_thread_pool, &_job, priority, true) == 0 ) goto failed_to_submit;
+
+    // Wake a sleeping worker, if there is one
+    thread_pool_wake(p_thread_pool, 1);
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Parallel errors
+        {
+            failed_to_submit:
+
+                // The job was shed. Stop counting it
+                thread_pool_finish_job(p_thread_pool);
+
+                // Error
+                return 0;
+        }
+
+        // Argument errors
+        {
+            no_thread_pool:
+                #ifndef NDEBUG
+                    log_error("[parallel] [thread pool] Null pointer provided for parameter \"p_thread_pool\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            no_parallel_task:
+                #ifndef NDEBUG
+                    log_error("[parallel] [thread pool] Null pointer provided for parameter \"pfn_parallel_task\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            invalid_priority:
+                #ifndef NDEBUG
+                    log_error("[parallel] [thread pool] Parameter \"priority\" is not a thread pool priority in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+int thread_pool_execute_batch ( thread_pool *p_thread_pool, fn_parallel_task *pfn_parallel_task, void *const *pp_parameters, size_t quantity )
+{
+
+    // Argument check
+    if ( p_thread_pool     == (void *) 0 ) goto no_thread_pool;
+    if ( pfn_parallel_task == (void *) 0 ) goto no_parallel_task;
+    if ( pp_parameters     == (void *) 0 ) goto no_parameters;
+
+    // Nothing to do
+    if ( quantity == 0 ) return 1;
+
+    // Count every job before a worker can see any of them
+    atomic_fetch_add(&p_thread_pool->outstanding_jobs, quantity);
+
+    // Submit each job
+    for (size_t i = 0; i < quantity; i++)
+    {
+
+        // Initialized data
+        thread_pool_job _job =
+        {
+            .pfn_parallel_task = pfn_parallel_task,
+            .p_parameter       = pp_parameters[i]
+        };
+
+        // Submit the job
+        if ( thread_pool_submit(p_thread_pool, &_job, THREAD_POOL_PRIORITY_NORMAL, true) ) continue;
+
+        // Stop counting this job, and the jobs after it
+        for (size_t j = i; j < quantity; j++)
+            thread_pool_finish_job(p_thread_pool);
+
+        // Wake workers for the jobs that were submitted
+        thread_pool_wake(p_thread_pool, i);
+
+        // Error
+        goto failed_to_submit;
+    }
+
+    // Wake up to one sleeping worker per job
+    thread_pool_wake(p_thread_pool, quantity);
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Parallel errors
+        {
+            failed_to_submit:
+
+                // The job was shed
+                return 0;
+        }
+
+        // Argument errors
+        {
+            no_thread_pool:
+                #ifndef NDEBUG
+                    log_error("[parallel] [thread pool] Null pointer provided for parameter \"p_thread_pool\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            no_parallel_task:
+                #ifndef NDEBUG
+                    log_error("[parallel] [thread pool] Null pointer provided for parameter \"pfn_parallel_task\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            no_parameters:
+                #ifndef NDEBUG
+                    log_error("[parallel] [thread pool] Null pointer provided for parameter \"pp_parameters\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+int thread_pool_execute_inline ( thread_pool *p_thread_pool, fn_parallel_task *pfn_parallel_task, const void *p_parameter, size_t size, fn_parallel_destructor *pfn_destructor )
+{
+
+    // Argument check
+    if ( p_thread_pool     == (void *) 0 ) goto no_thread_pool;
+    if ( pfn_parallel_task == (void *) 0 ) goto no_parallel_task;
+    if ( size > THREAD_POOL_INLINE_PARAMETER_SIZE ) goto parameter_too_large;
+    if ( size && p_parameter == (void *) 0 ) goto no_parameter;
+
+    // Initialized data
+    thread_pool_descriptor *p_descriptor = (void *) 0;
+    bool                    worker       = thread_pool_on_worker(p_thread_pool);
+    struct timespec         _nap         = { 0 };
+
+    // Take a descriptor. If every descriptor is in use, run jobs until one is free
+    while ( ( p_descriptor = thread_pool_descriptor_acquire(p_thread_pool) ) == (void *) 0 )
+    {
+
+        // Run a job
+        if ( thread_pool_help(p_thread_pool) ) continue;
+
+        // Lock
+        pthread_mutex_lock(&p_thread_pool->_lock);
+
+        // Announce this producer before checking the free list again ...
+        atomic_fetch_add(&p_thread_pool->waiting_producers, 1);
+
+        // ... so a job that returns its descriptor after this point will signal.
+        // A worker naps, then looks for jobs again
+        if ( worker )
+        {
+
+            // Compute the end of the nap
+            thread_pool_deadline(&_nap, PARALLEL_THREAD_POOL_HELP_MILLISECONDS);
+
+            // Sleep until a descriptor is free, or the nap ends
+            while ( (uint32_t) atomic_load(&p_thread_pool->free_descriptors) == 0 )
+                if ( pthread_cond_timedwait(&p_thread_pool->_slot_available, &p_thread_pool->_lock, &_nap) == ETIMEDOUT ) break;
+        }
+
+        // Sleep until a descriptor is free
+        else while ( (uint32_t) atomic_load(&p_thread_pool->free_descriptors) == 0 )
+            pthread_cond_wait(&p_thread_pool->_slot_available, &p_thread_pool->_lock);
+
+        // This producer is done waiting
+        atomic_fetch_sub(&p_thread_pool->waiting_producers, 1);
+
+        // Unlock
+        pthread_mutex_unlock(&p_thread_pool->_lock);
+    }
+
+    // Set up the descriptor
+    p_descriptor->pfn_parallel_task = pfn_parallel_task;
+    p_descriptor->pfn_destructor    = pfn_destructor;
+    p_descriptor->p_parameter       = ( size ) ? p_descriptor->_parameter : (void *) p_parameter;
+
+    // Copy the parameter
+    if ( size ) memcpy(p_descriptor->_parameter, p_parameter, size);
+
+    // Run the descriptor's task on the thread pool
+    if ( thread_pool_execute(p_thread_pool, (fn_parallel_task *) thread_pool_descriptor_run, p_descriptor) == 0 ) goto failed_to_execute;
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_thread_pool:
+                #ifndef NDEBUG
+                    log_error("[parallel] [thread pool] Null pointer provided for parameter \"p_thread_pool\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            no_parallel_task:
+                #ifndef NDEBUG
+                    log_error("[parallel] [thread pool] Null pointer provided for parameter \"pfn_parallel_task\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            no_parameter:
+                #ifndef NDEBUG
+                    log_error("[parallel] [thread pool] Null pointer provided for parameter \"p_parameter\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            parameter_too_large:
+                #ifndef NDEBUG
+                    log_error("[parallel] [thread pool] Parameter \"size\" must not be more than %d in call to function \"%s\"\n", THREAD_POOL_INLINE_PARAMETER_SIZE, __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+
+        // Parallel errors
+        {
+            failed_to_execute:
+
+                // Return the descriptor
+                thread_pool_descriptor_recycle(p_descriptor);
+
+                #ifndef NDEBUG
+                    log_error("[parallel] [thread pool] Failed to execute job in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+int thread_pool_execute_future ( thread_pool *p_thread_pool, fn_parallel_task *pfn_parallel_task, void *p_parameter, thread_pool_future **pp_future )
+{
+
+    // Argument check
+    if ( p_thread_pool     == (void *) 0 ) goto no_thread_pool;
+    if ( pfn_parallel_task == (void *) 0 ) goto no_parallel_task;
+    if ( pp_future         == (void *) 0 ) goto no_future;
+
+    // Initialized data
+    thread_pool_future *p_future = thread_pool_future_acquire(p_thread_pool);
+
+    // Error check
+    if ( p_future == (void *) 0 ) goto no_free_futures;
+
+    // Set up the future
+    p_future->pfn_parallel_task = pfn_parallel_task;
+    p_future->p_parameter       = p_parameter;
+    p_future->ret               = (void *) 0;
+    atomic_store_explicit(&p_future->state, 0, memory_order_relaxed);
+    atomic_store_explicit(&p_future->p_continuation, (void *) 0, memory_order_relaxed);
+
+    // Run the future's task on the thread pool
+    if ( thread_pool_execute(p_thread_pool, (fn_parallel_task *) thread_pool_future_run, p_future) == 0 ) goto failed_to_execute;
+
+    // Return a pointer to the caller
+    *pp_future = p_future;
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_thread_pool:
+                #ifndef NDEBUG
+                    log_error("[parallel] [thread pool] Null pointer provided for parameter \"p_thread_pool\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            no_parallel_task:
+                #ifndef NDEBUG
+                    log_error("[parallel] [thread pool] Null pointer provided for parameter \"pfn_parallel_task\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            no_future:
+                #ifndef NDEBUG
+                    log_error("[parallel] [thread pool] Null pointer provided for parameter \"pp_future\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+
+        // Parallel errors
+        {
+            no_free_futures:
+                #ifndef NDEBUG
+                    log_error("[parallel] [thread pool] Every future is in use in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            failed_to_execute:
+
+                // Give back the future
+                thread_pool_future_recycle(p_future);
+
+                #ifndef NDEBUG
+                    log_error("[parallel] [thread pool] Failed to execute job in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+int thread_pool_future_wait ( thread_pool_future *p_future, void **pp_result )
+{
+
+    // Argument check
+    if ( p_future == (void *) 0 ) goto no_future;
+
+    // Wait forever
+    return thread_pool_future_wait_until(p_future, (void *) 0, pp_result);
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_future:
+                #ifndef NDEBUG
+                    log_error("[parallel] [thread pool] Null pointer provided for parameter \"p_future\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+int thread_pool_future_try_get ( thread_pool_future *p_future, void **pp_result )
+{
+
+    // Argument check
+    if ( p_future == (void *) 0 ) goto no_future;
+
+    // Not done yet
+    if ( ( atomic_load_explicit(&p_future->state, memory_order_acquire) & PARALLEL_THREAD_POOL_FUTURE_DONE ) == 0 ) return 0;
+
+    // Return the result to the caller
+    if ( pp_result ) *pp_result = p_future->ret;
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_future:
+                #ifndef NDEBUG
+                    log_error("[parallel] [thread pool] Null pointer provided for parameter \"p_future\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+int thread_pool_future_get_timeout ( thread_pool_future *p_future, size_t milliseconds, void **pp_result )
+{
+
+    // Argument check
+    if ( p_future == (void *) 0 ) goto no_future;
+
+    // Initialized data
+    struct timespec _deadline = { 0 };
+
+    // Fast path
+    if ( thread_pool_future_try_get(p_future, pp_result) ) return 1;
+
+    // Compute the deadline
+    thread_pool_deadline(&_deadline, milliseconds);
+
+    // Wait until the deadline
+    return thread_pool_future_wait_until(p_future, &_deadline, pp_result);
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_future:
+                #ifndef NDEBUG
+                    log_error("[parallel] [thread pool] Null pointer provided for parameter \"p_future\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+int thread_pool_future_destroy ( thread_pool_future **pp_future )
+{
+
+    // Argument check
+    if ( pp_future  == (void *) 0 ) goto no_future;
+    if ( *pp_future == (void *) 0 ) goto no_future;
+
+    // Initialized data
+    thread_pool_future *p_future = *pp_future;
+
+    // No more pointer for caller
+    *pp_future = (void *) 0;
+
+    // If the task is done, recycle the future now. Otherwise, the worker
+    // recycles it when the task finishes
+    if ( atomic_fetch_or(&p_future->state, PARALLEL_THREAD_POOL_FUTURE_DETACHED) & PARALLEL_THREAD_POOL_FUTURE_DONE )
+        thread_pool_future_recycle(p_future);
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_future:
+                #ifndef NDEBUG
+                    log_error("[parallel] [thread pool] Null pointer provided for parameter \"pp_future\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+int thread_pool_future_then ( thread_pool_future *p_future, fn_parallel_task *pfn_parallel_task, thread_pool_future **pp_future )
+{
+
+    // Argument check
+    if ( p_future          == (void *) 0 ) goto no_future;
+    if ( pfn_parallel_task == (void *) 0 ) goto no_parallel_task;
+
+    // Initialized data
+    thread_pool_future *p_continuation = thread_pool_future_acquire(p_future->p_thread_pool);
+
+    // Error check
+    if ( p_continuation == (void *) 0 ) goto no_free_futures;
+
+    // Set up the continuation. Without a caller, it is recycled when it is done
+    p_continuation->pfn_parallel_task = pfn_parallel_task;
+    p_continuation->p_parameter       = (void *) 0;
+    p_continuation->ret               = (void *) 0;
+    atomic_store_explicit(&p_continuation->state, ( pp_future ) ? 0 : PARALLEL_THREAD_POOL_FUTURE_DETACHED, memory_order_relaxed);
+    atomic_store_explicit(&p_continuation->p_continuation, (void *) 0, memory_order_relaxed);
+    atomic_store_explicit(&p_continuation->pending, 1, memory_order_relaxed);
+
+    // Return a pointer to the caller, before the continuation can finish
+    if ( pp_future ) *pp_future = p_continuation;
+
+    // Chain the continuation
+    if ( thread_pool_future_chain(p_future, p_continuation) == 0 ) goto already_continued;
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_future:
+                #ifndef NDEBUG
+                    log_error("[parallel] [thread pool] Null pointer provided for parameter \"p_future\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            no_parallel_task:
+                #ifndef NDEBUG
+                    log_error("[parallel] [thread pool] Null pointer provided for parameter \"pfn_parallel_task\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+
+        // Parallel errors
+        {
+            no_free_futures:
+                #ifndef NDEBUG
+                    log_error("[parallel] [thread pool] Every future is in use in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            already_continued:
+
+                // Give back the continuation
+                if ( pp_future ) *pp_future = (void *) 0;
+                thread_pool_future_recycle(p_continuation);
+
+                #ifndef NDEBUG
+                    log_error("[parallel] [thread pool] Future already has a continuation in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+int thread_pool_when_all ( thread_pool *p_thread_pool, thread_pool_future *const *pp_futures, size_t quantity, thread_pool_future **pp_future )
+{
+
+    // Argument check
+    if ( p_thread_pool == (void *) 0 ) goto no_thread_pool;
+    if ( pp_futures    == (void *) 0 && quantity ) goto no_futures;
+    if ( pp_future     == (void *) 0 ) goto no_future;
+
+    // Initialized data
+    thread_pool_future *p_all = (void *) 0;
+
+    // Every future needs a free continuation
+    for (size_t i = 0; i < quantity; i++)
+    {
+
+        // Error check
+        if ( pp_futures[i] == (void *) 0 ) goto no_futures;
+        if ( atomic_load(&pp_futures[i]->state) & PARALLEL_THREAD_POOL_FUTURE_CHAINED ) goto already_continued;
+    }
+
+    // Take a future
+    p_all = thread_pool_future_acquire(p_thread_pool);
+
+    // Error check
+    if ( p_all == (void *) 0 ) goto no_free_futures;
+
+    // Set up the future. It has no task, and its result is the array of futures.
+    // One extra antecedent keeps it from finishing while the others are chained
+    p_all->pfn_parallel_task = (void *) 0;
+    p_all->p_parameter       = (void *) pp_futures;
+    p_all->ret               = (void *) 0;
+    atomic_store_explicit(&p_all->state, 0, memory_order_relaxed);
+    atomic_store_explicit(&p_all->p_continuation, (void *) 0, memory_order_relaxed);
+    atomic_store_explicit(&p_all->pending, quantity + 1, memory_order_relaxed);
+
+    // Return a pointer to the caller, before the future can finish
+    *pp_future = p_all;
+
+    // Chain the future to each antecedent. A future that appears twice, or 
+    // that another thread continued since the check, fails to chain
+    for (size_t i = 0; i < quantity; i++)
+    {
+
+        // Chain the future
+        if ( thread_pool_future_chain(pp_futures[i], p_all) ) continue;
+
+        // No more pointer for caller
+        *pp_future = (void *) 0;
+
+        // Count each antecedent that was not chained as done, so the future 
+        // still finishes when the chained ones do
+        for (size_t j = i; j < quantity; j++)
+            thread_pool_future_arrive(p_all, (void *) 0);
+
+        // Drop the extra antecedent
+        thread_pool_future_arrive(p_all, (void *) 0);
+
+        // Nobody can wait on the future; it is recycled when it finishes
+        thread_pool_future_destroy(&p_all);
+
+        // Error
+        goto already_continued;
+    }
+
+    // Drop the extra antecedent
+    thread_pool_future_arrive(p_all, (void *) 0);
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_thread_pool:
+                #ifndef NDEBUG
+                    log_error("[parallel] [thread pool] Null pointer provided for parameter \"p_thread_pool\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            no_futures:
+                #ifndef NDEBUG
+                    log_error("[parallel] [thread pool] Null pointer provided for parameter \"pp_futures\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            no_future:
+                #ifndef NDEBUG
+                    log_error("[parallel] [thread pool] Null pointer provided for parameter \"pp_future\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+
+        // Parallel errors
+        {
+            no_free_futures:
+                #ifndef NDEBUG
+                    log_error("[parallel] [thread pool] Every future is in use in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            already_continued:
+                #ifndef NDEBUG
+                    log_error("[parallel] [thread pool] Future already has a continuation in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+int thread_pool_execute_after ( thread_pool *p_thread_pool, size_t milliseconds, fn_parallel_task *pfn_parallel_task, void *p_parameter, thread_pool_timer **pp_timer )
+{
+
+    // Argument check
+    if ( p_thread_pool     == (void *) 0 ) goto no_thread_pool;
+    if ( pfn_parallel_task == (void *) 0 ) goto no_parallel_task;
+
+    // Start a one shot timer
+    return thread_pool_timer_start(p_thread_pool, milliseconds, 0, pfn_parallel_task, p_parameter, pp_timer);
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_thread_pool:
+                #ifndef NDEBUG
+                    log_error("[parallel] [thread pool] Null pointer provided for parameter \"p_thread_pool\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            no_parallel_task:
+                #ifndef NDEBUG
+                    log_error("[parallel] [thread pool] Null pointer provided for parameter \"pfn_parallel_task\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+int thread_pool_execute_every ( thread_pool *p_thread_pool, size_t milliseconds, fn_parallel_task *pfn_parallel_task, void *p_parameter, thread_pool_timer **pp_timer )
+{
+
+    // Argument check
+    if ( p_thread_pool     == (void *) 0 ) goto no_thread_pool;
+    if ( pfn_parallel_task == (void *) 0 ) goto no_parallel_task;
+    if ( milliseconds      == 0          ) goto no_period;
+
+    // Start a periodic timer
+    return thread_pool_timer_start(p_thread_pool, milliseconds, milliseconds, pfn_parallel_task, p_parameter, pp_timer);
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_thread_pool:
+                #ifndef NDEBUG
+                    log_error("[parallel] [thread pool] Null pointer provided for parameter \"p_thread_pool\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            no_parallel_task:
+                #ifndef NDEBUG
+                    log_error("[parallel] [thread pool] Null pointer provided for parameter \"pfn_parallel_task\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            no_period:
+                #ifndef NDEBUG
+                    log_error("[parallel] [thread pool] Parameter \"milliseconds\" must be more than 0 in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+int thread_pool_timer_cancel ( thread_pool_timer **pp_timer )
+{
+
+    // Argument check
+    if ( pp_timer  == (void *) 0 ) goto no_timer;
+    if ( *pp_timer == (void *) 0 ) goto no_timer;
+
+    // Initialized data
+    thread_pool_timer       *p_timer = *pp_timer;
+    thread_pool_timer_wheel *p_wheel = p_timer->p_wheel;
+
+    // No more pointer for caller
+    *pp_timer = (void *) 0;
+
+    // The timer wheel is gone, and the caller holds the last reference
+    if ( p_wheel == (void *) 0 )
+    {
+
+        // Drop the caller's reference
+        thread_pool_timer_release(p_timer);
+
+        // Success
+        return 1;
+    }
+
+    // Lock
+    pthread_mutex_lock(&p_wheel->_lock);
+
+    // Take the timer off the list of timers with a handle
+    if ( p_timer->p_handle_next ) p_timer->p_handle_next->p_handle_previous = p_timer->p_handle_previous;
+    if ( p_timer->p_handle_previous ) p_timer->p_handle_previous->p_handle_next = p_timer->p_handle_next;
+    else p_wheel->p_handles = p_timer->p_handle_next;
+
+    // Take the timer out of the wheel. The wheel's reference goes with it, and
+    // the caller's is still held
+    if ( p_timer->level != -1 )
+    {
+        thread_pool_timer_remove(p_wheel, p_timer);
+        p_timer->references--;
+    }
+
+    // Drop the caller's reference
+    thread_pool_timer_release(p_timer);
+
+    // Unlock
+    pthread_mutex_unlock(&p_wheel->_lock);
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_timer:
+                #ifndef NDEBUG
+                    log_error("[parallel] [thread pool] Null pointer provided for parameter \"pp_timer\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+int thread_pool_group_construct ( thread_pool_group **pp_group, thread_pool *p_thread_pool )
+{
+
+    // Argument check
+    if ( pp_group      == (void *) 0 ) goto no_group;
+    if ( p_thread_pool == (void *) 0 ) goto no_thread_pool;
+
+    // Initialized data
+    thread_pool_group *p_group = PARALLEL_REALLOC(0, sizeof(thread_pool_group));
+
+    // Error check
+    if ( p_group == (void *) 0 ) goto no_mem;
+
+    // Zero set the task group
+    memset(p_group, 0, sizeof(thread_pool_group));
+
+    // Store the thread pool
+    p_group->p_thread_pool = p_thread_pool;
+
+    // Construct the group's job queue
+    if ( thread_pool_queue_construct(&p_group->_queue, PARALLEL_THREAD_POOL_GROUP_QUEUE_LENGTH) == 0 ) goto failed_to_construct_queue;
+
+    // The caller holds the first reference
+    atomic_init(&p_group->outstanding_jobs, 0);
+    atomic_init(&p_group->references, 1);
+    atomic_init(&p_group->waiters, 0);
+
+    // Initialize the waiter's lock, and a condition that naps on the monotonic clock
+    {
+
+        // Initialized data
+        pthread_condattr_t _attributes;
+
+        // Initialize the lock
+        pthread_mutex_init(&p_group->_lock, NULL);
+
+        // Initialize the condition
+        pthread_condattr_init(&_attributes);
+        pthread_condattr_setclock(&_attributes, CLOCK_MONOTONIC);
+        pthread_cond_init(&p_group->_done, &_attributes);
+        pthread_condattr_destroy(&_attributes);
+    }
+
+    // Return a pointer to the caller
+    *pp_group = p_group;
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_group:
+                #ifndef NDEBUG
+                    log_error("[parallel] [thread pool] Null pointer provided for parameter \"pp_group\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            no_thread_pool:
+                #ifndef NDEBUG
+                    log_error("[parallel] [thread pool] Null pointer provided for parameter \"p_thread_pool\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+
+        // Parallel errors
+        {
+            failed_to_construct_queue:
+
+                // Free the task group
+                PARALLEL_FREE(p_group);
+
+                #ifndef NDEBUG
+                    log_error("[parallel] [thread pool] Failed to construct job queue in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+
+        // Standard library errors
+        {
+            no_mem:
+                #ifndef NDEBUG
+                    log_error("[Standard Library] Failed to allocate memory in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+int thread_pool_group_execute ( thread_pool_group *p_group, fn_parallel_task *pfn_parallel_task, void *p_parameter )
+{
+
+    // Argument check
+    if ( p_group           == (void *) 0 ) goto no_group;
+    if ( pfn_parallel_task == (void *) 0 ) goto no_parallel_task;
+
+    // Initialized data
+    thread_pool_job _job =
+    {
+        .pfn_parallel_task = pfn_parallel_task,
+        .p_parameter       = p_parameter
+    };
+    bool            worker = thread_pool_on_worker(p_group->p_thread_pool);
+    struct timespec _nap   = { 0 };
+
+    // Count the job, and the reference its run holds, before anyone can see it
+    atomic_fetch_add(&p_group->outstanding_jobs, 1);
+    atomic_fetch_add(&p_group->references, 1);
+
+    // Queue the job in the group. If the group's queue is full, run the group's jobs until a slot is free
+    while ( thread_pool_queue_enqueue(&p_group->_queue, &_job) == 0 )
+    {
+
+        // Run a queued job of the group
+        if ( thread_pool_group_help(p_group) ) continue;
+
+        // Lock
+        pthread_mutex_lock(&p_group->_lock);
+
+        // Announce this producer before checking the queue again ...
+        atomic_fetch_add(&p_group->waiting_producers, 1);
+
+        // ... so a job that leaves the queue after this point will signal. A 
+        // worker naps, then looks for jobs again
+        if ( worker )
+        {
+
+            // Compute the end of the nap
+            thread_pool_deadline(&_nap, PARALLEL_THREAD_POOL_HELP_MILLISECONDS);
+
+            // Sleep until the queue has a free slot, or the nap ends
+            while ( thread_pool_queue_full(&p_group->_queue) )
+                if ( pthread_cond_timedwait(&p_group->_done, &p_group->_lock, &_nap) == ETIMEDOUT ) break;
+        }
+
+        // Sleep until the queue has a free slot
+        else while ( thread_pool_queue_full(&p_group->_queue) )
+            pthread_cond_wait(&p_group->_done, &p_group->_lock);
+
+        // This producer is done waiting
+        atomic_fetch_sub(&p_group->waiting_producers, 1);
+
+        // Unlock
+        pthread_mutex_unlock(&p_group->_lock);
+    }
+
+    // Run one of the group's jobs on the thread pool
+    thread_pool_post(p_group->p_thread_pool, (fn_parallel_task *) thread_pool_group_run, p_group);
+
+    // Order the enqueue before the waiter check
+    atomic_thread_fence(memory_order_seq_cst);
+
+    // Wake the waiters, so they can run the job themselves
+    if ( atomic_load_explicit(&p_group->waiters, memory_order_relaxed) )
+    {
+
+        // Lock
+        pthread_mutex_lock(&p_group->_lock);
+
+        // Signal every waiter
+        pthread_cond_broadcast(&p_group->_done);
+
+        // Unlock
+        pthread_mutex_unlock(&p_group->_lock);
+    }
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_group:
+                #ifndef NDEBUG
+                    log_error("[parallel] [thread pool] Null pointer provided for parameter \"p_group\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            no_parallel_task:
+                #ifndef NDEBUG
+                    log_error("[parallel] [thread pool] Null pointer provided for parameter \"pfn_parallel_task\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+int thread_pool_group_wait ( thread_pool_group *p_group )
+{
+
+    // Argument check
+    if ( p_group == (void *) 0 ) goto no_group;
+
+    // Initialized data
+    bool            worker = thread_pool_on_worker(p_group->p_thread_pool);
+    struct timespec _nap   = { 0 };
+
+    // Until every job of the group finishes
+    while ( atomic_load(&p_group->outstanding_jobs) )
+    {
+
+        // Run a queued job of the group
+        if ( thread_pool_group_help(p_group) ) continue;
+
+        // A worker runs other jobs instead of sleeping, so a job that waits on 
+        // its group never holds up the thread pool
+        if ( worker && thread_pool_help(p_group->p_thread_pool) ) continue;
+
+        // Announce the waiter
+        atomic_fetch_add(&p_group->waiters, 1);
+
+        // Lock
+        pthread_mutex_lock(&p_group->_lock);
+
+        // A worker naps, then looks for jobs again
+        if ( worker )
+        {
+
+            // Compute the end of the nap
+            thread_pool_deadline(&_nap, PARALLEL_THREAD_POOL_HELP_MILLISECONDS);
+
+            // Sleep until the group finishes, queues another job, or the nap ends
+            while ( atomic_load(&p_group->outstanding_jobs) && thread_pool_queue_empty(&p_group->_queue) )
+                if ( pthread_cond_timedwait(&p_group->_done, &p_group->_lock, &_nap) == ETIMEDOUT ) break;
+        }
+
+        // Sleep until the group finishes, or queues another job
+        else while ( atomic_load(&p_group->outstanding_jobs) && thread_pool_queue_empty(&p_group->_queue) )
+            pthread_cond_wait(&p_group->_done, &p_group->_lock);
+
+        // Unlock
+        pthread_mutex_unlock(&p_group->_lock);
+
+        // Withdraw the waiter
+        atomic_fetch_sub(&p_group->waiters, 1);
+    }
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_group:
+                #ifndef NDEBUG
+                    log_error("[parallel] [thread pool] Null pointer provided for parameter \"p_group\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+int thread_pool_group_destroy ( thread_pool_group **pp_group )
+{
+
+    // Argument check
+    if ( pp_group  == (void *) 0 ) goto no_group;
+    if ( *pp_group == (void *) 0 ) goto no_group;
+
+    // Initialized data
+    thread_pool_group *p_group = *pp_group;
+
+    // No more pointer for caller
+    *pp_group = (void *) 0;
+
+    // Drop the caller's reference. Runs that are still queued hold their own
+    thread_pool_group_release(p_group);
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_group:
+                #ifndef NDEBUG
+                    log_error("[parallel] [thread pool] Null pointer provided for parameter \"pp_group\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+int parallel_for ( thread_pool *p_thread_pool, size_t begin, size_t end, size_t grain, fn_parallel_for *pfn_parallel_for, void *p_context )
+{
+
+    // Argument check
+    if ( p_thread_pool    == (void *) 0 ) goto no_thread_pool;
+    if ( pfn_parallel_for == (void *) 0 ) goto no_parallel_for;
+
+    // Nothing to do
+    if ( begin >= end ) return 1;
+
+    // Initialized data
+    thread_pool_for       _for                                     = { 0 };
+    thread_pool_for_range _ranges[PARALLEL_THREAD_POOL_FOR_RANGES] = { 0 };
+    thread_pool_for_range _root                                    = { 0 };
+    struct timespec       _nap                                     = { 0 };
+    size_t                length                                   = end - begin,
+                          max_pieces                               = PARALLEL_THREAD_POOL_FOR_PIECES * ( atomic_load(&p_thread_pool->live_threads) + 1 ),
+                          pieces                                   = 0;
+
+    // Pieces are never smaller than the grain ...
+    if ( grain == 0 ) grain = 1;
+    pieces = ( length + grain - 1 ) / grain;
+
+    // ... and there are only a few per thread, so splitting stays cheap
+    if ( pieces > max_pieces ) pieces = max_pieces;
+
+    // Populate the parallel for
+    _for = (thread_pool_for)
+    {
+        .p_thread_pool    = p_thread_pool,
+        .pfn_parallel_for = pfn_parallel_for,
+        .p_context        = p_context,
+        .begin            = begin,
+        .end              = end,
+        .piece_size       = ( length + pieces - 1 ) / pieces,
+        .p_ranges         = _ranges,
+        .done             = false
+    };
+
+    // Rounding the piece size up may leave fewer pieces
+    pieces = ( length + _for.piece_size - 1 ) / _for.piece_size;
+
+    // Every piece but the first is run from its own range
+    if ( pieces - 1 > PARALLEL_THREAD_POOL_FOR_RANGES )
+    {
+
+        // Allocate memory for the ranges
+        _for.p_ranges = PARALLEL_REALLOC(0, ( pieces - 1 ) * sizeof(thread_pool_for_range));
+
+        // Error check
+        if ( _for.p_ranges == (void *) 0 ) goto no_mem;
+    }
+
+    // The caller runs the root range
+    atomic_init(&_for.pending_ranges, 1);
+    atomic_init(&_for.next_range, 0);
+    pthread_mutex_init(&_for._lock, NULL);
+    pthread_cond_init(&_for._done, NULL);
+
+    // Populate the root range
+    _root = (thread_pool_for_range)
+    {
+        .p_for = &_for,
+        .first = 0,
+        .last  = pieces
+    };
+
+    // Run the root range
+    thread_pool_for_run(&_root);
+
+    // Until every range is done
+    while ( atomic_load(&_for.pending_ranges) )
+    {
+
+        // Run a queued job
+        if ( thread_pool_help(p_thread_pool) ) continue;
+
+        // Nothing to run, but other workers may still be splitting ranges, so
+        // nap, then look for jobs again
+        pthread_mutex_lock(&_for._lock);
+
+        // Compute the end of the nap
+        thread_pool_deadline(&_nap, PARALLEL_THREAD_POOL_HELP_MILLISECONDS);
+
+        // Sleep until the last range is done, or the nap ends
+        while ( _for.done == false )
+            if ( pthread_cond_timedwait(&_for._done, &_for._lock, &_nap) == ETIMEDOUT ) break;
+
+        // Unlock
+        pthread_mutex_unlock(&_for._lock);
+    }
+
+    // Lock
+    pthread_mutex_lock(&_for._lock);
+
+    // Wait for the last range to let go of the lock
+    while ( _for.done == false ) pthread_cond_wait(&_for._done, &_for._lock);
+
+    // Unlock
+    pthread_mutex_unlock(&_for._lock);
+
+    // Clean up
+    pthread_cond_destroy(&_for._done);
+    pthread_mutex_destroy(&_for._lock);
+    if ( _for.p_ranges != _ranges ) PARALLEL_FREE(_for.p_ranges);
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_thread_pool:
+                #ifndef NDEBUG
+                    log_error("[parallel] [thread pool] Null pointer provided for parameter \"p_thread_pool\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            no_parallel_for:
+                #ifndef NDEBUG
+                    log_error("[parallel] [thread pool] Null pointer provided for parameter \"pfn_parallel_for\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+
+        // Standard library errors
+        {
+            no_mem:
+                #ifndef NDEBUG
+                    log_error("[Standard Library] Failed to allocate memory in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+int parallel_reduce ( thread_pool *p_thread_pool, size_t begin, size_t end, size_t grain, size_t size, const void *p_identity, fn_parallel_reduce *pfn_parallel_reduce, fn_parallel_combine *pfn_parallel_combine, void *p_context, void *p_result )
+{
+
+    // Argument check
+    if ( p_thread_pool        == (void *) 0 ) goto no_thread_pool;
+    if ( size                 ==          0 ) goto no_size;
+    if ( p_identity           == (void *) 0 ) goto no_identity;
+    if ( pfn_parallel_reduce  == (void *) 0 ) goto no_parallel_reduce;
+    if ( pfn_parallel_combine == (void *) 0 ) goto no_parallel_combine;
+    if ( p_result             == (void *) 0 ) goto no_result;
+
+    // Initialized data
+    thread_pool_reduce _reduce = { 0 };
+    void              *p_memory = (void *) 0;
+    size_t             slot_size = sizeof(thread_pool_reduce_slot) + size;
+
+    // Each partial starts on its own cache line, so no two workers write the same line
+    slot_size = ( slot_size + PARALLEL_CACHE_LINE_SIZE - 1 ) & ~( (size_t) PARALLEL_CACHE_LINE_SIZE - 1 );
+
+    // Populate the parallel reduce. Every worker gets a partial, then the 
+    // caller, then a shared partial for every other thread
+    _reduce = (thread_pool_reduce)
+    {
+        .p_thread_pool        = p_thread_pool,
+        .pfn_parallel_reduce  = pfn_parallel_reduce,
+        .pfn_parallel_combine = pfn_parallel_combine,
+        .p_identity           = p_identity,
+        .p_context            = p_context,
+        .caller               = pthread_self(),
+        .size                 = size,
+        .slot_size            = slot_size,
+        .slot_quantity        = p_thread_pool->thread_quantity + 2
+    };
+
+    // Allocate memory for the partials
+    p_memory = PARALLEL_REALLOC(0, _reduce.slot_quantity * slot_size + PARALLEL_CACHE_LINE_SIZE - 1);
+
+    // Error check
+    if ( p_memory == (void *) 0 ) goto no_mem;
+
+    // Align the partials to a cache line
+    _reduce.p_slots = (unsigned char *) ( ( (uintptr_t) p_memory + PARALLEL_CACHE_LINE_SIZE - 1 ) & ~( (uintptr_t) PARALLEL_CACHE_LINE_SIZE - 1 ) );
+
+    // Start each partial at the identity
+    for (size_t i = 0; i < _reduce.slot_quantity; i++)
+    {
+
+        // Initialized data
+        thread_pool_reduce_slot *p_slot = thread_pool_reduce_slot_get(&_reduce, i);
+
+        // Populate the partial
+        p_slot->busy = false;
+        p_slot->used = false;
+        memcpy(p_slot->_value, p_identity, size);
+    }
+
+    // Construct the shared lock
+    pthread_mutex_init(&_reduce._shared_lock, NULL);
+
+    // Fold the range into the partials
+    if ( parallel_for(p_thread_pool, begin, end, grain, (fn_parallel_for *) thread_pool_reduce_run, &_reduce) == 0 ) goto failed_to_run;
+
+    // Error check
+    if ( atomic_load(&_reduce.failed) ) goto failed_to_run;
+
+    // Combine the partials on the caller, one after another. There are only a
+    // few more partials than workers, so the combine is not worth a parallel 
+    // pass. Each pass combines pairs that are stride apart, and the final value
+    // lands in the first partial
+    for (size_t stride = 1; stride < _reduce.slot_quantity; stride *= 2)
+    {
+        for (size_t i = 0; i + stride < _reduce.slot_quantity; i += 2 * stride)
+        {
+
+            // Initialized data
+            thread_pool_reduce_slot *p_left  = thread_pool_reduce_slot_get(&_reduce, i),
+                                    *p_right = thread_pool_reduce_slot_get(&_reduce, i + stride);
+
+            // Nothing to combine
+            if ( p_right->used == false ) continue;
+
+            // Combine the partials ...
+            if ( p_left->used ) pfn_parallel_combine(p_left->_value, p_right->_value, p_context);
+
+            // ... or take the right partial as is
+            else memcpy(p_left->_value, p_right->_value, size), p_left->used = true;
+        }
+    }
+
+    // Return the result to the caller
+    memcpy(p_result, thread_pool_reduce_slot_get(&_reduce, 0)->_value, size);
+
+    // Clean up
+    pthread_mutex_destroy(&_reduce._shared_lock);
+    PARALLEL_FREE(p_memory);
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_thread_pool:
+                #ifndef NDEBUG
+                    log_error("[parallel] [thread pool] Null pointer provided for parameter \"p_thread_pool\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            no_size:
+                #ifndef NDEBUG
+                    log_error("[parallel] [thread pool] Parameter \"size\" must be greater than zero in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            no_identity:
+                #ifndef NDEBUG
+                    log_error("[parallel] [thread pool] Null pointer provided for parameter \"p_identity\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            no_parallel_reduce:
+                #ifndef NDEBUG
+                    log_error("[parallel] [thread pool] Null pointer provided for parameter \"pfn_parallel_reduce\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            no_parallel_combine:
+                #ifndef NDEBUG
+                    log_error("[parallel] [thread pool] Null pointer provided for parameter \"pfn_parallel_combine\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            no_result:
+                #ifndef NDEBUG
+                    log_error("[parallel] [thread pool] Null pointer provided for parameter \"p_result\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+
+        // Parallel errors
+        {
+            failed_to_run:
+
+                // Clean up
+                pthread_mutex_destroy(&_reduce._shared_lock);
+                PARALLEL_FREE(p_memory);
+
+                #ifndef NDEBUG
+                    log_error("[parallel] [thread pool] Failed to run parallel for in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+
+        // Standard library errors
+        {
+            no_mem:
+                #ifndef NDEBUG
+                    log_error("[Standard Library] Failed to allocate memory in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+size_t thread_pool_get_thread_quantity ( thread_pool *p_thread_pool )
+{
+
+    // Argument check
+    if ( p_thread_pool == (void *) 0 ) goto no_thread_pool;
+
+    // Success
+    return atomic_load(&p_thread_pool->live_threads);
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_thread_pool:
+                #ifndef NDEBUG
+                    log_error("[parallel] [thread pool] Null pointer provided for parameter \"p_thread_pool\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+int thread_pool_get_placement ( thread_pool *p_thread_pool, size_t index, int *p_cpu, int *p_node )
+{
+
+    // Argument check
+    if ( p_thread_pool                  == (void *) 0 ) goto no_thread_pool;
+    if ( index >= p_thread_pool->thread_quantity     ) goto invalid_index;
+
+    // Initialized data
+    int cpu = p_thread_pool->_threads[index]._thread.cpu;
+
+    // Return the CPU to the caller
+    if ( p_cpu ) *p_cpu = cpu;
+
+    // Return the NUMA node to the caller
+    if ( p_node ) *p_node = parallel_thread_cpu_node(cpu);
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_thread_pool:
+                #ifndef NDEBUG
+                    log_error("[parallel] [thread pool] Null pointer provided for parameter \"p_thread_pool\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            invalid_index:
+                #ifndef NDEBUG
+                    log_error("[parallel] [thread pool] Parameter \"index\" is out of range in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+bool thread_pool_is_idle ( thread_pool *p_thread_pool )
+{
+
+    // Argument check
+    if ( p_thread_pool == (void *) 0 ) goto no_thread_pool;
+
+    // Done
+    return atomic_load(&p_thread_pool->outstanding_jobs) == 0;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_thread_pool:
+                #ifndef NDEBUG
+                    log_error("[parallel] [thread pool] Null pointer provided for parameter \"p_thread_pool\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return false;
+        }
+    }
+}
+
+int thread_pool_stats ( thread_pool *p_thread_pool, thread_pool_statistics *p_statistics )
+{
+
+    // Argument check
+    if ( p_thread_pool == (void *) 0 ) goto no_thread_pool;
+    if ( p_statistics  == (void *) 0 ) goto no_statistics;
+
+    // Initialized data
+    size_t started_threads = atomic_load_explicit(&p_thread_pool->started_threads, memory_order_acquire);
+
+    // Initialize data
+    memset(p_statistics, 0, sizeof(thread_pool_statistics));
+
+    // Store the quantity of threads
+    p_statistics->thread_quantity = atomic_load(&p_thread_pool->live_threads);
+
+    // Sample the queues now
+    p_statistics->queue_depth     = thread_pool_queue_depth(p_thread_pool);
+    p_statistics->max_queue_depth = p_statistics->queue_depth;
+
+    // Sum each worker's counters. A retired worker's slot keeps its counters
+    for (size_t i = 0; i < started_threads; i++)
+    {
+
+        // Initialized data
+        thread_pool_thread *p_thread_pool_thread = &p_thread_pool->_threads[i]._thread;
+        size_t              max_queue_depth      = (size_t) atomic_load_explicit(&p_thread_pool_thread->max_queue_depth, memory_order_relaxed);
+
+        // Sum the counters
+        p_statistics->jobs             += atomic_load_explicit(&p_thread_pool_thread->jobs, memory_order_relaxed);
+        p_statistics->busy_nanoseconds += atomic_load_explicit(&p_thread_pool_thread->busy_nanoseconds, memory_order_relaxed);
+        p_statistics->idle_nanoseconds += atomic_load_explicit(&p_thread_pool_thread->idle_nanoseconds, memory_order_relaxed);
+        p_statistics->steals           += atomic_load_explicit(&p_thread_pool_thread->steals, memory_order_relaxed);
+
+        // Keep the deepest sample
+        if ( max_queue_depth > p_statistics->max_queue_depth ) p_statistics->max_queue_depth = max_queue_depth;
+
+        // Sum the histogram
+        for (size_t j = 0; j < THREAD_POOL_LATENCY_BUCKETS; j++)
+            p_statistics->latency[j] += atomic_load_explicit(&p_thread_pool_thread->latency[j], memory_order_relaxed);
+    }
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_thread_pool:
+                #ifndef NDEBUG
+                    log_error("[parallel] [thread pool] Null pointer provided for parameter \"p_thread_pool\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            no_statistics:
+                #ifndef NDEBUG
+                    log_error("[parallel] [thread pool] Null pointer provided for parameter \"p_statistics\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+int thread_pool_wait_idle ( thread_pool *p_thread_pool )
+{
+
+    // Argument check
+    if ( p_thread_pool == (void *) 0 ) goto no_thread_pool;
+
+    // State check; the job that is waiting keeps the thread pool busy
+    if ( thread_pool_on_worker(p_thread_pool) ) goto called_from_worker;
+
+    // Fast path; nothing is outstanding
+    if ( atomic_load(&p_thread_pool->outstanding_jobs) == 0 ) return 1;
+
+    // Lock
+    pthread_mutex_lock(&p_thread_pool->_lock);
+
+    // Announce this waiter before checking the counter again ...
+    atomic_fetch_add(&p_thread_pool->idle_waiters, 1);
+
+    // ... so the last job to finish will signal
+    while ( atomic_load(&p_thread_pool->outstanding_jobs) )
+        pthread_cond_wait(&p_thread_pool->_idle, &p_thread_pool->_lock);
+
+    // This waiter is done waiting
+    atomic_fetch_sub(&p_thread_pool->idle_waiters, 1);
+
+    // Unlock
+    pthread_mutex_unlock(&p_thread_pool->_lock);
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_thread_pool:
+                #ifndef NDEBUG
+                    log_error("[parallel] [thread pool] Null pointer provided for parameter \"p_thread_pool\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+
+        // Parallel errors
+        {
+            called_from_worker:
+                #ifndef NDEBUG
+                    log_error("[parallel] [thread pool] A job can not wait for its own thread pool to be idle in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+int thread_pool_wait_idle_timeout ( thread_pool *p_thread_pool, size_t milliseconds )
+{
+
+    // Argument check
+    if ( p_thread_pool == (void *) 0 ) goto no_thread_pool;
+
+    // State check; the job that is waiting keeps the thread pool busy
+    if ( thread_pool_on_worker(p_thread_pool) ) goto called_from_worker;
+
+    // Initialized data
+    struct timespec _deadline = { 0 };
+    bool            idle      = true;
+
+    // Fast path; nothing is outstanding
+    if ( atomic_load(&p_thread_pool->outstanding_jobs) == 0 ) return 1;
+
+    // Compute the deadline
+    thread_pool_deadline(&_deadline, milliseconds);
+
+    // Lock
+    pthread_mutex_lock(&p_thread_pool->_lock);
+
+    // Announce this waiter before checking the counter again ...
+    atomic_fetch_add(&p_thread_pool->idle_waiters, 1);
+
+    // ... so the last job to finish will signal
+    while ( atomic_load(&p_thread_pool->outstanding_jobs) )
+    {
+
+        // Wait until signaled, or until the deadline passes
+        if ( pthread_cond_timedwait(&p_thread_pool->_idle, &p_thread_pool->_lock, &_deadline) == ETIMEDOUT )
+        {
+
+            // One last look
+            idle = ( atomic_load(&p_thread_pool->outstanding_jobs) == 0 );
+
+            // Done
+            break;
+        }
+    }
+
+    // This waiter is done waiting
+    atomic_fetch_sub(&p_thread_pool->idle_waiters, 1);
+
+    // Unlock
+    pthread_mutex_unlock(&p_thread_pool->_lock);
+
+    // Done
+    return idle;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_thread_pool:
+                #ifndef NDEBUG
+                    log_error("[parallel] [thread pool] Null pointer provided for parameter \"p_thread_pool\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+
+        // Parallel errors
+        {
+            called_from_worker:
+                #ifndef NDEBUG
+                    log_error("[parallel] [thread pool] A job can not wait for its own thread pool to be idle in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+int thread_pool_destroy ( thread_pool **pp_thread_pool )
+{
+
+    // Argument check
+    if ( pp_thread_pool  == (void *) 0 ) goto no_thread_pool;
+    if ( *pp_thread_pool == (void *) 0 ) goto no_thread_pool;
+
+    // Initialized data
+    thread_pool *p_thread_pool = *pp_thread_pool;
+
+    // No more pointer for caller
+    *pp_thread_pool = (void *) 0;
+
+    // Stop the timer thread first; it queues jobs
+    if ( atomic_load(&p_thread_pool->p_timer_wheel) ) thread_pool_timer_wheel_destroy(atomic_load(&p_thread_pool->p_timer_wheel));
+
+    // Lock
+    pthread_mutex_lock(&p_thread_pool->_lock);
+
+    // Clear the running flag
+    atomic_store(&p_thread_pool->running, false);
+
+    // Wake every parked worker
+    thread_pool_unpark(p_thread_pool, p_thread_pool->thread_quantity);
+
+    // Unlock
+    pthread_mutex_unlock(&p_thread_pool->_lock);
+
+    // Workers drain the queue before they exit
+    for (size_t i = 0; i < p_thread_pool->thread_quantity; i++)
+
+        // Join the worker, or the thread of a retired worker
+        if ( p_thread_pool->_threads[i]._thread.p_parallel_thread )
+            if ( parallel_thread_join(&p_thread_pool->_threads[i]._thread.p_parallel_thread) == 0 ) goto failed_to_join_thread;
+
+    // Destroy each job queue
+    for (size_t i = 0; i < THREAD_POOL_PRIORITY_QUANTITY; i++)
+        thread_pool_queue_destroy(&p_thread_pool->_queues[i]);
+
+    // Destroy each deque
+    if ( p_thread_pool->mode == THREAD_POOL_MODE_WORK_STEALING )
+        for (size_t i = 0; i < atomic_load(&p_thread_pool->started_threads); i++)
+            thread_pool_deque_destroy(&p_thread_pool->_threads[i]._thread._deque);
+
+    // Destroy the futures
+    for (size_t i = 0; i < p_thread_pool->future_quantity; i++)
+    {
+        pthread_cond_destroy(&p_thread_pool->p_futures[i]._done);
+        pthread_mutex_destroy(&p_thread_pool->p_futures[i]._lock);
+    }
+
+    // Free the futures
+    PARALLEL_FREE(p_thread_pool->p_futures);
+
+    // Free the job descriptors
+    PARALLEL_FREE(p_thread_pool->p_descriptor_memory);
+
+    // Destroy the lock and the condition variables
+    pthread_cond_destroy(&p_thread_pool->_idle);
+    pthread_cond_destroy(&p_thread_pool->_slot_available);
+    pthread_mutex_destroy(&p_thread_pool->_lock);
+
+    // Destroy each worker's parking spot
+    #ifndef __linux__
+        for (size_t i = 0; i < atomic_load(&p_thread_pool->started_threads); i++)
+        {
+            pthread_cond_destroy(&p_thread_pool->_threads[i]._thread._park);
+            pthread_mutex_destroy(&p_thread_pool->_threads[i]._thread._park_lock);
+        }
+    #endif
+
+    // Free the thread pool
+    PARALLEL_FREE(p_thread_pool);
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_thread_pool:
+                #ifndef NDEBUG
+                    log_error("[parallel] [thread pool] Null pointer provided for parameter \"pp_thread_pool\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+
+        // Parallel errors
+        {
+            failed_to_join_thread:
+                #ifndef NDEBUG
+                    log_error("[parallel] [thread pool] Failed to join thread in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+void *thread_pool_work ( thread_pool_work_parameter *p_parameter )
+{
+
+    // Argument check
+    if ( p_parameter == (void *) 0 ) goto no_work_parameter;
+
+    // Initialized data
+    thread_pool        *p_thread_pool        = p_parameter->p_thread_pool;
+    thread_pool_thread *p_thread_pool_thread = &p_parameter->_thread;
+    thread_pool_job     _job                 = { 0 };
+
+    // Remember which worker this thread is
+    p_thread_pool_current_worker = p_parameter;
+
+    // Name the worker's track in a trace
+    {
+
+        // Initialized data
+        char _name[64] = { 0 };
+
+        // Name the worker after its slot
+        snprintf(_name, sizeof(_name), "thread pool worker %zu", (size_t) ( p_parameter - p_thread_pool->_threads ));
+
+        // Name the thread
+        parallel_trace_name_thread(_name);
+    }
+
+    // Start counting idle time
+    p_thread_pool_thread->last = thread_pool_clock();
+
+    wait_for_next_task:
+
+    // Run jobs until there are none left
+    while ( thread_pool_next_job(p_parameter, &_job) )
+    {
+
+        // Add a worker to an elastic thread pool if jobs are waiting
+        if ( p_thread_pool->thread_quantity != p_thread_pool->min_thread_quantity ) thread_pool_grow(p_thread_pool);
+
+        // Run the user's task
+        p_thread_pool_thread->ret = thread_pool_run_job(p_parameter, &_job);
+
+        // Count the job as done
+        thread_pool_finish_job(p_thread_pool);
+    }
+
+    // A busy polling worker never parks
+    if ( p_thread_pool->wait == THREAD_POOL_WAIT_BUSY_POLL )
+    {
+
+        // Poll until there is a job, or the thread pool is destroyed. Back off 
+        // exponentially, so idle pollers don't hammer the queues' cache lines
+        for (size_t backoff = 1; thread_pool_has_work(p_thread_pool) == false && atomic_load_explicit(&p_thread_pool->running, memory_order_relaxed); backoff = ( backoff < PARALLEL_THREAD_POOL_BACKOFF_LIMIT ) ? backoff * 2 : backoff)
+            for (size_t i = 0; i < backoff; i++)
+                PARALLEL_THREAD_POOL_PAUSE();
+
+        // Run the job
+        goto wake;
+    }
+
+    // Spin for a while, in case another job arrives soon
+    if ( p_thread_pool->spin_iterations )
+    {
+
+        // Initialized data
+        bool found = false;
+
+        // Announce this worker, so producers don't wake a parked one
+        atomic_fetch_add(&p_thread_pool->spinning_threads, 1);
+
+        // Spin until there is a job, the thread pool is destroyed, or the spin ends
+        for (size_t i = 0; i < p_thread_pool->spin_iterations && found == false; i++)
+        {
+
+            // Check for jobs
+            if ( thread_pool_has_work(p_thread_pool) || atomic_load_explicit(&p_thread_pool->running, memory_order_relaxed) == false ) found = true;
+
+            // Let the other hyperthread of this core run
+            else PARALLEL_THREAD_POOL_PAUSE();
+        }
+
+        // This worker is done spinning
+        atomic_fetch_sub(&p_thread_pool->spinning_threads, 1);
+
+        // Run the job
+        if ( found ) goto wake;
+    }
+
+    // Lock
+    pthread_mutex_lock(&p_thread_pool->_lock);
+
+    // Announce this worker before checking the queue again
+    atomic_fetch_add(&p_thread_pool->sleeping_threads, 1);
+
+    // A job arrived, or the thread pool is being destroyed
+    if ( thread_pool_has_work(p_thread_pool) || atomic_load(&p_thread_pool->running) == false )
+    {
+
+        // This worker is awake
+        atomic_fetch_sub(&p_thread_pool->sleeping_threads, 1);
+
+        // Unlock
+        pthread_mutex_unlock(&p_thread_pool->_lock);
+
+        // Run the job
+        goto wake;
+    }
+
+    // Push this worker onto the parked stack. Producers wake the newest first,
+    // because its cache is the warmest
+    atomic_store_explicit(&p_thread_pool_thread->unparked, 0, memory_order_relaxed);
+    p_thread_pool_thread->p_next_parked = p_thread_pool->p_parked;
+    p_thread_pool->p_parked             = p_parameter;
+
+    // Unlock
+    pthread_mutex_unlock(&p_thread_pool->_lock);
+
+    // Sleep until a producer unparks this worker
+    if ( p_thread_pool->thread_quantity == p_thread_pool->min_thread_quantity )
+        thread_pool_park(p_parameter, (void *) 0);
+
+    // A worker of an elastic thread pool retires if it sleeps too long
+    else
+    {
+
+        // Initialized data
+        struct timespec _deadline = { 0 };
+
+        // Compute the deadline
+        thread_pool_deadline(&_deadline, p_thread_pool->idle_milliseconds);
+
+        // Sleep until a producer unparks this worker, or the deadline passes
+        while ( thread_pool_park(p_parameter, &_deadline) == 0 )
+        {
+
+            // Lock
+            pthread_mutex_lock(&p_thread_pool->_lock);
+
+            // A producer unparked this worker after the deadline
+            if ( atomic_load_explicit(&p_thread_pool_thread->unparked, memory_order_acquire) )
+            {
+
+                // Unlock
+                pthread_mutex_unlock(&p_thread_pool->_lock);
+
+                // Run the job
+                break;
+            }
+
+            // Keep the minimum quantity of threads
+            if ( atomic_load(&p_thread_pool->live_threads) <= p_thread_pool->min_thread_quantity ) 
+            {
+
+                // Unlock
+                pthread_mutex_unlock(&p_thread_pool->_lock);
+
+                // Start a new deadline
+                thread_pool_deadline(&_deadline, p_thread_pool->idle_milliseconds);
+
+                // Keep sleeping
+                continue;
+            }
+
+            // Remove this worker from the parked stack
+            for (thread_pool_work_parameter **pp_parked = &p_thread_pool->p_parked; *pp_parked; pp_parked = &(*pp_parked)->_thread.p_next_parked)
+            {
+
+                // Not this worker
+                if ( *pp_parked != p_parameter ) continue;
+
+                // Unlink this worker
+                *pp_parked = p_thread_pool_thread->p_next_parked;
+
+                // Done
+                break;
+            }
+
+            // Retire. Another worker joins this thread if it reuses the slot
+            atomic_fetch_sub(&p_thread_pool->sleeping_threads, 1);
+            atomic_fetch_sub(&p_thread_pool->live_threads, 1);
+            p_thread_pool_thread->state = PARALLEL_THREAD_POOL_WORKER_RETIRED;
+
+            // Unlock
+            pthread_mutex_unlock(&p_thread_pool->_lock);
+
+            // Success
+            return (void *) 1;
+        }
+    }
+
+    wake:
+
+    // Wait for the next task
+    if ( atomic_load(&p_thread_pool->running) || thread_pool_has_work(p_thread_pool) ) goto wait_for_next_task;
+
+    // Success
+    return (void *) 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_work_parameter:
+                #ifndef NDEBUG
+                    log_error("[parallel] [thread pool] Null pointer provided for parameter \"p_parameter\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+int thread_pool_queue_construct ( thread_pool_queue *p_queue, size_t capacity )
+{
+
+    // Argument check
+    if ( p_queue == (void *) 0 ) goto no_queue;
+    if ( capacity == 0 || ( capacity & ( capacity - 1 ) ) ) goto capacity_not_power_of_two;
+
+    // Allocate the cells
+    p_queue->p_cells = PARALLEL_REALLOC(0, capacity * sizeof(thread_pool_queue_cell));
+
+    // Error check
+    if ( p_queue->p_cells == (void *) 0 ) goto no_mem;
+
+    // Store the mask
+    p_queue->mask = capacity - 1;
+
+    // Each cell starts out ready for the enqueue with the same position
+    for (size_t i = 0; i < capacity; i++)
+        atomic_init(&p_queue->p_cells[i].sequence, i);
+
+    // Initialize the positions
+    atomic_init(&p_queue->enqueue_position, 0);
+    atomic_init(&p_queue->dequeue_position, 0);
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_queue:
+                #ifndef NDEBUG
+                    log_error("[parallel] [thread pool] Null pointer provided for parameter \"p_queue\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            capacity_not_power_of_two:
+                #ifndef NDEBUG
+                    log_error("[parallel] [thread pool] Parameter \"capacity\" must be a power of two in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+
+        // Standard library errors
+        {
+            no_mem:
+                #ifndef NDEBUG
+                    log_error("[Standard Library] Failed to allocate memory in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+int thread_pool_queue_enqueue ( thread_pool_queue *p_queue, const thread_pool_job *p_job )
+{
+
+    // Initialized data
+    thread_pool_queue_cell *p_cell   = (void *) 0;
+    size_t                  position = atomic_load_explicit(&p_queue->enqueue_position, memory_order_relaxed);
+
+    // Claim a cell
+    for (;;)
+    {
+
+        // Initialized data
+        size_t   sequence   = 0;
+        intptr_t difference = 0;
+
+        // Store the cell
+        p_cell = &p_queue->p_cells[position & p_queue->mask];
+
+        // Load the sequence of the cell
+        sequence = atomic_load_explicit(&p_cell->sequence, memory_order_acquire);
+
+        // Compare the sequence to the position
+        difference = (intptr_t) sequence - (intptr_t) position;
+
+        // The cell is free; try to claim it
+        if ( difference == 0 )
+        {
+            if ( atomic_compare_exchange_weak_explicit(&p_queue->enqueue_position, &position, position + 1, memory_order_relaxed, memory_order_relaxed) ) break;
+        }
+
+        // The cell still holds a job from the previous lap
+        else if ( difference < 0 ) return 0;
+
+        // Another producer claimed the cell
+        else position = atomic_load_explicit(&p_queue->enqueue_position, memory_order_relaxed);
+    }
+
+    // Store the job
+    p_cell->_job = *p_job;
+
+    // Publish the job to consumers
+    atomic_store_explicit(&p_cell->sequence, position + 1, memory_order_release);
+
+    // Success
+    return 1;
+}
+
+int thread_pool_queue_dequeue ( thread_pool_queue *p_queue, thread_pool_job *p_job )
+{
+
+    // Initialized data
+    thread_pool_queue_cell *p_cell   = (void *) 0;
+    size_t                  position = atomic_load_explicit(&p_queue->dequeue_position, memory_order_relaxed);
+
+    // Claim a cell
+    for (;;)
+    {
+
+        // Initialized data
+        size_t   sequence   = 0;
+        intptr_t difference = 0;
+
+        // Store the cell
+        p_cell = &p_queue->p_cells[position & p_queue->mask];
+
+        // Load the sequence of the cell
+        sequence = atomic_load_explicit(&p_cell->sequence, memory_order_acquire);
+
+        // Compare the sequence to the position
+        difference = (intptr_t) sequence - (intptr_t) ( position + 1 );
+
+        // The cell holds a job; try to claim it
+        if ( difference == 0 )
+        {
+            if ( atomic_compare_exchange_weak_explicit(&p_queue->dequeue_position, &position, position + 1, memory_order_relaxed, memory_order_relaxed) ) break;
+        }
+
+        // The queue is empty
+        else if ( difference < 0 ) return 0;
+
+        // Another consumer claimed the cell
+        else position = atomic_load_explicit(&p_queue->dequeue_position, memory_order_relaxed);
+    }
+
+    // Load the job
+    *p_job = p_cell->_job;
+
+    // Hand the cell to the producer on the next lap
+    atomic_store_explicit(&p_cell->sequence, position + p_queue->mask + 1, memory_order_release);
+
+    // Success
+    return 1;
+}
+
+bool thread_pool_queue_empty ( thread_pool_queue *p_queue )
+{
+
+    // Initialized data
+    size_t position = atomic_load(&p_queue->dequeue_position),
+           sequence = atomic_load(&p_queue->p_cells[position & p_queue->mask].sequence);
+
+    // The next cell to dequeue has not been published
+    return (intptr_t) sequence - (intptr_t) ( position + 1 ) < 0;
+}
+
+bool thread_pool_queue_full ( thread_pool_queue *p_queue )
+{
+
+    // Initialized data
+    size_t position = atomic_load(&p_queue->enqueue_position),
+           sequence = atomic_load(&p_queue->p_cells[position & p_queue->mask].sequence);
+
+    // The next cell to enqueue still holds a job from the previous lap
+    return (intptr_t) sequence - (intptr_t) position < 0;
+}
+
+int thread_pool_queue_destroy ( thread_pool_queue *p_queue )
+{
+
+    // Argument check
+    if ( p_queue == (void *) 0 ) goto no_queue;
+
+    // Free the cells
+    PARALLEL_FREE(p_queue->p_cells);
+
+    // Clear the pointer
+    p_queue->p_cells = (void *) 0;
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_queue:
+                #ifndef NDEBUG
+                    log_error("[parallel] [thread pool] Null pointer provided for parameter \"p_queue\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+int thread_pool_deque_construct ( thread_pool_deque *p_deque, size_t capacity )
+{
+
+    // Argument check
+    if ( p_deque == (void *) 0 ) goto no_deque;
+    if ( capacity == 0 || ( capacity & ( capacity - 1 ) ) ) goto capacity_not_power_of_two;
+
+    // Allocate the cells
+    p_deque->p_cells = PARALLEL_REALLOC(0, capacity * sizeof(thread_pool_deque_cell));
+
+    // Error check
+    if ( p_deque->p_cells == (void *) 0 ) goto no_mem;
+
+    // Zero set the cells
+    memset(p_deque->p_cells, 0, capacity * sizeof(thread_pool_deque_cell));
+
+    // Store the mask
+    p_deque->mask = capacity - 1;
+
+    // Initialize the indices
+    atomic_init(&p_deque->top, 0);
+    atomic_init(&p_deque->bottom, 0);
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_deque:
+                #ifndef NDEBUG
+                    log_error("[parallel] [thread pool] Null pointer provided for parameter \"p_deque\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            capacity_not_power_of_two:
+                #ifndef NDEBUG
+                    log_error("[parallel] [thread pool] Parameter \"capacity\" must be a power of two in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+
+        // Standard library errors
+        {
+            no_mem:
+                #ifndef NDEBUG
+                    log_error("[Standard Library] Failed to allocate memory in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+int thread_pool_deque_push ( thread_pool_deque *p_deque, const thread_pool_job *p_job )
+{
+
+    // Initialized data
+    intptr_t                bottom = atomic_load_explicit(&p_deque->bottom, memory_order_relaxed),
+                            top    = atomic_load_explicit(&p_deque->top, memory_order_acquire);
+    thread_pool_deque_cell *p_cell = &p_deque->p_cells[(size_t) bottom & p_deque->mask];
+
+    // Error check
+    if ( bottom - top > (intptr_t) p_deque->mask ) return 0;
+
+    // Store the job
+    atomic_store_explicit(&p_cell->pfn_parallel_task, p_job->pfn_parallel_task, memory_order_relaxed);
+    atomic_store_explicit(&p_cell->p_parameter, p_job->p_parameter, memory_order_relaxed);
+    atomic_store_explicit(&p_cell->submitted, p_job->submitted, memory_order_relaxed);
+
+    // Publish the job to thieves
+    atomic_store_explicit(&p_deque->bottom, bottom + 1, memory_order_release);
+
+    // Success
+    return 1;
+}
+
+int thread_pool_deque_take ( thread_pool_deque *p_deque, thread_pool_job *p_job )
+{
+
+    // Initialized data
+    intptr_t bottom = atomic_load_explicit(&p_deque->bottom, memory_order_relaxed) - 1,
+             top    = 0;
+    int      result = 1;
+
+    // Reserve the bottom job
+    atomic_store_explicit(&p_deque->bottom, bottom, memory_order_relaxed);
+
+    // Order the reservation before reading the top
+    atomic_thread_fence(memory_order_seq_cst);
+
+    // Load the top
+    top = atomic_load_explicit(&p_deque->top, memory_order_relaxed);
+
+    // The deque is empty
+    if ( top > bottom )
+    {
+
+        // Undo the reservation
+        atomic_store_explicit(&p_deque->bottom, bottom + 1, memory_order_relaxed);
+
+        // Done
+        return 0;
+    }
+
+    // Load the job
+    {
+
+        // Initialized data
+        thread_pool_deque_cell *p_cell = &p_deque->p_cells[(size_t) bottom & p_deque->mask];
+
+        // Load the job
+        p_job->pfn_parallel_task = atomic_load_explicit(&p_cell->pfn_parallel_task, memory_order_relaxed);
+        p_job->p_parameter       = atomic_load_explicit(&p_cell->p_parameter, memory_order_relaxed);
+        p_job->submitted         = atomic_load_explicit(&p_cell->submitted, memory_order_relaxed);
+    }
+
+    // More than one job is left; no thief can reach this one
+    if ( top < bottom ) return 1;
+
+    // This is the last job; race the thieves for it
+    if ( atomic_compare_exchange_strong_explicit(&p_deque->top, &top, top + 1, memory_order_seq_cst, memory_order_relaxed) == false ) result = 0;
+
+    // The deque is empty either way
+    atomic_store_explicit(&p_deque->bottom, bottom + 1, memory_order_relaxed);
+
+    // Done
+    return result;
+}
+
+int thread_pool_deque_steal ( thread_pool_deque *p_deque, thread_pool_job *p_job )
+{
+
+    // Initialized data
+    intptr_t top    = atomic_load_explicit(&p_deque->top, memory_order_acquire),
+             bottom = 0;
+
+    // Order the top before the bottom
+    atomic_thread_fence(memory_order_seq_cst);
+
+    // Load the bottom
+    bottom = atomic_load_explicit(&p_deque->bottom, memory_order_acquire);
+
+    // The deque is empty
+    if ( top >= bottom ) return 0;
+
+    // Load the job
+    {
+
+        // Initialized data
+        thread_pool_deque_cell *p_cell = &p_deque->p_cells[(size_t) top & p_deque->mask];
+
+        // Load the job
+        p_job->pfn_parallel_task = atomic_load_explicit(&p_cell->pfn_parallel_task, memory_order_relaxed);
+        p_job->p_parameter       = atomic_load_explicit(&p_cell->p_parameter, memory_order_relaxed);
+        p_job->submitted         = atomic_load_explicit(&p_cell->submitted, memory_order_relaxed);
+    }
+
+    // Claim the job. On failure, the owner or another thief got it first
+    return atomic_compare_exchange_strong_explicit(&p_deque->top, &top, top + 1, memory_order_seq_cst, memory_order_relaxed);
+}
+
+bool thread_pool_deque_empty ( thread_pool_deque *p_deque )
+{
+
+    // Initialized data
+    intptr_t top    = atomic_load(&p_deque->top),
+             bottom = atomic_load(&p_deque->bottom);
+
+    // Done
+    return top >= bottom;
+}
+
+int thread_pool_deque_destroy ( thread_pool_deque *p_deque )
+{
+
+    // Argument check
+    if ( p_deque == (void *) 0 ) goto no_deque;
+
+    // Free the cells
+    PARALLEL_FREE(p_deque->p_cells);
+
+    // Clear the pointer
+    p_deque->p_cells = (void *) 0;
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_deque:
+                #ifndef NDEBUG
+                    log_error("[parallel] [thread pool] Null pointer provided for parameter \"p_deque\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+bool thread_pool_has_work ( thread_pool *p_thread_pool )
+{
+
+    // Check each job queue
+    for (size_t i = 0; i < THREAD_POOL_PRIORITY_QUANTITY; i++)
+        if ( thread_pool_queue_empty(&p_thread_pool->_queues[i]) == false ) return true;
+
+    // Check each deque
+    if ( p_thread_pool->mode == THREAD_POOL_MODE_WORK_STEALING )
+        for (size_t i = 0, n = atomic_load_explicit(&p_thread_pool->started_threads, memory_order_acquire); i < n; i++)
+            if ( thread_pool_deque_empty(&p_thread_pool->_threads[i]._thread._deque) == false ) return true;
+
+    // Done
+    return false;
+}
+
+int thread_pool_next_job ( thread_pool_work_parameter *p_parameter, thread_pool_job *p_job )
+{
+
+    // Initialized data
+    thread_pool        *p_thread_pool        = p_parameter->p_thread_pool;
+    thread_pool_thread *p_thread_pool_thread = &p_parameter->_thread;
+    bool                work_stealing        = ( p_thread_pool->mode == THREAD_POOL_MODE_WORK_STEALING );
+
+    // After a streak of higher priority jobs, run the oldest job of the lowest priority that has one
+    if ( p_thread_pool_thread->priority_streak >= PARALLEL_THREAD_POOL_STARVATION_LIMIT )
+    {
+
+        // Start a new streak
+        p_thread_pool_thread->priority_streak = 0;
+
+        // Lowest priority first
+        for (int i = THREAD_POOL_PRIORITY_QUANTITY - 1; i > THREAD_POOL_PRIORITY_CRITICAL; i--)
+            if ( thread_pool_dequeue_job(p_thread_pool, (enum thread_pool_priority_e) i, p_job) ) return 1;
+    }
+
+    // Count the job toward the streak. A background job ends the streak
+    p_thread_pool_thread->priority_streak++;
+
+    // Run the oldest critical job
+    if ( thread_pool_dequeue_job(p_thread_pool, THREAD_POOL_PRIORITY_CRITICAL, p_job) ) return 1;
+
+    // Run this worker's newest job
+    if ( work_stealing && thread_pool_deque_take(&p_thread_pool_thread->_deque, p_job) ) return 1;
+
+    // Run the oldest normal job
+    if ( thread_pool_dequeue_job(p_thread_pool, THREAD_POOL_PRIORITY_NORMAL, p_job) ) return 1;
+
+    // Steal the oldest job from a random victim
+    if ( work_stealing )
+    {
+
+        // Initialized data
+        size_t self            = (size_t) ( p_parameter - p_thread_pool->_threads ),
+               started_threads = atomic_load_explicit(&p_thread_pool->started_threads, memory_order_acquire),
+               first           = 0;
+
+        // Advance the victim generator (xorshift64)
+        p_thread_pool_thread->victim_seed ^= p_thread_pool_thread->victim_seed << 13;
+        p_thread_pool_thread->victim_seed ^= p_thread_pool_thread->victim_seed >> 7;
+        p_thread_pool_thread->victim_seed ^= p_thread_pool_thread->victim_seed << 17;
+
+        // Pick the first victim
+        first = (size_t) ( p_thread_pool_thread->victim_seed % started_threads );
+
+        // Try every other worker, starting with the first victim
+        for (size_t i = 0; i < started_threads; i++)
+        {
+
+            // Initialized data
+            size_t victim = ( first + i ) % started_threads;
+
+            // Don't steal from yourself
+            if ( victim == self ) continue;
+
+            // Steal
+            if ( thread_pool_deque_steal(&p_thread_pool->_threads[victim]._thread._deque, p_job) )
+            {
+
+                // Count the steal
+                PARALLEL_THREAD_POOL_STAT_ADD(p_thread_pool_thread->steals, 1);
+
+                // Success
+                return 1;
+            }
+        }
+    }
+
+    // Run the oldest background job
+    if ( thread_pool_dequeue_job(p_thread_pool, THREAD_POOL_PRIORITY_BACKGROUND, p_job) )
+    {
+
+        // Start a new streak
+        p_thread_pool_thread->priority_streak = 0;
+
+        // Success
+        return 1;
+    }
+
+    // Nothing to run, so this wasn't a streak
+    p_thread_pool_thread->priority_streak--;
+
+    // Done
+    return 0;
+}
+
+void thread_pool_finish_job ( thread_pool *p_thread_pool )
+{
+
+    // Not the last job
+    if ( atomic_fetch_sub(&p_thread_pool->outstanding_jobs, 1) != 1 ) return;
+
+    // Wake the idle waiters, if there are any
+    if ( atomic_load(&p_thread_pool->idle_waiters) )
+    {
+
+        // Lock
+        pthread_mutex_lock(&p_thread_pool->_lock);
+
+        // Signal every waiter
+        pthread_cond_broadcast(&p_thread_pool->_idle);
+
+        // Unlock
+        pthread_mutex_unlock(&p_thread_pool->_lock);
+    }
+
+    // Done
+    return;
+}
+
+int thread_pool_futures_construct ( thread_pool *p_thread_pool, size_t future_quantity )
+{
+
+    // Argument check
+    if ( future_quantity > UINT32_MAX - 1 ) goto too_many_futures;
+
+    // Allocate the futures
+    p_thread_pool->p_futures = PARALLEL_REALLOC(0, future_quantity * sizeof(thread_pool_future));
+
+    // Error check
+    if ( p_thread_pool->p_futures == (void *) 0 ) goto no_mem;
+
+    // Zero set the futures
+    memset(p_thread_pool->p_futures, 0, future_quantity * sizeof(thread_pool_future));
+
+    // Store the quantity of futures
+    p_thread_pool->future_quantity = future_quantity;
+
+    // Timed waits on a future measure time on the monotonic clock
+    {
+
+        // Initialized data
+        pthread_condattr_t _attributes;
+
+        // Use the monotonic clock
+        pthread_condattr_init(&_attributes);
+        pthread_condattr_setclock(&_attributes, CLOCK_MONOTONIC);
+
+        // Construct each future, and link it to the next one
+        for (size_t i = 0; i < future_quantity; i++)
+        {
+
+            // Initialized data
+            thread_pool_future *p_future = &p_thread_pool->p_futures[i];
+
+            // Store the thread pool
+            p_future->p_thread_pool = p_thread_pool;
+
+            // Link the future. Links are index + 1, so 0 ends the list
+            atomic_init(&p_future->next, ( i + 1 < future_quantity ) ? (unsigned) ( i + 2 ) : 0);
+
+            // Construct the lock and the condition variable
+            pthread_mutex_init(&p_future->_lock, NULL);
+            pthread_cond_init(&p_future->_done, &_attributes);
+        }
+
+        // Clean up
+        pthread_condattr_destroy(&_attributes);
+    }
+
+    // The head of the free list is the first future, with a tag of 0
+    atomic_init(&p_thread_pool->free_futures, future_quantity ? 1 : 0);
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            too_many_futures:
+                #ifndef NDEBUG
+                    log_error("[parallel] [thread pool] Parameter \"future_quantity\" is too large in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+
+        // Standard library errors
+        {
+            no_mem:
+                #ifndef NDEBUG
+                    log_error("[Standard Library] Failed to allocate memory in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+thread_pool_future *thread_pool_future_acquire ( thread_pool *p_thread_pool )
+{
+
+    // Initialized data
+    uint64_t head = atomic_load_explicit(&p_thread_pool->free_futures, memory_order_acquire),
+             next = 0;
+
+    // The head is a 32 bit tag above a 32 bit link. Bumping the tag on every
+    // change means a stale head never compares equal, so the stack is ABA safe
+    do
+    {
+
+        // Initialized data
+        uint32_t link = (uint32_t) head;
+
+        // Every future is in use
+        if ( link == 0 ) return (void *) 0;
+
+        // Compute the new head
+        next = ( ( ( head >> 32 ) + 1 ) << 32 ) | atomic_load_explicit(&p_thread_pool->p_futures[link - 1].next, memory_order_relaxed);
+
+    } while ( atomic_compare_exchange_weak_explicit(&p_thread_pool->free_futures, &head, next, memory_order_acquire, memory_order_acquire) == false );
+
+    // Done
+    return &p_thread_pool->p_futures[(uint32_t) head - 1];
+}
+
+void thread_pool_future_recycle ( thread_pool_future *p_future )
+{
+
+    // Initialized data
+    thread_pool *p_thread_pool = p_future->p_thread_pool;
+    uint32_t     link          = (uint32_t) ( p_future - p_thread_pool->p_futures ) + 1;
+    uint64_t     head          = atomic_load_explicit(&p_thread_pool->free_futures, memory_order_relaxed),
+                 next          = 0;
+
+    // Push the future onto the free list
+    do
+    {
+
+        // Link the future to the current head
+        atomic_store_explicit(&p_future->next, (uint32_t) head, memory_order_relaxed);
+
+        // Compute the new head
+        next = ( ( ( head >> 32 ) + 1 ) << 32 ) | link;
+
+    } while ( atomic_compare_exchange_weak_explicit(&p_thread_pool->free_futures, &head, next, memory_order_release, memory_order_relaxed) == false );
+
+    // Done
+    return;
+}
+
+int thread_pool_descriptors_construct ( thread_pool *p_thread_pool, size_t descriptor_quantity )
+{
+
+    // Argument check
+    if ( descriptor_quantity > UINT32_MAX - 1 ) goto too_many_descriptors;
+
+    // Allocate the descriptors, with room to align them to a cache line
+    p_thread_pool->p_descriptor_memory = PARALLEL_REALLOC(0, descriptor_quantity * sizeof(thread_pool_descriptor) + PARALLEL_CACHE_LINE_SIZE - 1);
+
+    // Error check
+    if ( p_thread_pool->p_descriptor_memory == (void *) 0 ) goto no_mem;
+
+    // Align the descriptors to a cache line
+    p_thread_pool->p_descriptors = (thread_pool_descriptor *) ( ( (uintptr_t) p_thread_pool->p_descriptor_memory + PARALLEL_CACHE_LINE_SIZE - 1 ) & ~( (uintptr_t) PARALLEL_CACHE_LINE_SIZE - 1 ) );
+
+    // Zero set the descriptors
+    memset(p_thread_pool->p_descriptors, 0, descriptor_quantity * sizeof(thread_pool_descriptor));
+
+    // Store the quantity of descriptors
+    p_thread_pool->descriptor_quantity = descriptor_quantity;
+
+    // Link each descriptor to the next one. Links are index + 1, so 0 ends the list
+    for (size_t i = 0; i < descriptor_quantity; i++)
+    {
+
+        // Store the thread pool
+        p_thread_pool->p_descriptors[i].p_thread_pool = p_thread_pool;
+
+        // Link the descriptor
+        atomic_init(&p_thread_pool->p_descriptors[i].next, ( i + 1 < descriptor_quantity ) ? (unsigned) ( i + 2 ) : 0);
+    }
+
+    // The head of the free list is the first descriptor, with a tag of 0
+    atomic_init(&p_thread_pool->free_descriptors, descriptor_quantity ? 1 : 0);
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            too_many_descriptors:
+                #ifndef NDEBUG
+                    log_error("[parallel] [thread pool] Parameter \"descriptor_quantity\" is too large in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+
+        // Standard library errors
+        {
+            no_mem:
+                #ifndef NDEBUG
+                    log_error("[Standard Library] Failed to allocate memory in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+thread_pool_descriptor *thread_pool_descriptor_acquire ( thread_pool *p_thread_pool )
+{
+
+    // Initialized data
+    uint64_t head = atomic_load_explicit(&p_thread_pool->free_descriptors, memory_order_acquire),
+             next = 0;
+
+    // Pop the head of the tagged free list, like thread_pool_future_acquire
+    do
+    {
+
+        // Initialized data
+        uint32_t link = (uint32_t) head;
+
+        // Every descriptor is in use
+        if ( link == 0 ) return (void *) 0;
+
+        // Compute the new head
+        next = ( ( ( head >> 32 ) + 1 ) << 32 ) | atomic_load_explicit(&p_thread_pool->p_descriptors[link - 1].next, memory_order_relaxed);
+
+    } while ( atomic_compare_exchange_weak_explicit(&p_thread_pool->free_descriptors, &head, next, memory_order_acquire, memory_order_acquire) == false );
+
+    // Done
+    return &p_thread_pool->p_descriptors[(uint32_t) head - 1];
+}
+
+void thread_pool_descriptor_recycle ( thread_pool_descriptor *p_descriptor )
+{
+
+    // Initialized data
+    thread_pool *p_thread_pool = p_descriptor->p_thread_pool;
+    uint32_t     link          = (uint32_t) ( p_descriptor - p_thread_pool->p_descriptors ) + 1;
+    uint64_t     head          = atomic_load_explicit(&p_thread_pool->free_descriptors, memory_order_relaxed),
+                 next          = 0;
+
+    // Push the descriptor onto the free list
+    do
+    {
+
+        // Link the descriptor to the current head
+        atomic_store_explicit(&p_descriptor->next, (uint32_t) head, memory_order_relaxed);
+
+        // Compute the new head
+        next = ( ( ( head >> 32 ) + 1 ) << 32 ) | link;
+
+    } while ( atomic_compare_exchange_weak_explicit(&p_thread_pool->free_descriptors, &head, next, memory_order_release, memory_order_relaxed) == false );
+
+    // Order the push before the producer check
+    atomic_thread_fence(memory_order_seq_cst);
+
+    // Wake a producer that is waiting for a descriptor
+    if ( atomic_load_explicit(&p_thread_pool->waiting_producers, memory_order_relaxed) )
+    {
+
+        // Lock
+        pthread_mutex_lock(&p_thread_pool->_lock);
+
+        // Signal every producer. Some may be waiting for a queue slot instead
+        pthread_cond_broadcast(&p_thread_pool->_slot_available);
+
+        // Unlock
+        pthread_mutex_unlock(&p_thread_pool->_lock);
+    }
+
+    // Done
+    return;
+}
+
+void *thread_pool_descriptor_run ( thread_pool_descriptor *p_descriptor )
+{
+
+    // Initialized data
+    void *ret = p_descriptor->pfn_parallel_task(p_descriptor->p_parameter);
+
+    // Release the parameter
+    if ( p_descriptor->pfn_destructor ) p_descriptor->pfn_destructor(p_descriptor->p_parameter);
+
+    // Return the descriptor
+    thread_pool_descriptor_recycle(p_descriptor);
+
+    // Done
+    return ret;
+}
+
+void *thread_pool_future_run ( thread_pool_future *p_future )
+{
+
+    // Initialized data
+    void *ret = p_future->pfn_parallel_task(p_future->p_parameter);
+
+    // Complete the future
+    thread_pool_future_complete(p_future, ret);
+
+    // Done
+    return ret;
+}
+
+void thread_pool_future_complete ( thread_pool_future *p_future, void *ret )
+{
+
+    // Initialized data
+    thread_pool_future *p_continuation = (void *) 0;
+    unsigned            state          = 0;
+
+    // Store the result
+    p_future->ret = ret;
+
+    // Take the continuation. A continuation that is chained after this point 
+    // finds the future pointing to itself, and starts right away
+    p_continuation = atomic_exchange_explicit(&p_future->p_continuation, p_future, memory_order_acq_rel);
+
+    // Publish the result
+    state = atomic_fetch_or_explicit(&p_future->state, PARALLEL_THREAD_POOL_FUTURE_DONE, memory_order_acq_rel);
+
+    // Start the continuation. It sees this future as done, and doesn't touch it,
+    // so the caller may recycle it from here on
+    if ( p_continuation ) thread_pool_future_arrive(p_continuation, ret);
+
+    // Nobody wants the result; recycle the future
+    if ( state & PARALLEL_THREAD_POOL_FUTURE_DETACHED ) thread_pool_future_recycle(p_future);
+
+    // Wake the waiter
+    else if ( state & PARALLEL_THREAD_POOL_FUTURE_WAITER )
+    {
+
+        // Lock
+        pthread_mutex_lock(&p_future->_lock);
+
+        // Signal the waiter
+        pthread_cond_broadcast(&p_future->_done);
+
+        // Unlock
+        pthread_mutex_unlock(&p_future->_lock);
+    }
+
+    // Done
+    return;
+}
+
+int thread_pool_future_chain ( thread_pool_future *p_future, thread_pool_future *p_continuation )
+{
+
+    // Initialized data
+    thread_pool_future *p_expected = (void *) 0;
+
+    // The future already has a continuation
+    if ( atomic_fetch_or(&p_future->state, PARALLEL_THREAD_POOL_FUTURE_CHAINED) & PARALLEL_THREAD_POOL_FUTURE_CHAINED ) return 0;
+
+    // Chain the continuation
+    if ( atomic_compare_exchange_strong_explicit(&p_future->p_continuation, &p_expected, p_continuation, memory_order_acq_rel, memory_order_acquire) ) return 1;
+
+    // The future is done; its result is ready
+    thread_pool_future_arrive(p_continuation, p_future->ret);
+
+    // Success
+    return 1;
+}
+
+void thread_pool_future_arrive ( thread_pool_future *p_continuation, void *ret )
+{
+
+    // A continuation with a task gets its antecedent's result
+    if ( p_continuation->pfn_parallel_task ) p_continuation->p_parameter = ret;
+
+    // Not the last antecedent
+    if ( atomic_fetch_sub_explicit(&p_continuation->pending, 1, memory_order_acq_rel) != 1 ) return;
+
+    // Run the continuation's task. From a work stealing worker, it goes onto 
+    // that worker's own deque, and runs next, while the data is still in cache
+    if ( p_continuation->pfn_parallel_task )
+        thread_pool_post(p_continuation->p_thread_pool, (fn_parallel_task *) thread_pool_future_run, p_continuation);
+
+    // A continuation without a task is done
+    else
+        thread_pool_future_complete(p_continuation, p_continuation->p_parameter);
+
+    // Done
+    return;
+}
+
+int thread_pool_future_wait_until ( thread_pool_future *p_future, const struct timespec *p_deadline, void **pp_result )
+{
+
+    // Initialized data
+    thread_pool           *p_thread_pool = p_future->p_thread_pool;
+    bool                   worker        = thread_pool_on_worker(p_thread_pool);
+    struct timespec        _nap          = { 0 };
+    const struct timespec *p_wake        = p_deadline;
+    unsigned               state         = atomic_load_explicit(&p_future->state, memory_order_acquire);
+    int                    done          = 1;
+
+    // Fast path
+    if ( state & PARALLEL_THREAD_POOL_FUTURE_DONE ) goto done;
+
+    // Lock
+    pthread_mutex_lock(&p_future->_lock);
+
+    // Until the future is done
+    while ( ( ( state = atomic_load_explicit(&p_future->state, memory_order_acquire) ) & PARALLEL_THREAD_POOL_FUTURE_DONE ) == 0 )
+    {
+
+        // Announce the waiter. If the state changed, look again
+        if ( ( state & PARALLEL_THREAD_POOL_FUTURE_WAITER ) == 0 )
+            if ( atomic_compare_exchange_strong(&p_future->state, &state, state | PARALLEL_THREAD_POOL_FUTURE_WAITER) == false ) continue;
+
+        // A worker runs queued jobs instead of sleeping, so a job that waits on
+        // another job never holds up the thread pool
+        if ( worker )
+        {
+
+            // Initialized data
+            int ran = 0;
+
+            // Run a job without holding the lock
+            pthread_mutex_unlock(&p_future->_lock);
+            ran = thread_pool_help(p_thread_pool);
+            pthread_mutex_lock(&p_future->_lock);
+
+            // Look again
+            if ( ran ) continue;
+
+            // Nothing to run. Nap, then look for jobs again ...
+            thread_pool_deadline(&_nap, PARALLEL_THREAD_POOL_HELP_MILLISECONDS);
+
+            // ... unless the caller's deadline comes first
+            p_wake = ( p_deadline && ( p_deadline->tv_sec < _nap.tv_sec || ( p_deadline->tv_sec == _nap.tv_sec && p_deadline->tv_nsec < _nap.tv_nsec ) ) ) ? p_deadline : &_nap;
+        }
+
+        // Wait forever
+        if ( p_wake == (void *) 0 ) pthread_cond_wait(&p_future->_done, &p_future->_lock);
+
+        // Wait until the deadline
+        else if ( pthread_cond_timedwait(&p_future->_done, &p_future->_lock, p_wake) == ETIMEDOUT && p_wake == p_deadline )
+        {
+
+            // One last look
+            done = ( atomic_load_explicit(&p_future->state, memory_order_acquire) & PARALLEL_THREAD_POOL_FUTURE_DONE ) != 0;
+
+            // Done
+            break;
+        }
+    }
+
+    // Unlock
+    pthread_mutex_unlock(&p_future->_lock);
+
+    // Timed out
+    if ( done == 0 ) return 0;
+
+    done:
+
+    // Return the result to the caller
+    if ( pp_result ) *pp_result = p_future->ret;
+
+    // Success
+    return 1;
+}
+
+void *thread_pool_group_run ( thread_pool_group *p_group )
+{
+
+    // Run one of the group's jobs. A waiter may have run it already
+    thread_pool_group_help(p_group);
+
+    // Drop the reference this run held
+    thread_pool_group_release(p_group);
+
+    // Done
+    return (void *) 0;
+}
+
+int thread_pool_group_help ( thread_pool_group *p_group )
+{
+
+    // Initialized data
+    thread_pool_job _job = { 0 };
+
+    // Nothing to run
+    if ( thread_pool_queue_dequeue(&p_group->_queue, &_job) == 0 ) return 0;
+
+    // Order the dequeue before the producer check
+    atomic_thread_fence(memory_order_seq_cst);
+
+    // Wake a producer that is waiting on the group's full queue
+    if ( atomic_load_explicit(&p_group->waiting_producers, memory_order_relaxed) )
+    {
+
+        // Lock
+        pthread_mutex_lock(&p_group->_lock);
+
+        // Signal every producer
+        pthread_cond_broadcast(&p_group->_done);
+
+        // Unlock
+        pthread_mutex_unlock(&p_group->_lock);
+    }
+
+    // Run the job
+    _job.pfn_parallel_task(_job.p_parameter);
+
+    // Count the job as done
+    thread_pool_group_finish_job(p_group);
+
+    // Success
+    return 1;
+}
+
+void thread_pool_group_finish_job ( thread_pool_group *p_group )
+{
+
+    // Not the last job of the group
+    if ( atomic_fetch_sub(&p_group->outstanding_jobs, 1) != 1 ) return;
+
+    // Nobody is waiting
+    if ( atomic_load(&p_group->waiters) == 0 ) return;
+
+    // Lock
+    pthread_mutex_lock(&p_group->_lock);
+
+    // Signal every waiter
+    pthread_cond_broadcast(&p_group->_done);
+
+    // Unlock
+    pthread_mutex_unlock(&p_group->_lock);
+
+    // Done
+    return;
+}
+
+void thread_pool_group_release ( thread_pool_group *p_group )
+{
+
+    // Not the last reference
+    if ( atomic_fetch_sub(&p_group->references, 1) != 1 ) return;
+
+    // Clean up
+    pthread_cond_destroy(&p_group->_done);
+    pthread_mutex_destroy(&p_group->_lock);
+    thread_pool_queue_destroy(&p_group->_queue);
+
+    // Free the task group
+    PARALLEL_FREE(p_group);
+
+    // Done
+    return;
+}
+
+thread_pool_timer_wheel *thread_pool_timer_wheel_get ( thread_pool *p_thread_pool )
+{
+
+    // Initialized data
+    thread_pool_timer_wheel *p_wheel = atomic_load_explicit(&p_thread_pool->p_timer_wheel, memory_order_acquire);
+    struct timespec          _now    = { 0 };
+
+    // Fast path; the timer thread is running
+    if ( p_wheel ) return p_wheel;
+
+    // Lock
+    pthread_mutex_lock(&p_thread_pool->_lock);
+
+    // Look again; another thread may have started it
+    p_wheel = atomic_load_explicit(&p_thread_pool->p_timer_wheel, memory_order_relaxed);
+
+    // Done
+    if ( p_wheel ) goto done;
+
+    // Allocate memory for the timer wheel
+    p_wheel = PARALLEL_REALLOC(0, sizeof(thread_pool_timer_wheel));
+
+    // Error check
+    if ( p_wheel == (void *) 0 ) goto no_mem;
+
+    // Zero set the timer wheel
+    memset(p_wheel, 0, sizeof(thread_pool_timer_wheel));
+
+    // Tick 0 is now
+    clock_gettime(CLOCK_MONOTONIC, &_now);
+
+    // Populate the timer wheel
+    p_wheel->p_thread_pool = p_thread_pool;
+    p_wheel->running       = true;
+    p_wheel->start         = (uint64_t) _now.tv_sec * 1000000000ULL + (uint64_t) _now.tv_nsec;
+    p_wheel->wake_tick     = UINT64_MAX;
+
+    // The timer thread sleeps on the monotonic clock
+    {
+
+        // Initialized data
+        pthread_condattr_t _attributes;
+
+        // Initialize the lock
+        pthread_mutex_init(&p_wheel->_lock, NULL);
+
+        // Initialize the condition
+        pthread_condattr_init(&_attributes);
+        pthread_condattr_setclock(&_attributes, CLOCK_MONOTONIC);
+        pthread_cond_init(&p_wheel->_changed, &_attributes);
+        pthread_condattr_destroy(&_attributes);
+    }
+
+    // Start the timer thread
+    if ( parallel_thread_start(&p_wheel->p_parallel_thread, (fn_parallel_task *) thread_pool_timer_work, p_wheel) == 0 ) goto failed_to_start_thread;
+
+    // Publish the timer wheel
+    atomic_store_explicit(&p_thread_pool->p_timer_wheel, p_wheel, memory_order_release);
+
+    done:
+
+    // Unlock
+    pthread_mutex_unlock(&p_thread_pool->_lock);
+
+    // Success
+    return p_wheel;
+
+    // Error handling
+    {
+
+        // Parallel errors
+        {
+            failed_to_start_thread:
+
+                // Clean up
+                pthread_cond_destroy(&p_wheel->_changed);
+                pthread_mutex_destroy(&p_wheel->_lock);
+                PARALLEL_FREE(p_wheel);
+
+                // Unlock
+                pthread_mutex_unlock(&p_thread_pool->_lock);
+
+                #ifndef NDEBUG
+                    log_error("[parallel] [thread pool] Failed to start timer thread in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return (void *) 0;
+        }
+
+        // Standard library errors
+        {
+            no_mem:
+
+                // Unlock
+                pthread_mutex_unlock(&p_thread_pool->_lock);
+
+                #ifndef NDEBUG
+                    log_error("[Standard Library] Failed to allocate memory in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return (void *) 0;
+        }
+    }
+}
+
+void thread_pool_timer_wheel_destroy ( thread_pool_timer_wheel *p_wheel )
+{
+
+    // Lock
+    pthread_mutex_lock(&p_wheel->_lock);
+
+    // Stop the timer thread
+    p_wheel->running = false;
+    pthread_cond_signal(&p_wheel->_changed);
+
+    // Unlock
+    pthread_mutex_unlock(&p_wheel->_lock);
+
+    // Wait for the timer thread to exit
+    parallel_thread_join(&p_wheel->p_parallel_thread);
+
+    // Drop the wheel's reference to every timer that is still in the wheel
+    for (size_t level = 0; level < PARALLEL_THREAD_POOL_TIMER_LEVELS; level++)
+        for (size_t slot = 0; slot < PARALLEL_THREAD_POOL_TIMER_SLOTS; slot++)
+            for (thread_pool_timer *p_timer = p_wheel->p_slots[level][slot], *p_next = (void *) 0; p_timer; p_timer = p_next)
+                p_next = p_timer->p_next, thread_pool_timer_release(p_timer);
+
+    // Mark each timer with a handle dead. Cancelling it frees it
+    for (thread_pool_timer *p_timer = p_wheel->p_handles; p_timer; p_timer = p_timer->p_handle_next)
+        p_timer->p_wheel = (void *) 0;
+
+    // Clean up
+    pthread_cond_destroy(&p_wheel->_changed);
+    pthread_mutex_destroy(&p_wheel->_lock);
+
+    // Free the timer wheel
+    PARALLEL_FREE(p_wheel);
+
+    // Done
+    return;
+}
+
+uint64_t thread_pool_timer_wheel_now ( thread_pool_timer_wheel *p_wheel )
+{
+
+    // Initialized data
+    struct timespec _now = { 0 };
+
+    // Read the clock
+    clock_gettime(CLOCK_MONOTONIC, &_now);
+
+    // Done
+    return ( (uint64_t) _now.tv_sec * 1000000000ULL + (uint64_t) _now.tv_nsec - p_wheel->start ) / PARALLEL_THREAD_POOL_TIMER_TICK;
+}
+
+uint64_t thread_pool_timer_wheel_next ( thread_pool_timer_wheel *p_wheel )
+{
+
+    // Initialized data
+    uint64_t tick  = p_wheel->tick,
+             index = tick & ( PARALLEL_THREAD_POOL_TIMER_SLOTS - 1 ),
+             later = p_wheel->occupied[0] & ~( ( 2ULL << index ) - 1 );
+
+    // The next slot with a timer, in this lap of the lowest level ...
+    if ( later ) return ( tick - index ) + (uint64_t) __builtin_ctzll(later);
+
+    // ... or the start of the next lap
+    return ( tick | ( PARALLEL_THREAD_POOL_TIMER_SLOTS - 1 ) ) + 1;
+}
+
+void thread_pool_timer_wheel_advance ( thread_pool_timer_wheel *p_wheel )
+{
+
+    // Initialized data
+    uint64_t           tick    = ++p_wheel->tick;
+    thread_pool_timer *p_timer = (void *) 0;
+
+    // At the start of each lap of a level, the timers in the next slot of the level above move down
+    for (size_t level = 1; level < PARALLEL_THREAD_POOL_TIMER_LEVELS && ( tick & ( ( 1ULL << ( level * PARALLEL_THREAD_POOL_TIMER_SLOT_BITS ) ) - 1 ) ) == 0; level++)
+    {
+
+        // Initialized data
+        size_t slot = ( tick >> ( level * PARALLEL_THREAD_POOL_TIMER_SLOT_BITS ) ) & ( PARALLEL_THREAD_POOL_TIMER_SLOTS - 1 );
+
+        // Put each timer back, a level or more lower
+        while ( ( p_timer = p_wheel->p_slots[level][slot] ) )
+        {
+            thread_pool_timer_remove(p_wheel, p_timer);
+            thread_pool_timer_insert(p_wheel, p_timer);
+        }
+    }
+
+    // Queue the job of each timer in this tick's slot
+    while ( ( p_timer = p_wheel->p_slots[0][tick & ( PARALLEL_THREAD_POOL_TIMER_SLOTS - 1 )] ) )
+    {
+
+        // Initialized data
+        fn_parallel_task *pfn_parallel_task = p_timer->pfn_parallel_task;
+        void             *p_parameter       = p_timer->p_parameter;
+
+        // Take the timer out of the wheel
+        thread_pool_timer_remove(p_wheel, p_timer);
+
+        // A periodic timer goes back in at its next expiry. Expiries stay on 
+        // multiples of the period, so they don't drift, and missed ones are skipped
+        if ( p_timer->period )
+        {
+            p_timer->expiry += ( ( tick - p_timer->expiry ) / p_timer->period + 1 ) * p_timer->period;
+            thread_pool_timer_insert(p_wheel, p_timer);
+        }
+
+        // A one shot timer is done
+        else
+            thread_pool_timer_release(p_timer);
+
+        // Queue the job without the lock, so a full queue doesn't hold up cancels
+        pthread_mutex_unlock(&p_wheel->_lock);
+        thread_pool_post(p_wheel->p_thread_pool, pfn_parallel_task, p_parameter);
+        pthread_mutex_lock(&p_wheel->_lock);
+    }
+
+    // Done
+    return;
+}
+
+void thread_pool_timer_insert ( thread_pool_timer_wheel *p_wheel, thread_pool_timer *p_timer )
+{
+
+    // Initialized data
+    uint64_t expiry = p_timer->expiry,
+             delta  = 0;
+    size_t   level  = 0,
+             slot   = 0;
+
+    // A timer that is already due runs on the next tick
+    if ( expiry <= p_wheel->tick ) expiry = p_timer->expiry = p_wheel->tick + 1;
+
+    // Compute the distance to the expiry
+    delta = expiry - p_wheel->tick;
+
+    // Each level is as many times coarser than the one below it as it has slots
+    while ( level < PARALLEL_THREAD_POOL_TIMER_LEVELS - 1 && delta >= 1ULL << ( ( level + 1 ) * PARALLEL_THREAD_POOL_TIMER_SLOT_BITS ) ) level++;
+
+    // A timer past the end of the highest level waits in its farthest slot, and goes around again
+    if ( delta >= 1ULL << ( PARALLEL_THREAD_POOL_TIMER_LEVELS * PARALLEL_THREAD_POOL_TIMER_SLOT_BITS ) )
+        expiry = p_wheel->tick + ( 1ULL << ( PARALLEL_THREAD_POOL_TIMER_LEVELS * PARALLEL_THREAD_POOL_TIMER_SLOT_BITS ) ) - 1;
+
+    // Compute the slot
+    slot = ( expiry >> ( level * PARALLEL_THREAD_POOL_TIMER_SLOT_BITS ) ) & ( PARALLEL_THREAD_POOL_TIMER_SLOTS - 1 );
+
+    // Push the timer onto the slot's list
+    p_timer->p_previous = (void *) 0;
+    p_timer->p_next     = p_wheel->p_slots[level][slot];
+    if ( p_timer->p_next ) p_timer->p_next->p_previous = p_timer;
+    p_wheel->p_slots[level][slot] = p_timer;
+
+    // Store the timer's place
+    p_timer->level = (int) level;
+    p_timer->slot  = (int) slot;
+
+    // Mark the slot, and count the timer
+    p_wheel->occupied[level] |= 1ULL << slot;
+    p_wheel->timer_quantity++;
+
+    // Wake the timer thread, if it would sleep past this timer
+    if ( p_timer->expiry < p_wheel->wake_tick ) pthread_cond_signal(&p_wheel->_changed);
+
+    // Done
+    return;
+}
+
+void thread_pool_timer_remove ( thread_pool_timer_wheel *p_wheel, thread_pool_timer *p_timer )
+{
+
+    // Initialized data
+    thread_pool_timer **pp_head = &p_wheel->p_slots[p_timer->level][p_timer->slot];
+
+    // Unlink the timer
+    if ( p_timer->p_next ) p_timer->p_next->p_previous = p_timer->p_previous;
+    if ( p_timer->p_previous ) p_timer->p_previous->p_next = p_timer->p_next;
+    else *pp_head = p_timer->p_next;
+
+    // Clear the slot's mark if it is empty
+    if ( *pp_head == (void *) 0 ) p_wheel->occupied[p_timer->level] &= ~( 1ULL << p_timer->slot );
+
+    // The timer is out of the wheel
+    p_timer->level = -1;
+    p_timer->slot  = -1;
+    p_timer->p_next = p_timer->p_previous = (void *) 0;
+    p_wheel->timer_quantity--;
+
+    // Done
+    return;
+}
+
+void thread_pool_timer_release ( thread_pool_timer *p_timer )
+{
+
+    // Free the timer after the last reference
+    if ( --p_timer->references == 0 ) PARALLEL_FREE(p_timer);
+
+    // Done
+    return;
+}
+
+int thread_pool_timer_start ( thread_pool *p_thread_pool, size_t milliseconds, size_t period, fn_parallel_task *pfn_parallel_task, void *p_parameter, thread_pool_timer **pp_timer )
+{
+
+    // Initialized data
+    thread_pool_timer_wheel *p_wheel = thread_pool_timer_wheel_get(p_thread_pool);
+    thread_pool_timer       *p_timer = (void *) 0;
+    struct timespec          _now    = { 0 };
+    uint64_t                 now     = 0;
+
+    // Error check
+    if ( p_wheel == (void *) 0 ) goto no_timer_wheel;
+
+    // Allocate memory for the timer
+    p_timer = PARALLEL_REALLOC(0, sizeof(thread_pool_timer));
+
+    // Error check
+    if ( p_timer == (void *) 0 ) goto no_mem;
+
+    // Read the clock
+    clock_gettime(CLOCK_MONOTONIC, &_now);
+    now = (uint64_t) _now.tv_sec * 1000000000ULL + (uint64_t) _now.tv_nsec;
+
+    // Populate the timer. The expiry rounds up to a whole tick, so a job never runs early
+    *p_timer = (thread_pool_timer)
+    {
+        .p_wheel           = p_wheel,
+        .pfn_parallel_task = pfn_parallel_task,
+        .p_parameter       = p_parameter,
+        .expiry            = ( now - p_wheel->start + (uint64_t) milliseconds * 1000000ULL + PARALLEL_THREAD_POOL_TIMER_TICK - 1 ) / PARALLEL_THREAD_POOL_TIMER_TICK,
+        .period            = (uint64_t) period * 1000000ULL / PARALLEL_THREAD_POOL_TIMER_TICK,
+        .references        = ( pp_timer ) ? 2 : 1,
+        .level             = -1,
+        .slot              = -1
+    };
+
+    // Return a pointer to the caller, before the timer can fire
+    if ( pp_timer ) *pp_timer = p_timer;
+
+    // Lock
+    pthread_mutex_lock(&p_wheel->_lock);
+
+    // Put the timer on the list of timers with a handle
+    if ( pp_timer )
+    {
+        p_timer->p_handle_next = p_wheel->p_handles;
+        if ( p_timer->p_handle_next ) p_timer->p_handle_next->p_handle_previous = p_timer;
+        p_wheel->p_handles = p_timer;
+    }
+
+    // Put the timer in the wheel
+    thread_pool_timer_insert(p_wheel, p_timer);
+
+    // Unlock
+    pthread_mutex_unlock(&p_wheel->_lock);
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Parallel errors
+        {
+            no_timer_wheel:
+                #ifndef NDEBUG
+                    log_error("[parallel] [thread pool] Failed to start timer thread in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+
+        // Standard library errors
+        {
+            no_mem:
+                #ifndef NDEBUG
+                    log_error("[Standard Library] Failed to allocate memory in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+void *thread_pool_timer_work ( thread_pool_timer_wheel *p_wheel )
+{
+
+    // Initialized data
+    struct timespec _deadline = { 0 };
+
+    // Lock
+    pthread_mutex_lock(&p_wheel->_lock);
+
+    // Until the thread pool is destroyed
+    while ( p_wheel->running )
+    {
+
+        // Initialized data
+        uint64_t now  = thread_pool_timer_wheel_now(p_wheel),
+                 next = 0;
+
+        // An empty wheel skips ahead
+        if ( p_wheel->timer_quantity == 0 && p_wheel->tick < now ) p_wheel->tick = now;
+
+        // Run each tick that has work, up to now
+        while ( p_wheel->running && p_wheel->tick < now )
+        {
+
+            // Skip the ticks with nothing to do
+            next = thread_pool_timer_wheel_next(p_wheel);
+            p_wheel->tick = ( ( next < now ) ? next : now ) - 1;
+
+            // Run the tick
+            thread_pool_timer_wheel_advance(p_wheel);
+        }
+
+        // Done
+        if ( p_wheel->running == false ) break;
+
+        // Nothing to wait for; sleep until a timer is added
+        if ( p_wheel->timer_quantity == 0 )
+        {
+            p_wheel->wake_tick = UINT64_MAX;
+            pthread_cond_wait(&p_wheel->_changed, &p_wheel->_lock);
+            continue;
+        }
+
+        // Sleep until the next tick with work
+        p_wheel->wake_tick = thread_pool_timer_wheel_next(p_wheel);
+
+        // Compute the deadline
+        next = p_wheel->start + p_wheel->wake_tick * PARALLEL_THREAD_POOL_TIMER_TICK;
+        _deadline.tv_sec  = (time_t) ( next / 1000000000ULL );
+        _deadline.tv_nsec = (long) ( next % 1000000000ULL );
+
+        // Sleep
+        pthread_cond_timedwait(&p_wheel->_changed, &p_wheel->_lock, &_deadline);
+    }
+
+    // Unlock
+    pthread_mutex_unlock(&p_wheel->_lock);
+
+    // Done
+    return (void *) 0;
+}
+
+void thread_pool_deadline ( struct timespec *p_deadline, size_t milliseconds )
+{
+
+    // Start from now
+    clock_gettime(CLOCK_MONOTONIC, p_deadline);
+
+    // Add the timeout
+    p_deadline->tv_sec  += (time_t) ( milliseconds / 1000 );
+    p_deadline->tv_nsec += (long) ( milliseconds % 1000 ) * 1000000L;
+
+    // Carry
+    if ( p_deadline->tv_nsec >= 1000000000L ) p_deadline->tv_sec++, p_deadline->tv_nsec -= 1000000000L;
+
+    // Done
+    return;
+}
+
+bool thread_pool_deadline_passed ( const struct timespec *p_deadline )
+{
+
+    // Initialized data
+    struct timespec _now = { 0 };
+
+    // Get the time
+    clock_gettime(CLOCK_MONOTONIC, &_now);
+
+    // Success
+    return ( _now.tv_sec > p_deadline->tv_sec || ( _now.tv_sec == p_deadline->tv_sec && _now.tv_nsec >= p_deadline->tv_nsec ) );
+}
+
+uint64_t thread_pool_clock ( void )
+{
+
+    // Initialized data
+    struct timespec _now = { 0 };
+
+    // Read the clock
+    clock_gettime(CLOCK_MONOTONIC, &_now);
+
+    // Done
+    return (uint64_t) _now.tv_sec * 1000000000ULL + (uint64_t) _now.tv_nsec;
+}
+
+void *thread_pool_run_job ( thread_pool_work_parameter *p_parameter, const thread_pool_job *p_job )
+{
+
+    // Initialized data
+    thread_pool_thread *p_thread_pool_thread = &p_parameter->_thread;
+    uint64_t            start                = thread_pool_clock(),
+                        latency              = ( start > p_job->submitted ) ? ( start - p_job->submitted ) / 1000 : 0;
+    size_t              bucket               = latency ? (size_t) ( 64 - __builtin_clzll(latency) ) : 0;
+    void               *ret                  = (void *) 0;
+
+    // Count the job's latency
+    PARALLEL_THREAD_POOL_STAT_ADD(p_thread_pool_thread->latency[( bucket < THREAD_POOL_LATENCY_BUCKETS ) ? bucket : THREAD_POOL_LATENCY_BUCKETS - 1], 1);
+
+    // A job run while another job waits is part of that job's busy time
+    if ( p_thread_pool_thread->nesting++ == 0 )
+    {
+
+        // Count the time since the last job
+        PARALLEL_THREAD_POOL_STAT_ADD(p_thread_pool_thread->idle_nanoseconds, start - p_thread_pool_thread->last);
+
+        // Sample the depth of the queues every few jobs
+        if ( atomic_load_explicit(&p_thread_pool_thread->jobs, memory_order_relaxed) % PARALLEL_THREAD_POOL_STATS_SAMPLE == 0 )
+        {
+
+            // Initialized data
+            uint64_t depth = thread_pool_queue_depth(p_parameter->p_thread_pool);
+
+            // Keep the deepest
+            if ( depth > atomic_load_explicit(&p_thread_pool_thread->max_queue_depth, memory_order_relaxed) )
+                atomic_store_explicit(&p_thread_pool_thread->max_queue_depth, depth, memory_order_relaxed);
+        }
+    }
+
+    // Run the job
+    PARALLEL_TRACE_BEGIN("job", (void *) 0, (const void *) p_job->pfn_parallel_task);
+    ret = p_job->pfn_parallel_task(p_job->p_parameter);
+    PARALLEL_TRACE_END("job", (void *) 0, (const void *) p_job->pfn_parallel_task);
+
+    // Count the job
+    PARALLEL_THREAD_POOL_STAT_ADD(p_thread_pool_thread->jobs, 1);
+
+    // Count the time the job ran
+    if ( --p_thread_pool_thread->nesting == 0 )
+    {
+
+        // Initialized data
+        uint64_t end = thread_pool_clock();
+
+        // Count the busy time
+        PARALLEL_THREAD_POOL_STAT_ADD(p_thread_pool_thread->busy_nanoseconds, end - start);
+
+        // Start counting idle time
+        p_thread_pool_thread->last = end;
+    }
+
+    // Done
+    return ret;
+}
+
+size_t thread_pool_queue_depth ( thread_pool *p_thread_pool )
+{
+
+    // Initialized data
+    size_t depth = 0;
+
+    // Count the jobs in each job queue
+    for (size_t i = 0; i < THREAD_POOL_PRIORITY_QUANTITY; i++)
+    {
+
+        // Initialized data
+        size_t enqueue_position = atomic_load_explicit(&p_thread_pool->_queues[i].enqueue_position, memory_order_relaxed),
+               dequeue_position = atomic_load_explicit(&p_thread_pool->_queues[i].dequeue_position, memory_order_relaxed);
+
+        // The positions are read apart, so the dequeue position may be ahead
+        if ( enqueue_position > dequeue_position ) depth += enqueue_position - dequeue_position;
+    }
+
+    // Count the jobs in each deque
+    if ( p_thread_pool->mode == THREAD_POOL_MODE_WORK_STEALING )
+        for (size_t i = 0, n = atomic_load_explicit(&p_thread_pool->started_threads, memory_order_acquire); i < n; i++)
+        {
+
+            // Initialized data
+            intptr_t top    = atomic_load_explicit(&p_thread_pool->_threads[i]._thread._deque.top, memory_order_relaxed),
+                     bottom = atomic_load_explicit(&p_thread_pool->_threads[i]._thread._deque.bottom, memory_order_relaxed);
+
+            // The owner may have reserved the last job
+            if ( bottom > top ) depth += (size_t) ( bottom - top );
+        }
+
+    // Done
+    return depth;
+}
+
+int thread_pool_submit ( thread_pool *p_thread_pool, const thread_pool_job *p_job, enum thread_pool_priority_e priority, bool shed )
+{
+
+    // Initialized data
+    thread_pool_queue           *p_queue      = &p_thread_pool->_queues[priority];
+    bool                         worker       = thread_pool_on_worker(p_thread_pool);
+    enum thread_pool_overflow_e  overflow     = shed ? p_thread_pool->overflow : THREAD_POOL_OVERFLOW_BLOCK;
+    size_t                       milliseconds = shed ? p_thread_pool->overflow_milliseconds : 0;
+    struct timespec              _deadline    = { 0 },
+                                 _nap         = { 0 };
+    thread_pool_job              _job         = *p_job;
+
+    // Stamp the job, so the worker that runs it can measure its latency
+    _job.submitted = thread_pool_clock();
+    p_job          = &_job;
+
+    // A work stealing worker pushes normal jobs onto its own deque
+    if ( priority == THREAD_POOL_PRIORITY_NORMAL && p_thread_pool->mode == THREAD_POOL_MODE_WORK_STEALING && worker )
+        if ( thread_pool_deque_push(&p_thread_pool_current_worker->_thread._deque, p_job) ) return 1;
+
+    // Fast path; the queue has room
+    if ( thread_pool_queue_enqueue(p_queue, p_job) ) return 1;
+
+    // Shed the job
+    if ( overflow == THREAD_POOL_OVERFLOW_REJECT ) goto rejected;
+
+    // Run the job on the submitting thread. It was counted, so finish it like a worker would
+    if ( overflow == THREAD_POOL_OVERFLOW_CALLER_RUNS )
+    {
+
+        // Run the job
+        PARALLEL_TRACE_BEGIN("job", (void *) 0, (const void *) p_job->pfn_parallel_task);
+        p_job->pfn_parallel_task(p_job->p_parameter);
+        PARALLEL_TRACE_END("job", (void *) 0, (const void *) p_job->pfn_parallel_task);
+
+        // Finish the job
+        thread_pool_finish_job(p_thread_pool);
+
+        // Success
+        return 1;
+    }
+
+    // Block for at most the overflow timeout
+    if ( milliseconds ) thread_pool_deadline(&_deadline, milliseconds);
+
+    // A worker that waits for a slot may be the only thread that could free one,
+    // so it runs queued jobs until the job fits
+    if ( worker )
+    {
+
+        // Run a job, or nap if another thread took the last one
+        while ( thread_pool_queue_enqueue(p_queue, p_job) == 0 )
+        {
+
+            // Give up
+            if ( milliseconds && thread_pool_deadline_passed(&_deadline) ) goto timed_out;
+
+            // Run a job
+            if ( thread_pool_help(p_thread_pool) ) continue;
+
+            // Compute the end of the nap. It never passes the deadline
+            thread_pool_deadline(&_nap, PARALLEL_THREAD_POOL_HELP_MILLISECONDS);
+            if ( milliseconds && ( _deadline.tv_sec < _nap.tv_sec || ( _deadline.tv_sec == _nap.tv_sec && _deadline.tv_nsec < _nap.tv_nsec ) ) ) _nap = _deadline;
+
+            // Lock
+            pthread_mutex_lock(&p_thread_pool->_lock);
+
+            // Announce this producer before checking the queue again ...
+            atomic_fetch_add(&p_thread_pool->waiting_producers, 1);
+
+            // ... so a worker that dequeues after this point will signal
+            while ( thread_pool_queue_full(p_queue) )
+                if ( pthread_cond_timedwait(&p_thread_pool->_slot_available, &p_thread_pool->_lock, &_nap) == ETIMEDOUT ) break;
+
+            // This producer is done waiting
+            atomic_fetch_sub(&p_thread_pool->waiting_producers, 1);
+
+            // Unlock
+            pthread_mutex_unlock(&p_thread_pool->_lock);
+        }
+
+        // Success
+        return 1;
+    }
+
+    // A busy polling producer never sleeps. Workers free slots without being woken
+    if ( p_thread_pool->wait == THREAD_POOL_WAIT_BUSY_POLL )
+    {
+
+        // Retry with exponential backoff until there is a free slot
+        for (size_t backoff = 1; thread_pool_queue_enqueue(p_queue, p_job) == 0; backoff = ( backoff < PARALLEL_THREAD_POOL_BACKOFF_LIMIT ) ? backoff * 2 : backoff)
+        {
+
+            // Give up
+            if ( milliseconds && thread_pool_deadline_passed(&_deadline) ) goto timed_out;
+
+            // Back off
+            for (size_t i = 0; i < backoff; i++)
+                PARALLEL_THREAD_POOL_PAUSE();
+        }
+
+        // Success
+        return 1;
+    }
+
+    // Slow path; the queue is full, so sleep until a worker frees a slot
+    pthread_mutex_lock(&p_thread_pool->_lock);
+
+    // Announce this producer before checking the queue again ...
+    atomic_fetch_add(&p_thread_pool->waiting_producers, 1);
+
+    // ... so a worker that dequeues after this point will signal
+    while ( thread_pool_queue_enqueue(p_queue, p_job) == 0 )
+    {
+
+        // A batch may fill the queue before it wakes anyone
+        thread_pool_unpark(p_thread_pool, p_thread_pool->thread_quantity);
+
+        // Wait for a free slot
+        if ( milliseconds == 0 )
+            pthread_cond_wait(&p_thread_pool->_slot_available, &p_thread_pool->_lock);
+
+        // Wait for a free slot, or for the deadline
+        else if ( pthread_cond_timedwait(&p_thread_pool->_slot_available, &p_thread_pool->_lock, &_deadline) == ETIMEDOUT )
+        {
+
+            // Take a slot that was freed at the last moment
+            if ( thread_pool_queue_enqueue(p_queue, p_job) ) break;
+
+            // This producer is done waiting
+            atomic_fetch_sub(&p_thread_pool->waiting_producers, 1);
+
+            // Unlock
+            pthread_mutex_unlock(&p_thread_pool->_lock);
+
+            // Error
+            goto timed_out;
+        }
+    }
+
+    // This producer is done waiting
+    atomic_fetch_sub(&p_thread_pool->waiting_producers, 1);
+
+    // Unlock
+    pthread_mutex_unlock(&p_thread_pool->_lock);
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Parallel errors
+        {
+            rejected:
+
+                // The queue is full
+                errno = EAGAIN;
+
+                // Error
+                return 0;
+
+            timed_out:
+
+                // The queue stayed full
+                errno = ETIMEDOUT;
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+void thread_pool_post ( thread_pool *p_thread_pool, fn_parallel_task *pfn_parallel_task, void *p_parameter )
+{
+
+    // Initialized data
+    thread_pool_job _job =
+    {
+        .pfn_parallel_task = pfn_parallel_task,
+        .p_parameter       = p_parameter
+    };
+
+    // Count the job before a worker can see it
+    atomic_fetch_add(&p_thread_pool->outstanding_jobs, 1);
+
+    // Submit the job. It is never shed
+    thread_pool_submit(p_thread_pool, &_job, THREAD_POOL_PRIORITY_NORMAL, false);
+
+    // Wake a sleeping worker, if there is one
+    thread_pool_wake(p_thread_pool, 1);
+
+    // Done
+    return;
+}
+
+void thread_pool_wake ( thread_pool *p_thread_pool, size_t quantity )
+{
+
+    // Initialized data
+    size_t spinning_threads = 0;
+
+    // Busy polling workers never sleep
+    if ( p_thread_pool->wait == THREAD_POOL_WAIT_BUSY_POLL ) return;
+
+    // Order the submits before the sleeper check
+    atomic_thread_fence(memory_order_seq_cst);
+
+    // Every worker is awake
+    if ( atomic_load_explicit(&p_thread_pool->sleeping_threads, memory_order_relaxed) == 0 )
+    {
+
+        // Add a worker to an elastic thread pool if jobs are waiting
+        thread_pool_grow(p_thread_pool);
+
+        // Done
+        return;
+    }
 
-    // Initialized data
-    thread_pool *p_thread_pool = (void *) 0;
+    // Spinning workers will take the jobs without a system call
+    if ( ( spinning_threads = atomic_load_explicit(&p_thread_pool->spinning_threads, memory_order_relaxed) ) >= quantity ) return;
 
-    // Allocate memory for the thread_pool
-    p_thread_pool = PARALLEL_REALLOC(0, sizeof(thread_pool));
+    // Lock
+    pthread_mutex_lock(&p_thread_pool->_lock);
 
-    // Error check
-    if ( p_thread_pool == (void *) 0 ) goto no_mem;
+    // Wake one parked worker for each job the spinning workers won't take
+    thread_pool_unpark(p_thread_pool, quantity - spinning_threads);
 
-    // Zero set memory
-    memset(p_thread_pool, 0, sizeof(thread_pool));
+    // Unlock
+    pthread_mutex_unlock(&p_thread_pool->_lock);
 
-    // Return a pointer to the caller
-    *pp_thread_pool = p_thread_pool;
+    // Done
+    return;
+}
 
-    // Success
-    return 1;
+void thread_pool_unpark ( thread_pool *p_thread_pool, size_t quantity )
+{
 
-    // Error handling
+    // Wake the newest parked workers
+    while ( quantity-- && p_thread_pool->p_parked )
     {
 
-        // Argument errors
-        {
-            no_thread_pool: 
-                #ifndef NDEBUG
-                    log_error("[parallel] [thread pool] Null pointer provided for parameter \"pp_thread_pool\" in call to function \"%s\"\n", __FUNCTION__);
-                #endif
+        // Initialized data
+        thread_pool_work_parameter *p_parameter = p_thread_pool->p_parked;
+        thread_pool_thread         *p_thread    = &p_parameter->_thread;
 
-                // Error
-                return 0;
-        }
-        
-        // Standard library errors
-        {
-            no_mem:
-                #ifndef NDEBUG
-                    log_error("[Standard Library] Failed to allocate memory in call to function \"%s\"\n", __FUNCTION__);
-                #endif
-                
-                // Error
-                return 0;
-        }
+        // Pop the worker
+        p_thread_pool->p_parked = p_thread->p_next_parked;
+        p_thread->p_next_parked = (void *) 0;
+
+        // The worker is awake
+        atomic_fetch_sub(&p_thread_pool->sleeping_threads, 1);
+
+        // Wake the worker. The worker can't retire after this, because it
+        // checks the flag under the lock. Waking doesn't block, so it is done
+        // under the lock too, before the worker can park again
+        #ifdef __linux__
+            atomic_store_explicit(&p_thread->unparked, 1, memory_order_release);
+            syscall(SYS_futex, (void *) &p_thread->unparked, FUTEX_WAKE_PRIVATE, 1, (void *) 0, (void *) 0, 0);
+        #else
+            pthread_mutex_lock(&p_thread->_park_lock);
+            atomic_store_explicit(&p_thread->unparked, 1, memory_order_release);
+            pthread_cond_signal(&p_thread->_park);
+            pthread_mutex_unlock(&p_thread->_park_lock);
+        #endif
     }
+
+    // Done
+    return;
 }
 
-int thread_pool_construct ( thread_pool **pp_thread_pool, int thread_quantity )
+int thread_pool_park ( thread_pool_work_parameter *p_parameter, const struct timespec *p_deadline )
 {
 
-    // Argument check
-    if ( pp_thread_pool  ==                       (void *) 0 ) goto no_thread_pool;
-    if ( thread_quantity ==                                0 ) goto no_thread_quantity;
-    if ( thread_quantity >  PARALLEL_THREAD_POOL_MAX_THREADS ) goto too_many_threads;
-    
     // Initialized data
-    thread_pool *p_thread_pool = (void *) 0;
-
-    // Construct a thread pool
-    if ( thread_pool_create(&p_thread_pool) == 0 ) goto failed_to_create_thread_pool;
+    thread_pool_thread *p_thread = &p_parameter->_thread;
 
-    // Grow the allocation
-    p_thread_pool = PARALLEL_REALLOC(p_thread_pool, sizeof(thread_pool) * ( thread_quantity * sizeof(thread_pool_work_parameter) ));
+    // Platform dependent implementation
+    #ifdef __linux__
 
-    // Initialize data
-    memset(p_thread_pool, 0, sizeof(thread_pool) * ( thread_quantity * sizeof(thread_pool_work_parameter) ));
-
-    // Error check
-    if ( p_thread_pool == (void *) 0 ) goto no_mem;
+        // Sleep on the flag until it is set. Spurious wakeups check again
+        while ( atomic_load_explicit(&p_thread->unparked, memory_order_acquire) == 0 )
+            if ( syscall(SYS_futex, (void *) &p_thread->unparked, FUTEX_WAIT_BITSET_PRIVATE, 0, p_deadline, (void *) 0, FUTEX_BITSET_MATCH_ANY) == -1 && errno == ETIMEDOUT )
+                return atomic_load_explicit(&p_thread->unparked, memory_order_acquire) != 0;
 
-    // Store the quantity of threads
-    *p_thread_pool = (thread_pool)
+    #else
     {
-        .thread_quantity = thread_quantity,
-        ._montior = { 0 }
-    };
 
-    // Construct a monitor
-    monitor_create(&p_thread_pool->_montior);
+        // Initialized data
+        int result = 0;
 
-    // Construct threads
-    for (size_t i = 0; i < thread_quantity; i++)
-    {
-    
-        // Store the thread pool in the parameter
-        p_thread_pool->_threads[i].p_thread_pool = p_thread_pool;
+        // Lock
+        pthread_mutex_lock(&p_thread->_park_lock);
 
-        // Construct a monitor
-        monitor_create(&p_thread_pool->_threads[i]._thread._montior);
+        // Sleep until the flag is set, or the deadline passes
+        while ( atomic_load_explicit(&p_thread->unparked, memory_order_acquire) == 0 && result != ETIMEDOUT )
+            result = ( p_deadline ) ? pthread_cond_timedwait(&p_thread->_park, &p_thread->_park_lock, p_deadline)
+                                    : pthread_cond_wait(&p_thread->_park, &p_thread->_park_lock);
 
-        // Construct a thread
-        if ( parallel_thread_start(&p_thread_pool->_threads[i]._thread.p_parallel_thread, (fn_parallel_task *)thread_pool_work, &p_thread_pool->_threads[i]) == 0 ) goto failed_to_start_thread;
+        // Unlock
+        pthread_mutex_unlock(&p_thread->_park_lock);
+
+        // Done
+        return atomic_load_explicit(&p_thread->unparked, memory_order_acquire) != 0;
     }
+    #endif
+
+    // Success
+    return 1;
+}
+
+int thread_pool_dequeue_job ( thread_pool *p_thread_pool, enum thread_pool_priority_e priority, thread_pool_job *p_job )
+{
 
-    // Wait for all the threads to start
-    while ( p_thread_pool->running_threads != thread_quantity )
-        sleep(0);
-    
-    // Start the worker threads
-    monitor_notify_all(&p_thread_pool->_montior);
+    // The queue is empty
+    if ( thread_pool_queue_dequeue(&p_thread_pool->_queues[priority], p_job) == 0 ) return 0;
 
-    // Return a pointer to the caller
-    *pp_thread_pool = p_thread_pool;
+    // Order the dequeue before the producer check
+    atomic_thread_fence(memory_order_seq_cst);
+
+    // Wake a producer that is waiting on a full queue
+    if ( atomic_load_explicit(&p_thread_pool->waiting_producers, memory_order_relaxed) )
+    {
+
+        // Lock
+        pthread_mutex_lock(&p_thread_pool->_lock);
+
+        // Signal every producer. They may be waiting on different queues
+        pthread_cond_broadcast(&p_thread_pool->_slot_available);
+
+        // Unlock
+        pthread_mutex_unlock(&p_thread_pool->_lock);
+    }
 
     // Success
     return 1;
+}
 
-    // Error handling
-    {
+bool thread_pool_on_worker ( thread_pool *p_thread_pool )
+{
 
-        // Argument errors
-        {
-            no_thread_pool:
-                #ifndef NDEBUG
-                    log_error("[parallel] [thread pool] Null pointer provided for parameter \"pp_thread_pool\" in call to function \"%s\"\n", __FUNCTION__);
-                #endif
+    // Done
+    return p_thread_pool_current_worker && p_thread_pool_current_worker->p_thread_pool == p_thread_pool;
+}
 
-                // Error
-                return 0;
+int thread_pool_help ( thread_pool *p_thread_pool )
+{
 
-            no_thread_quantity:
-                #ifndef NDEBUG
-                    log_error("[parallel] [thread pool] Null pointer provided for parameter \"thread_quantity\" in call to function \"%s\"\n", __FUNCTION__);
-                #endif
+    // Initialized data
+    thread_pool_job _job  = { 0 };
+    bool            found = false;
 
-                // Error
-                return 0;
+    // A worker of this thread pool looks for jobs like it always does
+    if ( thread_pool_on_worker(p_thread_pool) )
+        found = thread_pool_next_job(p_thread_pool_current_worker, &_job);
 
-            too_many_threads:
-                #ifndef NDEBUG
-                    log_error("[parallel] [thread pool] Parameter \"thread_quantity\" must be less than %d in call to function \"%s\"\n", PARALLEL_THREAD_POOL_MAX_THREADS, __FUNCTION__);
-                #endif
+    // Any other thread takes critical and normal jobs from the job queues ...
+    else
+    {
 
-                // Error
-                return 0;
-        }
+        // Take from the job queues
+        found = thread_pool_dequeue_job(p_thread_pool, THREAD_POOL_PRIORITY_CRITICAL, &_job)
+             || thread_pool_dequeue_job(p_thread_pool, THREAD_POOL_PRIORITY_NORMAL,   &_job);
 
-        // Parallel errors
-        {
-            failed_to_create_thread_pool:
-                #ifndef NDEBUG
-                    log_error("[parallel] [thread pool] Failed to create thread pool in call to function \"%s\"\n", __FUNCTION__);
-                #endif
+        // ... or steals from a worker ...
+        if ( p_thread_pool->mode == THREAD_POOL_MODE_WORK_STEALING )
+            for (size_t i = 0, n = atomic_load_explicit(&p_thread_pool->started_threads, memory_order_acquire); i < n && found == false; i++)
+                found = thread_pool_deque_steal(&p_thread_pool->_threads[i]._thread._deque, &_job);
 
-                // Error
-                return 0;
+        // ... or takes a background job
+        if ( found == false ) found = thread_pool_dequeue_job(p_thread_pool, THREAD_POOL_PRIORITY_BACKGROUND, &_job);
+    }
 
-            failed_to_start_thread:
-                #ifndef NDEBUG
-                    log_error("[parallel] [thread pool] Failed to create thread in call to function \"%s\"\n", __FUNCTION__);
-                #endif
+    // Nothing to run
+    if ( found == false ) return 0;
 
-                // Error
-                return 0;
-        }
+    // Run the job. A worker counts it in its statistics
+    if ( thread_pool_on_worker(p_thread_pool) ) thread_pool_run_job(p_thread_pool_current_worker, &_job);
+    else
+    {
 
-        // Standard library errors
-        {
-            no_mem:
-                #ifndef NDEBUG
-                    log_error("[Standard Library] Failed to allocate memory in call to function \"%s\"\n", __FUNCTION__);
-                #endif
-                
-                // Error
-                return 0;
-        }
+        // Run the job
+        PARALLEL_TRACE_BEGIN("job", (void *) 0, (const void *) _job.pfn_parallel_task);
+        _job.pfn_parallel_task(_job.p_parameter);
+        PARALLEL_TRACE_END("job", (void *) 0, (const void *) _job.pfn_parallel_task);
     }
+
+    // Count the job as done
+    thread_pool_finish_job(p_thread_pool);
+
+    // Success
+    return 1;
 }
 
-int thread_pool_execute ( thread_pool *p_thread_pool, fn_parallel_task *pfn_parallel_task, void *p_parameter )
+void *thread_pool_for_run ( thread_pool_for_range *p_range )
 {
 
-    // Argument check
-    if ( p_thread_pool     == (void *) 0 ) goto no_thread_pool;
-    if ( pfn_parallel_task == (void *) 0 ) goto no_parallel_task;
-
     // Initialized data
-    size_t i = 0;
+    thread_pool_for *p_for = p_range->p_for;
+    size_t           first = p_range->first,
+                     last  = p_range->last,
+                     begin = 0,
+                     end   = 0;
 
-    try_again:
+    // Hand the upper half of the range to the thread pool, until one piece is left
+    while ( last - first > 1 )
+    {
 
-    // Lock
-    mutex_lock(&p_thread_pool->_lock);
+        // Initialized data
+        size_t                 middle  = first + ( last - first ) / 2;
+        thread_pool_for_range *p_upper = &p_for->p_ranges[atomic_fetch_add_explicit(&p_for->next_range, 1, memory_order_relaxed)];
 
-    // Defer to other threads
-    sleep(0);
+        // Populate the upper half
+        *p_upper = (thread_pool_for_range)
+        {
+            .p_for = p_for,
+            .first = middle,
+            .last  = last
+        };
 
-    // Find an idle thread
-    for (i = 0; i < p_thread_pool->thread_quantity; i++)
-    {   
+        // Count the upper half before it can finish
+        atomic_fetch_add(&p_for->pending_ranges, 1);
 
-        // If this thread is running, try the next one
-        if ( p_thread_pool->_threads[i]._thread.running ) continue;
+        // Run the upper half on the thread pool
+        thread_pool_post(p_for->p_thread_pool, (fn_parallel_task *) thread_pool_for_run, p_upper);
 
-        // Found one
-        goto found_thread;
+        // Keep the lower half
+        last = middle;
     }
 
-    // Unlock
-    mutex_unlock(&p_thread_pool->_lock);
+    // Compute the bounds of the piece
+    begin = p_for->begin + first * p_for->piece_size;
+    end   = ( p_for->end - begin > p_for->piece_size ) ? begin + p_for->piece_size : p_for->end;
 
-    // Defer to other threads
-    sleep(0);
+    // Run the user's loop body
+    p_for->pfn_parallel_for(begin, end, p_for->p_context);
 
-    // Find the idle thread
-    goto try_again;
+    // Not the last range
+    if ( atomic_fetch_sub(&p_for->pending_ranges, 1) != 1 ) return (void *) 0;
 
-    found_thread:
- 
-    // Set up the task
-    p_thread_pool->_threads[i]._thread.pfn_parallel_task = pfn_parallel_task;
-    p_thread_pool->_threads[i]._thread.p_parameter       = p_parameter;
-    p_thread_pool->_threads[i]._thread.running           = true;
+    // Lock
+    pthread_mutex_lock(&p_for->_lock);
 
-    sleep(0);
+    // The parallel for is done
+    p_for->done = true;
 
-    // Signal the thread
-    monitor_notify(&p_thread_pool->_threads[i]._thread._montior);
+    // Wake the caller
+    pthread_cond_signal(&p_for->_done);
 
     // Unlock
-    mutex_unlock(&p_thread_pool->_lock);
-    
-    // Success
-    return 1;
+    pthread_mutex_unlock(&p_for->_lock);
 
-    // Error handling
-    {
+    // Done
+    return (void *) 0;
+}
 
-        // Argument errors
-        {
-            no_thread_pool:
-                #ifndef NDEBUG
-                    log_error("[parallel] [thread pool] Null pointer provided for parameter \"p_thread_pool\" in call to function \"%s\"\n", __FUNCTION__);
-                #endif
+void thread_pool_reduce_run ( size_t begin, size_t end, thread_pool_reduce *p_reduce )
+{
 
-                // Error
-                return 0;
+    // Initialized data
+    thread_pool             *p_thread_pool = p_reduce->p_thread_pool;
+    size_t                   shared        = p_reduce->slot_quantity - 1,
+                             index         = shared;
+    thread_pool_reduce_slot *p_slot        = (void *) 0;
 
-            no_parallel_task:
-                #ifndef NDEBUG
-                    log_error("[parallel] [thread pool] Null pointer provided for parameter \"pfn_parallel_task\" in call to function \"%s\"\n", __FUNCTION__);
-                #endif
+    // A worker of this thread pool folds into its own partial ...
+    if ( p_thread_pool_current_worker && p_thread_pool_current_worker->p_thread_pool == p_thread_pool )
+        index = (size_t) ( p_thread_pool_current_worker - p_thread_pool->_threads );
 
-                // Error
-                return 0;
-        }
+    // ... and so does the caller
+    else if ( pthread_equal(pthread_self(), p_reduce->caller) )
+        index = shared - 1;
 
-        // Standard library errors
-        {
-            no_mem:
-                #ifndef NDEBUG
-                    log_error("[Standard Library] Failed to allocate memory in call to function \"%s\"\n", __FUNCTION__);
-                #endif
-                
-                // Error
-                return 0;
-        }
-    }
-}
+    // Get the partial
+    p_slot = thread_pool_reduce_slot_get(p_reduce, index);
 
-int thread_pool_wait_idle ( thread_pool *p_thread_pool )
-{
+    // Fast path; fold the piece straight into this thread's partial
+    if ( index != shared && p_slot->busy == false )
+    {
 
-    // Argument check
-    if ( p_thread_pool == (void *) 0 ) goto no_thread_pool;
+        // Fold the piece into the partial
+        p_slot->busy = true;
+        p_reduce->pfn_parallel_reduce(begin, end, p_slot->_value, p_reduce->p_context);
+        p_slot->busy = false;
+        p_slot->used = true;
 
-    // Initialized data
-    bool is_running = true;
+        // Done
+        return;
+    }
 
-    // Until the thread pool is idle
-    while ( is_running )
+    // Slow path; another thread helped, or a loop body that waits on the 
+    // thread pool ran this piece while its partial is in use. Fold the piece 
+    // into a temporary partial, then combine it into the shared partial
     {
 
-        is_running = false;
+        // Initialized data
+        _Alignas(max_align_t) unsigned char _stack[PARALLEL_THREAD_POOL_REDUCE_STACK];
+        void *p_partial = ( p_reduce->size > sizeof(_stack) ) ? PARALLEL_REALLOC(0, p_reduce->size) : _stack;
 
-        // For all threads in the thread pool ...
-        for (size_t i = 0; i < p_thread_pool->thread_quantity; i++)
-        
-            // ... if a thread is running set the flag ...
-            is_running |= p_thread_pool->_threads[i]._thread.running;
-        
-        // ... defer to other threads 
-        sleep(0);
-    };
+        // Error check
+        if ( p_partial == (void *) 0 ) goto no_mem;
 
-    // Success
-    return 1;
+        // Fold the piece into the temporary partial
+        memcpy(p_partial, p_reduce->p_identity, p_reduce->size);
+        p_reduce->pfn_parallel_reduce(begin, end, p_partial, p_reduce->p_context);
+
+        // Get the shared partial
+        p_slot = thread_pool_reduce_slot_get(p_reduce, shared);
+
+        // Lock
+        pthread_mutex_lock(&p_reduce->_shared_lock);
+
+        // Combine the temporary partial ...
+        if ( p_slot->used ) p_reduce->pfn_parallel_combine(p_slot->_value, p_partial, p_reduce->p_context);
+
+        // ... or take it as is
+        else memcpy(p_slot->_value, p_partial, p_reduce->size), p_slot->used = true;
+
+        // Unlock
+        pthread_mutex_unlock(&p_reduce->_shared_lock);
+
+        // Clean up
+        if ( p_partial != _stack ) PARALLEL_FREE(p_partial);
+    }
+
+    // Done
+    return;
 
     // Error handling
     {
 
-        // Argument errors
+        // Standard library errors
         {
-            no_thread_pool:
+            no_mem:
+
+                // The piece is lost, so the result is wrong
+                atomic_store(&p_reduce->failed, true);
+
                 #ifndef NDEBUG
-                    log_error("[parallel] [thread pool] Null pointer provided for parameter \"p_thread_pool\" in call to function \"%s\"\n", __FUNCTION__);
+                    log_error("[Standard Library] Failed to allocate memory in call to function \"%s\"\n", __FUNCTION__);
                 #endif
 
                 // Error
-                return 0;
+                return;
         }
     }
 }
 
-void *thread_pool_work ( thread_pool_work_parameter *p_parameter )
+thread_pool_reduce_slot *thread_pool_reduce_slot_get ( thread_pool_reduce *p_reduce, size_t index )
 {
 
-    // Argument check
-    if ( p_parameter == (void *) 0 ) goto no_work_parameter;
+    // Done
+    return (thread_pool_reduce_slot *) ( p_reduce->p_slots + index * p_reduce->slot_size );
+}
+
+int thread_pool_worker_start ( thread_pool *p_thread_pool )
+{
 
     // Initialized data
-    thread_pool        *p_thread_pool        = p_parameter->p_thread_pool;
-    thread_pool_thread *p_thread_pool_thread = &p_parameter->_thread;
-    
-    // Lock
-    mutex_lock(&p_thread_pool->_lock);
+    thread_pool_work_parameter *p_worker = (void *) 0;
+    size_t                      i        = 0;
 
-    // Increment the quantity of running threads
-    p_thread_pool->running_threads++;
+    // Find a free slot
+    for (i = 0; i < p_thread_pool->thread_quantity; i++)
+        if ( p_thread_pool->_threads[i]._thread.state != PARALLEL_THREAD_POOL_WORKER_RUNNING ) break;
 
-    // Unlock
-    mutex_unlock(&p_thread_pool->_lock);
+    // Every slot is in use
+    if ( i == p_thread_pool->thread_quantity ) return 0;
 
-    // Wait for the thread pool to start
-    monitor_wait(&p_thread_pool->_montior);
+    // Initialized data
+    p_worker = &p_thread_pool->_threads[i];
 
-    wait_for_next_task:
+    // Join the thread of the slot's retired worker
+    if ( p_worker->_thread.state == PARALLEL_THREAD_POOL_WORKER_RETIRED && p_worker->_thread.p_parallel_thread )
+        if ( parallel_thread_join(&p_worker->_thread.p_parallel_thread) == 0 ) goto failed_to_join_thread;
+
+    // Set up a slot that has never been used
+    if ( p_worker->_thread.state == PARALLEL_THREAD_POOL_WORKER_EMPTY )
+    {
+
+        // Store the thread pool in the parameter
+        p_worker->p_thread_pool = p_thread_pool;
 
-    p_parameter->_thread.running = false;
+        // Seed the victim generator
+        p_worker->_thread.victim_seed = ( i + 1 ) * 0x9E3779B97F4A7C15ULL;
 
-    // Wait for a task to be assigned
-    monitor_wait(&p_parameter->_thread._montior);
+        // Construct a parking spot. Linux parks on a futex instead
+        #ifndef __linux__
+        {
 
-    p_parameter->_thread.running = true;
+            // Initialized data
+            pthread_condattr_t _attributes;
 
-    // Run the user's task
-    p_parameter->_thread.ret = p_parameter->_thread.pfn_parallel_task(p_parameter->_thread.p_parameter);
+            // Deadlines are on the monotonic clock
+            pthread_condattr_init(&_attributes);
+            pthread_condattr_setclock(&_attributes, CLOCK_MONOTONIC);
+            pthread_cond_init(&p_worker->_thread._park, &_attributes);
+            pthread_condattr_destroy(&_attributes);
+            pthread_mutex_init(&p_worker->_thread._park_lock, NULL);
+        }
+        #endif
 
-    p_parameter->_thread.running = false;
+        // Construct a deque
+        if ( p_thread_pool->mode == THREAD_POOL_MODE_WORK_STEALING )
+            if ( thread_pool_deque_construct(&p_worker->_thread._deque, PARALLEL_THREAD_POOL_DEQUE_LENGTH) == 0 ) goto failed_to_construct_deque;
 
-    sleep(0);
+        // Publish the slot to thieves
+        atomic_store_explicit(&p_thread_pool->started_threads, i + 1, memory_order_release);
+    }
 
-    monitor_notify(&p_thread_pool->_montior);
+    // Count the worker
+    p_worker->_thread.state = PARALLEL_THREAD_POOL_WORKER_RUNNING;
+    atomic_fetch_add(&p_thread_pool->live_threads, 1);
 
-    // Wait for the next task
-    goto wait_for_next_task;    
+    // Start the worker
+    if ( parallel_thread_start_with_affinity(&p_worker->_thread.p_parallel_thread, (fn_parallel_task *) thread_pool_work, p_worker, p_worker->_thread.cpu) == 0 ) goto failed_to_start_thread;
 
     // Success
-    return (void *) 1;
+    return 1;
 
     // Error handling
     {
 
-        // Argument errors
+        // Parallel errors
         {
-            no_work_parameter:
+            failed_to_join_thread:
                 #ifndef NDEBUG
-                    log_error("[parallel] [schedule] Null pointer provided for parameter \"p_parameter\" in call to function \"%s\"\n", __FUNCTION__);
+                    log_error("[parallel] [thread pool] Failed to join thread in call to function \"%s\"\n", __FUNCTION__);
                 #endif
 
                 // Error
                 return 0;
-        }
 
-        // Parallel errors
-        {
-            failed_to_find_monitor:
+            failed_to_construct_deque:
+
+                // Destroy the parking spot, since the slot stays unused
+                #ifndef __linux__
+                    pthread_cond_destroy(&p_worker->_thread._park);
+                    pthread_mutex_destroy(&p_worker->_thread._park_lock);
+                #endif
+
+                #ifndef NDEBUG
+                    log_error("[parallel] [thread pool] Failed to construct deque in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            failed_to_start_thread:
+
+                // Give back the slot
+                p_worker->_thread.state = PARALLEL_THREAD_POOL_WORKER_RETIRED;
+                atomic_fetch_sub(&p_thread_pool->live_threads, 1);
+
                 #ifndef NDEBUG
+                    log_error("[parallel] [thread pool] Failed to create thread in call to function \"%s\"\n", __FUNCTION__);
                 #endif
 
                 // Error
@@ -484,3 +5809,36 @@ void *thread_pool_work ( thread_pool_work_parameter *p_parameter )
         }
     }
 }
+
+void thread_pool_grow ( thread_pool *p_thread_pool )
+{
+
+    // Initialized data
+    size_t live_threads = atomic_load_explicit(&p_thread_pool->live_threads, memory_order_relaxed);
+
+    // The thread pool is at its maximum quantity of threads
+    if ( live_threads >= p_thread_pool->thread_quantity ) return;
+
+    // A worker is spinning or parked, or no jobs are waiting
+    if ( atomic_load_explicit(&p_thread_pool->sleeping_threads, memory_order_relaxed) ) return;
+    if ( atomic_load_explicit(&p_thread_pool->spinning_threads, memory_order_relaxed) ) return;
+    if ( atomic_load_explicit(&p_thread_pool->outstanding_jobs, memory_order_relaxed) <= live_threads ) return;
+
+    // Another thread is already adding a worker
+    if ( atomic_exchange(&p_thread_pool->growing, true) ) return;
+
+    // Lock
+    pthread_mutex_lock(&p_thread_pool->_lock);
+
+    // Add a worker, unless the thread pool is being destroyed
+    if ( atomic_load(&p_thread_pool->running) ) thread_pool_worker_start(p_thread_pool);
+
+    // Unlock
+    pthread_mutex_unlock(&p_thread_pool->_lock);
+
+    // Done
+    atomic_store(&p_thread_pool->growing, false);
+
+    // Done
+    return;
+}
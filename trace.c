@@ -0,0 +1,481 @@
+/** !
+ * Timeline traces of thread pool jobs and schedule tasks
+ *
+ * @file trace.c
+ *
+ * @author Jacob Smith
+ */
+
+// Feature test macros
+#ifndef _GNU_SOURCE
+    #define _GNU_SOURCE
+#endif
+
+// Standard library
+#include <stdint.h>
+#include <stdatomic.h>
+#include <time.h>
+#include <pthread.h>
+
+// Header
+#include <parallel/trace.h>
+
+// Preprocessor definitions
+#define PARALLEL_TRACE_THREAD_NAME_LENGTH (63 + 1)
+
+// Forward declarations
+struct parallel_trace_record_s;
+struct parallel_trace_buffer_s;
+
+// Type definitions
+typedef struct parallel_trace_record_s parallel_trace_record;
+typedef struct parallel_trace_buffer_s parallel_trace_buffer;
+
+// Structure definitions
+struct parallel_trace_record_s
+{
+    uint64_t    timestamp; // nanoseconds on the monotonic clock
+    const char *name,
+               *detail;
+    const void *p_address;
+    char        phase;
+};
+
+struct parallel_trace_buffer_s
+{
+
+    // Written once, when the thread records its first event
+    parallel_trace_buffer *p_next;
+    size_t                 id;
+
+    // Written by the owner when a trace starts, read by parallel_trace_write
+    atomic_size_t          generation;
+    size_t                 capacity;
+    parallel_trace_record *p_events;
+
+    // Written by the owner for every event, read by parallel_trace_write
+    atomic_size_t          count;
+    atomic_size_t          dropped;
+
+    // Written under the lock
+    char                   _name[PARALLEL_TRACE_THREAD_NAME_LENGTH];
+};
+
+// Data
+atomic_bool                                 parallel_trace_enabled         = false;
+static atomic_size_t                        parallel_trace_generation      = 0;
+static atomic_size_t                        parallel_trace_event_quantity  = PARALLEL_TRACE_EVENTS;
+static _Atomic(uint64_t)                    parallel_trace_epoch           = 0;
+static parallel_trace_buffer               *p_parallel_trace_buffers       = (void *) 0;
+static size_t                               parallel_trace_buffer_quantity = 0;
+static pthread_mutex_t                      parallel_trace_lock            = PTHREAD_MUTEX_INITIALIZER;
+static _Thread_local parallel_trace_buffer *p_parallel_trace_buffer        = (void *) 0;
+static _Thread_local char                   parallel_trace_thread_name[PARALLEL_TRACE_THREAD_NAME_LENGTH] = { 0 };
+
+// Function declarations
+/** !
+ * Read the monotonic clock
+ *
+ * @return the time, in nanoseconds
+ */
+uint64_t parallel_trace_clock ( void );
+
+/** !
+ * Get the calling thread's buffer, ready for a trace. The first call on a
+ * thread allocates the buffer; the first call of a trace grows and empties it
+ * under the lock, so parallel_trace_write never reads events that are being
+ * moved or overwritten. Only the owner writes its buffer, so no lock is held
+ * while events are recorded
+ *
+ * @param generation the trace
+ *
+ * @return the buffer, or null pointer if there is no memory for it
+ */
+parallel_trace_buffer *parallel_trace_buffer_get ( size_t generation );
+
+/** !
+ * Write a string as a JSON string
+ *
+ * @param p_f    the file
+ * @param string the string
+ *
+ * @return void
+ */
+void parallel_trace_write_string ( FILE *p_f, const char *string );
+
+// Function definitions
+int parallel_trace_start ( size_t event_quantity )
+{
+
+    // Store the size of new buffers
+    atomic_store(&parallel_trace_event_quantity, event_quantity ? event_quantity : PARALLEL_TRACE_EVENTS);
+
+    // Start the clock
+    atomic_store(&parallel_trace_epoch, parallel_trace_clock());
+
+    // Start a new trace. Each thread empties its own buffer at its next event
+    atomic_fetch_add(&parallel_trace_generation, 1);
+
+    // Start recording
+    atomic_store_explicit(&parallel_trace_enabled, true, memory_order_release);
+
+    // Success
+    return 1;
+}
+
+int parallel_trace_stop ( void )
+{
+
+    // Stop recording
+    atomic_store_explicit(&parallel_trace_enabled, false, memory_order_release);
+
+    // Success
+    return 1;
+}
+
+int parallel_trace_name_thread ( const char *const name )
+{
+
+    // Argument check
+    if ( name == (void *) 0 ) goto no_name;
+
+    // Store the name for the thread's buffer
+    strncpy(parallel_trace_thread_name, name, PARALLEL_TRACE_THREAD_NAME_LENGTH - 1);
+
+    // Rename a buffer that already exists
+    if ( p_parallel_trace_buffer )
+    {
+
+        // Lock
+        pthread_mutex_lock(&parallel_trace_lock);
+
+        // Copy the name
+        strncpy(p_parallel_trace_buffer->_name, name, PARALLEL_TRACE_THREAD_NAME_LENGTH - 1);
+
+        // Unlock
+        pthread_mutex_unlock(&parallel_trace_lock);
+    }
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_name:
+                #ifndef NDEBUG
+                    log_error("[parallel] [trace] Null pointer provided for parameter \"name\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+void parallel_trace_event ( char phase, const char *name, const char *detail, const void *p_address )
+{
+
+    // Initialized data
+    parallel_trace_buffer *p_buffer   = p_parallel_trace_buffer;
+    size_t                 generation = atomic_load_explicit(&parallel_trace_generation, memory_order_relaxed),
+                           count      = 0;
+
+    // The first event of this thread, or of this trace
+    if ( p_buffer == (void *) 0 || atomic_load_explicit(&p_buffer->generation, memory_order_relaxed) != generation )
+        if ( ( p_buffer = parallel_trace_buffer_get(generation) ) == (void *) 0 ) return;
+
+    // Initialized data
+    count = atomic_load_explicit(&p_buffer->count, memory_order_relaxed);
+
+    // The buffer is full; drop the event
+    if ( count == p_buffer->capacity )
+    {
+
+        // Count the dropped event
+        atomic_store_explicit(&p_buffer->dropped, atomic_load_explicit(&p_buffer->dropped, memory_order_relaxed) + 1, memory_order_relaxed);
+
+        // Done
+        return;
+    }
+
+    // Store the event
+    p_buffer->p_events[count] = (parallel_trace_record)
+    {
+        .timestamp = parallel_trace_clock(),
+        .name      = name,
+        .detail    = detail,
+        .p_address = p_address,
+        .phase     = phase
+    };
+
+    // Publish the event to parallel_trace_write
+    atomic_store_explicit(&p_buffer->count, count + 1, memory_order_release);
+
+    // Done
+    return;
+}
+
+int parallel_trace_write ( const char *const path )
+{
+
+    // Argument check
+    if ( path == (void *) 0 ) goto no_path;
+
+    // Initialized data
+    FILE     *p_f        = fopen(path, "w");
+    size_t    generation = atomic_load(&parallel_trace_generation),
+              dropped    = 0;
+    uint64_t  epoch      = atomic_load(&parallel_trace_epoch);
+    bool      first      = true;
+
+    // Error check
+    if ( p_f == (void *) 0 ) goto failed_to_open_file;
+
+    // Start the document
+    fprintf(p_f, "{\"traceEvents\":[\n");
+
+    // Lock
+    pthread_mutex_lock(&parallel_trace_lock);
+
+    // Write each thread's events
+    for (parallel_trace_buffer *p_buffer = p_parallel_trace_buffers; p_buffer; p_buffer = p_buffer->p_next)
+    {
+
+        // Initialized data
+        size_t count = 0;
+
+        // Skip threads that recorded nothing in this trace
+        if ( atomic_load_explicit(&p_buffer->generation, memory_order_acquire) != generation ) continue;
+
+        // Load the quantity of events
+        count = atomic_load_explicit(&p_buffer->count, memory_order_acquire);
+
+        // Count the dropped events
+        dropped += atomic_load_explicit(&p_buffer->dropped, memory_order_relaxed);
+
+        // Name the thread's track
+        if ( p_buffer->_name[0] )
+        {
+
+            // Write the name
+            fprintf(p_f, "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%zu,\"args\":{\"name\":", first ? "" : ",\n", p_buffer->id);
+            parallel_trace_write_string(p_f, p_buffer->_name);
+            fprintf(p_f, "}}");
+
+            // Not the first event
+            first = false;
+        }
+
+        // Write each event
+        for (size_t i = 0; i < count; i++)
+        {
+
+            // Initialized data
+            const parallel_trace_record *p_event = &p_buffer->p_events[i];
+
+            // Write the name
+            fprintf(p_f, "%s{\"name\":", first ? "" : ",\n");
+            parallel_trace_write_string(p_f, p_event->name ? p_event->name : "");
+
+            // Write the phase, the time in microseconds, and the thread
+            fprintf(p_f, ",\"ph\":\"%c\",\"ts\":%.3f,\"pid\":1,\"tid\":%zu", p_event->phase, (double) ( p_event->timestamp - epoch ) / 1000.0, p_buffer->id);
+
+            // Write the arguments of a span
+            if ( p_event->phase == 'B' && ( p_event->detail || p_event->p_address ) )
+            {
+
+                // Start the arguments
+                fprintf(p_f, ",\"args\":{");
+
+                // Write the detail
+                if ( p_event->detail ) fprintf(p_f, "\"detail\":"), parallel_trace_write_string(p_f, p_event->detail);
+
+                // Write the address
+                if ( p_event->p_address ) fprintf(p_f, "%s\"address\":\"%p\"", p_event->detail ? "," : "", p_event->p_address);
+
+                // End the arguments
+                fprintf(p_f, "}");
+            }
+
+            // End the event
+            fprintf(p_f, "}");
+
+            // Not the first event
+            first = false;
+        }
+    }
+
+    // Unlock
+    pthread_mutex_unlock(&parallel_trace_lock);
+
+    // End the document
+    fprintf(p_f, "\n],\"displayTimeUnit\":\"ns\",\"otherData\":{\"dropped_events\":%zu}}\n", dropped);
+
+    // Close the file
+    fclose(p_f);
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_path:
+                #ifndef NDEBUG
+                    log_error("[parallel] [trace] Null pointer provided for parameter \"path\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+
+        // Standard library errors
+        {
+            failed_to_open_file:
+                #ifndef NDEBUG
+                    log_error("[Standard Library] Failed to open file \"%s\" in call to function \"%s\"\n", path, __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+uint64_t parallel_trace_clock ( void )
+{
+
+    // Initialized data
+    struct timespec _now = { 0 };
+
+    // Read the clock
+    clock_gettime(CLOCK_MONOTONIC, &_now);
+
+    // Done
+    return (uint64_t) _now.tv_sec * 1000000000ULL + (uint64_t) _now.tv_nsec;
+}
+
+parallel_trace_buffer *parallel_trace_buffer_get ( size_t generation )
+{
+
+    // Initialized data
+    parallel_trace_buffer *p_buffer       = p_parallel_trace_buffer;
+    size_t                 event_quantity = atomic_load(&parallel_trace_event_quantity);
+
+    // The thread's first event
+    if ( p_buffer == (void *) 0 )
+    {
+
+        // Allocate a buffer
+        p_buffer = PARALLEL_REALLOC(0, sizeof(parallel_trace_buffer));
+
+        // Error check
+        if ( p_buffer == (void *) 0 ) goto no_mem;
+
+        // Initialize data
+        memset(p_buffer, 0, sizeof(parallel_trace_buffer));
+
+        // Take the thread's name
+        memcpy(p_buffer->_name, parallel_trace_thread_name, PARALLEL_TRACE_THREAD_NAME_LENGTH);
+
+        // Lock
+        pthread_mutex_lock(&parallel_trace_lock);
+
+        // Give the thread a track
+        p_buffer->id = ++parallel_trace_buffer_quantity;
+
+        // Add the buffer to the list. Buffers live as long as the process,
+        // so a thread never loses its buffer to a reader
+        p_buffer->p_next         = p_parallel_trace_buffers;
+        p_parallel_trace_buffers = p_buffer;
+
+        // Unlock
+        pthread_mutex_unlock(&parallel_trace_lock);
+
+        // Store the buffer
+        p_parallel_trace_buffer = p_buffer;
+    }
+
+    // Lock. parallel_trace_write may be reading the events of the last trace
+    pthread_mutex_lock(&parallel_trace_lock);
+
+    // Grow the events to the size of this trace
+    if ( p_buffer->capacity < event_quantity )
+    {
+
+        // Initialized data
+        parallel_trace_record *p_events = PARALLEL_REALLOC(p_buffer->p_events, event_quantity * sizeof(parallel_trace_record));
+
+        // Error check
+        if ( p_events == (void *) 0 ) goto no_mem_unlock;
+
+        // Store the events
+        p_buffer->p_events = p_events;
+        p_buffer->capacity = event_quantity;
+    }
+
+    // Empty the buffer
+    atomic_store_explicit(&p_buffer->count, 0, memory_order_relaxed);
+    atomic_store_explicit(&p_buffer->dropped, 0, memory_order_relaxed);
+
+    // Join the trace
+    atomic_store_explicit(&p_buffer->generation, generation, memory_order_release);
+
+    // Unlock
+    pthread_mutex_unlock(&parallel_trace_lock);
+
+    // Success
+    return p_buffer;
+
+    // Error handling
+    {
+
+        // Standard library errors
+        {
+            no_mem_unlock:
+
+                // Unlock
+                pthread_mutex_unlock(&parallel_trace_lock);
+
+            no_mem:
+                #ifndef NDEBUG
+                    log_error("[Standard Library] Failed to allocate memory in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return (void *) 0;
+        }
+    }
+}
+
+void parallel_trace_write_string ( FILE *p_f, const char *string )
+{
+
+    // Open the string
+    fputc('"', p_f);
+
+    // Write each character
+    for (const char *c = string; *c; c++)
+    {
+
+        // Escape quotes and backslashes
+        if ( *c == '"' || *c == '\\' ) fputc('\\', p_f), fputc(*c, p_f);
+
+        // Escape control characters
+        else if ( (unsigned char) *c < 0x20 ) fprintf(p_f, "\\u%04x", (unsigned) (unsigned char) *c);
+
+        // Copy the rest
+        else fputc(*c, p_f);
+    }
+
+    // Close the string
+    fputc('"', p_f);
+
+    // Done
+    return;
+}